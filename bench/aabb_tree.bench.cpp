@@ -0,0 +1,105 @@
+#include <benchmark.hpp>
+#include <ferrugo/alg/aabb_tree.hpp>
+
+using namespace ferrugo;
+
+namespace
+{
+
+constexpr std::size_t item_count = 4096;
+
+auto random_boxes() -> std::vector<alg::region_2d<float>>
+{
+    const auto positions = bench::random_values<float>(2 * item_count, 0.F, 400.F, 1);
+    std::vector<alg::region_2d<float>> result(item_count);
+    for (std::size_t i = 0; i < item_count; ++i)
+    {
+        const float x = positions[2 * i + 0];
+        const float y = positions[2 * i + 1];
+        result[i] = alg::region_2d<float>{ alg::interval<float>{ x, x + 2.F }, alg::interval<float>{ y, y + 2.F } };
+    }
+    return result;
+}
+
+// One simulation tick: every item moves a little, then all overlapping pairs are collected.
+void aabb_tree_tick(const bench::state& state)
+{
+    static const auto boxes = random_boxes();
+    static const auto steps = bench::random_values<float>(2 * item_count, -0.05F, 0.05F, 2);
+
+    alg::aabb_tree_2d<float> tree{ 0.2F };
+    std::vector<std::size_t> handles;
+    for (const auto& box : boxes)
+    {
+        handles.push_back(tree.insert(box));
+    }
+
+    auto current = boxes;
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        for (std::size_t i = 0; i < item_count; ++i)
+        {
+            const auto delta = alg::vec(steps[2 * i + 0], steps[2 * i + 1]);
+            current[i] += delta;
+            tree.move(handles[i], current[i], delta);
+        }
+
+        std::size_t count = 0;
+        tree.query_pairs([&](std::size_t, std::size_t) { ++count; });
+        bench::do_not_optimize(count);
+    }
+}
+
+void brute_force_tick(const bench::state& state)
+{
+    static const auto boxes = random_boxes();
+    static const auto steps = bench::random_values<float>(2 * item_count, -0.05F, 0.05F, 2);
+
+    auto current = boxes;
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        for (std::size_t i = 0; i < item_count; ++i)
+        {
+            current[i] += alg::vec(steps[2 * i + 0], steps[2 * i + 1]);
+        }
+
+        std::size_t count = 0;
+        for (std::size_t a = 0; a < item_count; ++a)
+        {
+            for (std::size_t b = a + 1; b < item_count; ++b)
+            {
+                count += alg::intersects(current[a], current[b]);
+            }
+        }
+        bench::do_not_optimize(count);
+    }
+}
+
+void aabb_tree_insert_remove(const bench::state& state)
+{
+    static const auto boxes = random_boxes();
+
+    alg::aabb_tree_2d<float> tree{ 0.2F };
+    std::vector<std::size_t> handles(item_count);
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        for (std::size_t i = 0; i < item_count; ++i)
+        {
+            handles[i] = tree.insert(boxes[i]);
+        }
+        for (const auto handle : handles)
+        {
+            tree.remove(handle);
+        }
+    }
+}
+
+const bool registered = []()
+{
+    bench::add("aabb_tree move + pairs, 4096 boxes", item_count, &aabb_tree_tick);
+    bench::add("brute force pairs, 4096 boxes", item_count, &brute_force_tick);
+    bench::add("aabb_tree insert + remove", item_count, &aabb_tree_insert_remove);
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,110 @@
+#include <benchmark.hpp>
+#include <ferrugo/alg/point_batch.hpp>
+
+using namespace ferrugo;
+
+namespace
+{
+
+constexpr std::size_t point_count = 4096;
+
+template <class T, std::size_t D>
+auto random_points() -> std::vector<alg::vector<T, D>>
+{
+    const auto values = bench::random_values<T>(point_count * D, T(-100), T(100));
+    std::vector<alg::vector<T, D>> result(point_count);
+    for (std::size_t i = 0; i < point_count; ++i)
+    {
+        std::copy(values.begin() + i * D, values.begin() + (i + 1) * D, result[i].begin());
+    }
+    return result;
+}
+
+template <class T, std::size_t D>
+auto some_transform() -> alg::square_matrix<T, D + 1>
+{
+    if constexpr (D == 2)
+    {
+        return alg::scale(T(2), T(0.5)) * alg::rotation(T(0.3)) * alg::translation(T(4), T(-1));
+    }
+    else
+    {
+        return alg::scale(T(2), T(0.5), T(3)) * alg::translation(T(4), T(-1), T(2));
+    }
+}
+
+template <class T, std::size_t D>
+void transform_aos(const bench::state& state)
+{
+    static const auto input = random_points<T, D>();
+    static const auto m = some_transform<T, D>();
+    std::vector<alg::vector<T, D>> output(point_count);
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        for (std::size_t i = 0; i < point_count; ++i)
+        {
+            output[i] = input[i] * m;
+        }
+        bench::clobber_memory();
+    }
+    bench::do_not_optimize(output.data());
+}
+
+template <class T, std::size_t D>
+void transform_soa(const bench::state& state)
+{
+    static const auto input = alg::to_batch(random_points<T, D>());
+    static const auto m = some_transform<T, D>();
+    alg::point_batch<T, D> output{ point_count };
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        alg::transform_points(input, m, output);
+        bench::clobber_memory();
+    }
+    bench::do_not_optimize(output.x().data());
+}
+
+template <class T, std::size_t D>
+void translate_soa(const bench::state& state)
+{
+    auto batch = alg::to_batch(random_points<T, D>());
+    const auto offset = alg::vector<T, D>{};
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        batch += offset;
+        bench::clobber_memory();
+    }
+    bench::do_not_optimize(batch.x().data());
+}
+
+template <class T, std::size_t D>
+void aos_to_soa(const bench::state& state)
+{
+    static const auto input = random_points<T, D>();
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        const auto batch = alg::to_batch(input);
+        bench::do_not_optimize(batch.x().data());
+    }
+}
+
+template <class T, std::size_t D>
+void register_type()
+{
+    const auto suffix = "<" + bench::type_name<T>() + ", " + std::to_string(D) + ">";
+    bench::add("transform_points_aos" + suffix, point_count, &transform_aos<T, D>);
+    bench::add("transform_points_soa" + suffix, point_count, &transform_soa<T, D>);
+    bench::add("translate_points_soa" + suffix, point_count, &translate_soa<T, D>);
+    bench::add("to_batch" + suffix, point_count, &aos_to_soa<T, D>);
+}
+
+const bool registered = []()
+{
+    register_type<float, 2>();
+    register_type<float, 3>();
+    register_type<double, 2>();
+    register_type<double, 3>();
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ferrugo
+{
+namespace bench
+{
+
+template <class T>
+inline void do_not_optimize(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void clobber_memory()
+{
+    asm volatile("" : : : "memory");
+}
+
+struct state
+{
+    std::size_t iterations;
+};
+
+struct benchmark
+{
+    std::string name;
+    std::size_t items_per_iteration;
+    std::function<void(const state&)> body;
+};
+
+struct result
+{
+    std::string name;
+    std::size_t iterations;
+    double ns_per_op;
+    double ops_per_sec;
+};
+
+inline auto registry() -> std::vector<benchmark>&
+{
+    static std::vector<benchmark> instance;
+    return instance;
+}
+
+inline void add(std::string name, std::size_t items_per_iteration, std::function<void(const state&)> body)
+{
+    registry().push_back(benchmark{ std::move(name), items_per_iteration, std::move(body) });
+}
+
+template <class T>
+auto random_values(std::size_t count, T lo, T up, std::uint32_t seed = 42) -> std::vector<T>
+{
+    std::mt19937 engine{ seed };
+    std::uniform_real_distribution<double> dist{ double(lo), double(up) };
+    std::vector<T> result(count);
+    std::generate(std::begin(result), std::end(result), [&]() { return static_cast<T>(dist(engine)); });
+    return result;
+}
+
+template <class T>
+auto type_name() -> std::string
+{
+    if constexpr (std::is_same_v<T, float>)
+    {
+        return "float";
+    }
+    else if constexpr (std::is_same_v<T, double>)
+    {
+        return "double";
+    }
+    else if constexpr (std::is_same_v<T, int>)
+    {
+        return "int";
+    }
+    else
+    {
+        return "T";
+    }
+}
+
+inline auto measure(const benchmark& item, std::chrono::nanoseconds min_time) -> result
+{
+    using clock = std::chrono::steady_clock;
+
+    std::size_t iterations = 1;
+
+    while (true)
+    {
+        const auto start = clock::now();
+        item.body(state{ iterations });
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start);
+
+        if (elapsed >= min_time || iterations >= (std::size_t(1) << 40))
+        {
+            const double ops = double(iterations) * double(item.items_per_iteration);
+            const double ns = double(elapsed.count());
+            return result{ item.name, iterations, ns / ops, ops * 1e9 / ns };
+        }
+
+        const double scale = elapsed.count() > 0 ? 1.4 * double(min_time.count()) / double(elapsed.count()) : 100.0;
+        iterations = std::max(iterations + 1, std::size_t(double(iterations) * std::min(scale, 100.0)));
+    }
+}
+
+inline void write_json(std::ostream& os, const std::vector<result>& results)
+{
+    os << "{\n  \"benchmarks\": [";
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const auto& r = results[i];
+        os << (i != 0 ? ",\n" : "\n") << std::setprecision(6);
+        os << "    { \"name\": \"" << r.name << "\", ";
+        os << "\"iterations\": " << r.iterations << ", ";
+        os << "\"ns_per_op\": " << r.ns_per_op << ", ";
+        os << "\"ops_per_sec\": " << r.ops_per_sec << " }";
+    }
+    os << "\n  ]\n}\n";
+}
+
+inline int run(int argc, char** argv)
+{
+    std::string filter;
+    std::string json_path = "bench.json";
+    std::chrono::nanoseconds min_time = std::chrono::milliseconds(100);
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc)
+        {
+            filter = argv[++i];
+        }
+        else if (arg == "--json" && i + 1 < argc)
+        {
+            json_path = argv[++i];
+        }
+        else if (arg == "--min-time-ms" && i + 1 < argc)
+        {
+            min_time = std::chrono::milliseconds(std::stol(argv[++i]));
+        }
+        else
+        {
+            std::cerr << "usage: " << argv[0] << " [--filter <substring>] [--json <path>] [--min-time-ms <ms>]\n";
+            return 1;
+        }
+    }
+
+    std::vector<result> results;
+
+    std::cout << std::left << std::setw(56) << "benchmark" << std::right << std::setw(14) << "ns/op" << std::setw(18)
+              << "ops/s" << "\n";
+
+    for (const auto& item : registry())
+    {
+        if (!filter.empty() && item.name.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        const auto r = measure(item, min_time);
+        std::cout << std::left << std::setw(56) << r.name << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(14) << r.ns_per_op << std::setprecision(0) << std::setw(18) << r.ops_per_sec << "\n";
+        results.push_back(r);
+    }
+
+    std::cout.unsetf(std::ios::floatfield);
+
+    std::ofstream file{ json_path };
+    if (!file)
+    {
+        std::cerr << "cannot open " << json_path << "\n";
+        return 1;
+    }
+    write_json(file, results);
+    return 0;
+}
+
+}  // namespace bench
+}  // namespace ferrugo
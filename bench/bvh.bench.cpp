@@ -0,0 +1,113 @@
+#include <benchmark.hpp>
+#include <ferrugo/alg/bvh.hpp>
+
+using namespace ferrugo;
+
+namespace
+{
+
+template <class T, std::size_t D>
+auto random_regions(std::size_t count, std::uint32_t seed) -> std::vector<alg::region<T, D>>
+{
+    const auto positions = bench::random_values<T>(count * D, T(0), T(1000), seed);
+    const auto sizes = bench::random_values<T>(count * D, T(0), T(2), seed + 1);
+    std::vector<alg::region<T, D>> result(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            const T lo = positions[i * D + d];
+            result[i][d] = alg::interval<T>{ lo, lo + sizes[i * D + d] };
+        }
+    }
+    return result;
+}
+
+constexpr std::size_t build_count = 1 << 20;
+constexpr std::size_t query_count = 1 << 16;
+
+template <class T, std::size_t D>
+void bvh_build(const bench::state& state, std::size_t threads)
+{
+    static const auto items = random_regions<T, D>(build_count, 1);
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        const auto tree = alg::bvh<T, D>{ items, threads };
+        bench::do_not_optimize(tree.nodes().data());
+    }
+}
+
+template <class T, std::size_t D>
+void bvh_query_region(const bench::state& state)
+{
+    static const auto items = random_regions<T, D>(query_count, 1);
+    static const auto queries = random_regions<T, D>(1024, 2);
+    static const auto tree = alg::bvh<T, D>{ items };
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        std::size_t count = 0;
+        tree.query(queries[i % queries.size()], [&](std::size_t) { ++count; });
+        bench::do_not_optimize(count);
+    }
+}
+
+template <class T, std::size_t D>
+void linear_query_region(const bench::state& state)
+{
+    static const auto items = random_regions<T, D>(query_count, 1);
+    static const auto queries = random_regions<T, D>(1024, 2);
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        std::size_t count = 0;
+        for (const auto& item : items)
+        {
+            count += alg::intersects(item, queries[i % queries.size()]);
+        }
+        bench::do_not_optimize(count);
+    }
+}
+
+template <class T, std::size_t D>
+void bvh_query_ray(const bench::state& state)
+{
+    static const auto items = random_regions<T, D>(query_count, 1);
+    static const auto origins = bench::random_values<T>(1024 * D, T(0), T(1000), 3);
+    static const auto tree = alg::bvh<T, D>{ items };
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        alg::ray<T, D> ray{};
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            ray[0][d] = origins[(i % 1024) * D + d];
+            ray[1][d] = ray[0][d] + T(d + 1);
+        }
+        std::size_t count = 0;
+        tree.query(ray, [&](std::size_t, T) { ++count; });
+        bench::do_not_optimize(count);
+    }
+}
+
+template <class T, std::size_t D>
+void register_type()
+{
+    const auto suffix = "<" + bench::type_name<T>() + ", " + std::to_string(D) + ">";
+    const auto threads = std::max(1U, std::thread::hardware_concurrency());
+    bench::add("bvh build 1M" + suffix, build_count, [](const bench::state& state) { bvh_build<T, D>(state, 1); });
+    bench::add(
+        "bvh build 1M, " + std::to_string(threads) + " threads" + suffix,
+        build_count,
+        [=](const bench::state& state) { bvh_build<T, D>(state, threads); });
+    bench::add("bvh query region" + suffix, 1, &bvh_query_region<T, D>);
+    bench::add("linear query region" + suffix, 1, &linear_query_region<T, D>);
+    bench::add("bvh query ray" + suffix, 1, &bvh_query_ray<T, D>);
+}
+
+const bool registered = []()
+{
+    register_type<float, 2>();
+    register_type<float, 3>();
+    register_type<double, 3>();
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,65 @@
+#include <benchmark.hpp>
+#include <ferrugo/alg/clip.hpp>
+
+using namespace ferrugo;
+
+namespace
+{
+
+constexpr std::size_t triangle_count = 1 << 16;
+
+// Small triangles over twice the extent of the viewport, so that most are rejected or accepted whole.
+const auto& triangles()
+{
+    static const auto result = []()
+    {
+        const auto centers = bench::random_values<float>(2 * triangle_count, -500.F, 1500.F, 1);
+        const auto offsets = bench::random_values<float>(6 * triangle_count, -20.F, 20.F, 2);
+        std::vector<alg::triangle_2d<float>> items(triangle_count);
+        for (std::size_t i = 0; i < triangle_count; ++i)
+        {
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                items[i][j] = alg::vec(
+                    centers[2 * i + 0] + offsets[6 * i + 2 * j + 0], centers[2 * i + 1] + offsets[6 * i + 2 * j + 1]);
+            }
+        }
+        return items;
+    }();
+    return result;
+}
+
+const auto viewport = alg::rect<float>{ alg::interval<float>{ 0.F, 1000.F }, alg::interval<float>{ 0.F, 1000.F } };
+
+void clip_triangles(const bench::state& state)
+{
+    std::array<alg::vector_2d<float>, alg::clip_capacity(3)> buffer;
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        std::size_t sum = 0;
+        for (const auto& item : triangles())
+        {
+            sum += alg::clip(item, viewport, buffer);
+        }
+        bench::do_not_optimize(sum);
+    }
+}
+
+void clip_all_triangles(const bench::state& state)
+{
+    alg::clipped_polygons<float> result;
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        result.clear();
+        bench::do_not_optimize(alg::clip_all(triangles(), viewport, result));
+    }
+}
+
+const bool registered = []()
+{
+    bench::add("clip triangle to rect", triangle_count, &clip_triangles);
+    bench::add("clip_all triangles to rect", triangle_count, &clip_all_triangles);
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,50 @@
+#include <benchmark.hpp>
+#include <ferrugo/alg/convex_hull.hpp>
+#include <thread>
+
+using namespace ferrugo;
+
+namespace
+{
+
+constexpr std::size_t point_count = 1 << 20;
+
+const auto& points()
+{
+    static const auto result = []()
+    {
+        const auto values = bench::random_values<double>(2 * point_count, 0.0, 1000.0, 1);
+        std::vector<alg::vector_2d<double>> points(point_count);
+        for (std::size_t i = 0; i < point_count; ++i)
+        {
+            points[i] = alg::vec(values[2 * i + 0], values[2 * i + 1]);
+        }
+        return points;
+    }();
+    return result;
+}
+
+void convex_hull(const bench::state& state)
+{
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        bench::do_not_optimize(alg::convex_hull(points()).size());
+    }
+}
+
+void convex_hull_threads(const bench::state& state)
+{
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        bench::do_not_optimize(alg::convex_hull(points(), std::thread::hardware_concurrency()).size());
+    }
+}
+
+const bool registered = []()
+{
+    bench::add("convex_hull, 1M points", point_count, &convex_hull);
+    bench::add("convex_hull, 1M points, all threads", point_count, &convex_hull_threads);
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,39 @@
+#include <benchmark.hpp>
+#include <ferrugo/alg/delaunay.hpp>
+
+using namespace ferrugo;
+
+namespace
+{
+
+auto random_points(std::size_t count) -> std::vector<alg::vector_2d<double>>
+{
+    const auto values = bench::random_values<double>(2 * count, 0.0, 1000.0, 1);
+    std::vector<alg::vector_2d<double>> result(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        result[i] = alg::vec(values[2 * i + 0], values[2 * i + 1]);
+    }
+    return result;
+}
+
+template <std::size_t Count>
+void delaunay(const bench::state& state)
+{
+    static const auto points = random_points(Count);
+
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        const alg::delaunay_triangulation<double> mesh{ points };
+        bench::do_not_optimize(mesh.size());
+    }
+}
+
+const bool registered = []()
+{
+    bench::add("delaunay_triangulation, 64k points", 1 << 16, &delaunay<1 << 16>);
+    bench::add("delaunay_triangulation, 1M points", 1 << 20, &delaunay<1 << 20>);
+    return true;
+}();
+
+}  // namespace
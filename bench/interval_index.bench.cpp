@@ -0,0 +1,108 @@
+#include <benchmark.hpp>
+#include <ferrugo/alg/interval_index.hpp>
+
+using namespace ferrugo;
+
+namespace
+{
+
+constexpr std::size_t item_count = 1 << 20;
+constexpr std::size_t query_count = 1024;
+
+// Reservations of up to an hour, spread over about a year (in seconds).
+const auto& reservations()
+{
+    static const auto result = []()
+    {
+        const auto starts = bench::random_values<double>(item_count, 0.0, 3.2e7, 1);
+        const auto lengths = bench::random_values<double>(item_count, 60.0, 3600.0, 2);
+        std::vector<alg::interval<std::int64_t>> items(item_count);
+        for (std::size_t i = 0; i < item_count; ++i)
+        {
+            const auto lo = static_cast<std::int64_t>(starts[i]);
+            items[i] = alg::interval<std::int64_t>{ lo, lo + static_cast<std::int64_t>(lengths[i]) };
+        }
+        return items;
+    }();
+    return result;
+}
+
+const auto& times()
+{
+    static const auto result = []()
+    {
+        std::vector<std::int64_t> values;
+        for (const double value : bench::random_values<double>(query_count, 0.0, 3.2e7, 3))
+        {
+            values.push_back(static_cast<std::int64_t>(value));
+        }
+        return values;
+    }();
+    return result;
+}
+
+const auto& index()
+{
+    static const alg::interval_index<std::int64_t> result{ reservations() };
+    return result;
+}
+
+void linear_stabbing(const bench::state& state)
+{
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        for (const auto time : times())
+        {
+            std::size_t count = 0;
+            for (const auto& item : reservations())
+            {
+                count += alg::contains(item, time);
+            }
+            bench::do_not_optimize(count);
+        }
+    }
+}
+
+void interval_index_stabbing(const bench::state& state)
+{
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        for (const auto time : times())
+        {
+            std::size_t count = 0;
+            index().stabbing(time, [&](std::size_t) { ++count; });
+            bench::do_not_optimize(count);
+        }
+    }
+}
+
+void interval_index_count(const bench::state& state)
+{
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        for (const auto time : times())
+        {
+            bench::do_not_optimize(index().count(alg::interval<std::int64_t>{ time, time + 86400 }));
+        }
+    }
+}
+
+void interval_index_build(const bench::state& state)
+{
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        const alg::interval_index<std::int64_t> result{ reservations() };
+        bench::do_not_optimize(result.size());
+    }
+}
+
+const bool registered = []()
+{
+    bench::add("linear stabbing, 1M intervals", query_count, &linear_stabbing);
+    bench::add("interval_index stabbing, 1M intervals", query_count, &interval_index_stabbing);
+    bench::add("interval_index count(interval), 1M intervals", query_count, &interval_index_count);
+    bench::add("interval_index build, 1M intervals", item_count, &interval_index_build);
+    return true;
+}();
+
+}  // namespace
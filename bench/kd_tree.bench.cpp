@@ -0,0 +1,98 @@
+#include <benchmark.hpp>
+#include <ferrugo/alg/kd_tree.hpp>
+
+using namespace ferrugo;
+
+namespace
+{
+
+constexpr std::size_t point_count = 1 << 16;
+constexpr std::size_t query_count = 1024;
+
+auto random_points(std::size_t count, std::uint32_t seed) -> std::vector<alg::vector_2d<float>>
+{
+    const auto values = bench::random_values<float>(2 * count, 0.F, 1000.F, seed);
+    std::vector<alg::vector_2d<float>> result(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        result[i] = alg::vec(values[2 * i + 0], values[2 * i + 1]);
+    }
+    return result;
+}
+
+const auto& points()
+{
+    static const auto result = random_points(point_count, 1);
+    return result;
+}
+
+const auto& queries()
+{
+    static const auto result = random_points(query_count, 2);
+    return result;
+}
+
+void linear_nearest(const bench::state& state)
+{
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        for (const auto& query : queries())
+        {
+            std::size_t best = 0;
+            float best_distance = alg::distance(points()[0], query);
+            for (std::size_t i = 1; i < point_count; ++i)
+            {
+                const float d = alg::distance(points()[i], query);
+                if (d < best_distance)
+                {
+                    best = i;
+                    best_distance = d;
+                }
+            }
+            bench::do_not_optimize(best);
+        }
+    }
+}
+
+void kd_tree_nearest(const bench::state& state)
+{
+    static const alg::kd_tree_2d<float> tree{ points() };
+
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        for (const auto& query : queries())
+        {
+            bench::do_not_optimize(tree.nearest(query));
+        }
+    }
+}
+
+void kd_tree_k_nearest_all(const bench::state& state)
+{
+    static const alg::kd_tree_2d<float> tree{ points() };
+
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        bench::do_not_optimize(tree.k_nearest_all(queries(), 8, std::thread::hardware_concurrency()));
+    }
+}
+
+void kd_tree_build(const bench::state& state)
+{
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        const alg::kd_tree_2d<float> tree{ points() };
+        bench::do_not_optimize(tree.size());
+    }
+}
+
+const bool registered = []()
+{
+    bench::add("linear nearest, 64k points", query_count, &linear_nearest);
+    bench::add("kd_tree nearest, 64k points", query_count, &kd_tree_nearest);
+    bench::add("kd_tree k_nearest_all (k = 8), all threads", query_count, &kd_tree_k_nearest_all);
+    bench::add("kd_tree build, 64k points", point_count, &kd_tree_build);
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,182 @@
+#include <benchmark.hpp>
+#include <ferrugo/alg/lattice.hpp>
+
+using namespace ferrugo;
+
+namespace
+{
+
+constexpr int side = 1024;
+
+const auto region = alg::region_2d<int>{ alg::interval<int>{ 0, side }, alg::interval<int>{ 0, side } };
+
+auto image() -> const std::vector<std::uint8_t>&
+{
+    static const auto result = []()
+    {
+        const auto values = bench::random_values<float>(side * side, 0.F, 255.F, 1);
+        return std::vector<std::uint8_t>(values.begin(), values.end());
+    }();
+    return result;
+}
+
+void nested_loops(const bench::state& state)
+{
+    const auto& pixels = image();
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        std::uint64_t sum = 0;
+        for (int y = region[1][0]; y < region[1][1]; ++y)
+        {
+            for (int x = region[0][0]; x < region[0][1]; ++x)
+            {
+                sum += pixels[y * side + x];
+            }
+        }
+        bench::do_not_optimize(sum);
+    }
+}
+
+void row_major_cells(const bench::state& state)
+{
+    const auto& pixels = image();
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        std::uint64_t sum = 0;
+        for (const auto& cell : alg::cells(region))
+        {
+            sum += pixels[cell[1] * side + cell[0]];
+        }
+        bench::do_not_optimize(sum);
+    }
+}
+
+void row_major_rows(const bench::state& state)
+{
+    const auto& pixels = image();
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        std::uint64_t sum = 0;
+        for (const auto& row : alg::rows(region))
+        {
+            const std::uint8_t* line = pixels.data() + row.first[1] * side;
+            for (int x = row.first[0]; x < row.upper; ++x)
+            {
+                sum += line[x];
+            }
+        }
+        bench::do_not_optimize(sum);
+    }
+}
+
+void morton_cells(const bench::state& state)
+{
+    const auto& pixels = image();
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        std::uint64_t sum = 0;
+        for (const auto& cell : alg::cells(region, alg::morton_tag{}))
+        {
+            sum += pixels[cell[1] * side + cell[0]];
+        }
+        bench::do_not_optimize(sum);
+    }
+}
+
+constexpr std::size_t segment_count = 1024;
+
+auto segments() -> const std::vector<alg::segment_2d<int>>&
+{
+    static const auto result = []()
+    {
+        const auto values = bench::random_values<float>(4 * segment_count, 0.F, float(side), 2);
+        std::vector<alg::segment_2d<int>> items;
+        for (std::size_t i = 0; i < segment_count; ++i)
+        {
+            items.emplace_back(
+                alg::vec(int(values[4 * i + 0]), int(values[4 * i + 1])),
+                alg::vec(int(values[4 * i + 2]), int(values[4 * i + 3])));
+        }
+        return items;
+    }();
+    return result;
+}
+
+auto total_length() -> std::size_t
+{
+    std::size_t result = 0;
+    for (const auto& item : segments())
+    {
+        result += alg::raster(item).size();
+    }
+    return result;
+}
+
+void handwritten_bresenham(const bench::state& state)
+{
+    const auto& pixels = image();
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        std::uint64_t sum = 0;
+        for (const auto& item : segments())
+        {
+            int x = item[0][0];
+            int y = item[0][1];
+            const int dx = std::abs(item[1][0] - x);
+            const int dy = -std::abs(item[1][1] - y);
+            const int sx = x < item[1][0] ? 1 : -1;
+            const int sy = y < item[1][1] ? 1 : -1;
+            int error = dx + dy;
+            while (true)
+            {
+                sum += pixels[y * side + x];
+                if (x == item[1][0] && y == item[1][1])
+                {
+                    break;
+                }
+                const int twice = 2 * error;
+                if (twice >= dy)
+                {
+                    error += dy;
+                    x += sx;
+                }
+                if (twice <= dx)
+                {
+                    error += dx;
+                    y += sy;
+                }
+            }
+        }
+        bench::do_not_optimize(sum);
+    }
+}
+
+void raster(const bench::state& state)
+{
+    const auto& pixels = image();
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        std::uint64_t sum = 0;
+        for (const auto& item : segments())
+        {
+            for (const auto& cell : alg::raster(item))
+            {
+                sum += pixels[cell[1] * side + cell[0]];
+            }
+        }
+        bench::do_not_optimize(sum);
+    }
+}
+
+const bool registered = []()
+{
+    bench::add("nested loops over 1024x1024 pixels", side * side, &nested_loops);
+    bench::add("cells, row-major, 1024x1024 pixels", side * side, &row_major_cells);
+    bench::add("rows, 1024x1024 pixels", side * side, &row_major_rows);
+    bench::add("cells, Morton, 1024x1024 pixels", side * side, &morton_cells);
+    bench::add("handwritten Bresenham, 1024 segments", total_length(), &handwritten_bresenham);
+    bench::add("raster, 1024 segments", total_length(), &raster);
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,6 @@
+#include <benchmark.hpp>
+
+int main(int argc, char** argv)
+{
+    return ferrugo::bench::run(argc, argv);
+}
@@ -0,0 +1,163 @@
+#include <benchmark.hpp>
+#include <ferrugo/alg/operations.hpp>
+#include <tuple>
+
+using namespace ferrugo;
+
+namespace
+{
+
+constexpr std::size_t input_count = 1024;
+
+template <class T>
+auto angles() -> const std::vector<T>&
+{
+    static const auto result = bench::random_values<T>(input_count, T(-3.14159), T(3.14159), 1);
+    return result;
+}
+
+template <class T>
+auto coordinates(std::uint32_t seed) -> const std::vector<T>&
+{
+    static const auto result = bench::random_values<T>(input_count, T(-10), T(10), seed);
+    return result;
+}
+
+template <class T, class Policy>
+void sincos_scalar(const bench::state& state)
+{
+    const auto& x = angles<T>();
+    std::vector<T> s(input_count);
+    std::vector<T> c(input_count);
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        for (std::size_t i = 0; i < input_count; ++i)
+        {
+            std::tie(s[i], c[i]) = Policy::sincos(x[i]);
+        }
+        bench::clobber_memory();
+    }
+    bench::do_not_optimize(s.data());
+}
+
+template <class T>
+void sincos_batch(const bench::state& state)
+{
+    const auto& x = angles<T>();
+    std::vector<T> s(input_count);
+    std::vector<T> c(input_count);
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        alg::fast::sincos(x, s, c);
+        bench::clobber_memory();
+    }
+    bench::do_not_optimize(s.data());
+}
+
+template <class T, class Policy>
+void rotation(const bench::state& state)
+{
+    const auto& x = angles<T>();
+    constexpr auto rotation = alg::detail::rotation_fn<Policy>{};
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        for (std::size_t i = 0; i < input_count; ++i)
+        {
+            const auto result = rotation(x[i]);
+            bench::do_not_optimize(result);
+        }
+    }
+}
+
+template <class T, class Policy>
+void atan2_scalar(const bench::state& state)
+{
+    const auto& y = coordinates<T>(2);
+    const auto& x = coordinates<T>(3);
+    std::vector<T> out(input_count);
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        for (std::size_t i = 0; i < input_count; ++i)
+        {
+            out[i] = Policy::atan2(y[i], x[i]);
+        }
+        bench::clobber_memory();
+    }
+    bench::do_not_optimize(out.data());
+}
+
+template <class T>
+void atan2_batch(const bench::state& state)
+{
+    const auto& y = coordinates<T>(2);
+    const auto& x = coordinates<T>(3);
+    std::vector<T> out(input_count);
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        alg::fast::atan2(y, x, out);
+        bench::clobber_memory();
+    }
+    bench::do_not_optimize(out.data());
+}
+
+template <class T, class Policy>
+void length(const bench::state& state)
+{
+    const auto& x = coordinates<T>(2);
+    const auto& y = coordinates<T>(3);
+    constexpr auto length = alg::detail::length_fn<Policy>{};
+    std::vector<T> out(input_count);
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        for (std::size_t i = 0; i < input_count; ++i)
+        {
+            out[i] = length(alg::vec(x[i], y[i]));
+        }
+        bench::clobber_memory();
+    }
+    bench::do_not_optimize(out.data());
+}
+
+template <class T>
+void sqrt_batch(const bench::state& state)
+{
+    const auto& x = angles<T>();
+    std::vector<T> squares(input_count);
+    for (std::size_t i = 0; i < input_count; ++i)
+    {
+        squares[i] = x[i] * x[i];
+    }
+    std::vector<T> out(input_count);
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        alg::fast::sqrt(squares, out);
+        bench::clobber_memory();
+    }
+    bench::do_not_optimize(out.data());
+}
+
+template <class T>
+void register_type()
+{
+    const auto suffix = "<" + bench::type_name<T>() + ">";
+    bench::add("sincos precise" + suffix, input_count, &sincos_scalar<T, alg::precise_math>);
+    bench::add("sincos fast" + suffix, input_count, &sincos_scalar<T, alg::fast_math>);
+    bench::add("sincos fast batch" + suffix, input_count, &sincos_batch<T>);
+    bench::add("rotation precise" + suffix, input_count, &rotation<T, alg::precise_math>);
+    bench::add("rotation fast" + suffix, input_count, &rotation<T, alg::fast_math>);
+    bench::add("atan2 precise" + suffix, input_count, &atan2_scalar<T, alg::precise_math>);
+    bench::add("atan2 fast" + suffix, input_count, &atan2_scalar<T, alg::fast_math>);
+    bench::add("atan2 fast batch" + suffix, input_count, &atan2_batch<T>);
+    bench::add("length precise" + suffix, input_count, &length<T, alg::precise_math>);
+    bench::add("length fast" + suffix, input_count, &length<T, alg::fast_math>);
+    bench::add("sqrt fast batch" + suffix, input_count, &sqrt_batch<T>);
+}
+
+const bool registered = []()
+{
+    register_type<float>();
+    register_type<double>();
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,347 @@
+#include <benchmark.hpp>
+#include <ferrugo/alg/matrix.hpp>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+using namespace ferrugo;
+
+namespace
+{
+
+constexpr std::size_t input_count = 64;
+
+template <class T, std::size_t R, std::size_t C>
+auto random_matrices(T lo, T up) -> std::vector<alg::matrix<T, R, C>>
+{
+    const auto values = bench::random_values<T>(input_count * R * C, lo, up);
+    std::vector<alg::matrix<T, R, C>> result(input_count);
+    for (std::size_t i = 0; i < input_count; ++i)
+    {
+        std::copy(values.begin() + i * R * C, values.begin() + (i + 1) * R * C, result[i].begin());
+    }
+    return result;
+}
+
+template <class T, std::size_t N>
+auto name(const std::string& prefix) -> std::string
+{
+    return prefix + "<" + bench::type_name<T>() + ", " + std::to_string(N) + ">";
+}
+
+template <class T, std::size_t N>
+void matrix_multiply(const bench::state& state)
+{
+    static const auto input = random_matrices<T, N, N>(T(-1), T(1));
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        const auto result = input[i % input_count] * input[(i + 1) % input_count];
+        bench::do_not_optimize(result);
+    }
+}
+
+template <class T, std::size_t N>
+void vector_transform(const bench::state& state)
+{
+    static const auto points = random_matrices<T, 1, N - 1>(T(-100), T(100));
+    static const auto transforms = random_matrices<T, N, N>(T(-1), T(1));
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        const auto result = points[i % input_count] * transforms[(i / input_count) % input_count];
+        bench::do_not_optimize(result);
+    }
+}
+
+template <class T, std::size_t N>
+void matrix_determinant(const bench::state& state)
+{
+    static const auto input = random_matrices<T, N, N>(T(-1), T(1));
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        const auto result = alg::determinant(input[i % input_count]);
+        bench::do_not_optimize(result);
+    }
+}
+
+template <class T, std::size_t N>
+void matrix_invert(const bench::state& state)
+{
+    static const auto input = random_matrices<T, N, N>(T(-1), T(1));
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        const auto result = alg::invert(input[i % input_count]);
+        bench::do_not_optimize(result);
+    }
+}
+
+template <class T, std::size_t N>
+void matrix_solve(const bench::state& state)
+{
+    static const auto input = random_matrices<T, N, N>(T(-1), T(1));
+    static const auto rhs = random_matrices<T, 1, N>(T(-1), T(1));
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        const auto result = alg::solve(input[i % input_count], rhs[(i + 1) % input_count]);
+        bench::do_not_optimize(result);
+    }
+}
+
+template <class T, std::size_t N>
+void elementwise_eager(const bench::state& state)
+{
+    static const auto input = random_matrices<T, N, N>(T(-1), T(1));
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        const auto& a = input[i % input_count];
+        const auto& b = input[(i + 1) % input_count];
+        const auto& c = input[(i + 2) % input_count];
+        const alg::square_matrix<T, N> result = a + b * T(2) - c;
+        bench::do_not_optimize(result);
+    }
+}
+
+template <class T, std::size_t N>
+void elementwise_lazy(const bench::state& state)
+{
+    static const auto input = random_matrices<T, N, N>(T(-1), T(1));
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        const auto& a = input[i % input_count];
+        const auto& b = input[(i + 1) % input_count];
+        const auto& c = input[(i + 2) % input_count];
+        const alg::square_matrix<T, N> result = alg::lazy(a) + alg::lazy(b) * T(2) - c;
+        bench::do_not_optimize(result);
+    }
+}
+
+template <class T, std::size_t N>
+auto random_affine_transforms() -> std::vector<alg::square_matrix<T, N>>
+{
+    const auto values = bench::random_values<T>(input_count * 4, T(0.5), T(2));
+    std::vector<alg::square_matrix<T, N>> result;
+    for (std::size_t i = 0; i < input_count; ++i)
+    {
+        const T* v = values.data() + 4 * i;
+        if constexpr (N == 3)
+        {
+            result.push_back(alg::scale(v[0], v[1]) * alg::rotation(v[2]) * alg::translation(v[3], v[0]));
+        }
+        else
+        {
+            result.push_back(alg::scale(v[0], v[1], v[2]) * alg::translation(v[3], v[0], v[1]));
+        }
+    }
+    return result;
+}
+
+// Rotations followed by translations, the inputs invert_rigid is meant for. Throws if invert_rigid does not agree with
+// the general inverse on them, so that the timings below compare equal results.
+template <class T, std::size_t N>
+auto random_rigid_transforms() -> std::vector<alg::square_matrix<T, N>>
+{
+    const auto values = bench::random_values<T>(input_count * 5, T(-3), T(3), 7);
+    std::vector<alg::square_matrix<T, N>> result;
+    for (std::size_t i = 0; i < input_count; ++i)
+    {
+        const T* v = values.data() + 5 * i;
+        if constexpr (N == 3)
+        {
+            result.push_back(alg::rotation(v[0]) * alg::translation(v[1], v[2]));
+        }
+        else
+        {
+            // A rotation about z followed by one about x.
+            const T cz = std::cos(v[0]);
+            const T sz = std::sin(v[0]);
+            const T cx = std::cos(v[1]);
+            const T sx = std::sin(v[1]);
+            const auto about_z = alg::square_matrix<T, 4>{ cz, sz, 0, 0, -sz, cz, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+            const auto about_x = alg::square_matrix<T, 4>{ 1, 0, 0, 0, 0, cx, sx, 0, 0, -sx, cx, 0, 0, 0, 0, 1 };
+            result.push_back(about_z * about_x * alg::translation(v[2], v[3], v[4]));
+        }
+
+        const auto rigid = alg::invert_rigid(result.back());
+        const auto general = alg::invert(result.back());
+        for (std::size_t j = 0; j < rigid.size(); ++j)
+        {
+            if (!general || std::abs(rigid[j] - (*general)[j]) > T(1e-4))
+            {
+                throw std::runtime_error{ "invert_rigid: result differs from the general inverse" };
+            }
+        }
+    }
+    return result;
+}
+
+template <class T, std::size_t N>
+void matrix_invert_affine(const bench::state& state)
+{
+    static const auto input = random_affine_transforms<T, N>();
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        const auto result = alg::invert_affine(input[i % input_count]);
+        bench::do_not_optimize(result);
+    }
+}
+
+template <class T, std::size_t N>
+void matrix_invert_affine_of_rigid(const bench::state& state)
+{
+    static const auto input = random_rigid_transforms<T, N>();
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        const auto result = alg::invert_affine(input[i % input_count]);
+        bench::do_not_optimize(result);
+    }
+}
+
+template <class T, std::size_t N>
+void matrix_invert_rigid(const bench::state& state)
+{
+    static const auto input = random_rigid_transforms<T, N>();
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        const auto result = alg::invert_rigid(input[i % input_count]);
+        bench::do_not_optimize(result);
+    }
+}
+
+template <class T>
+auto random_dynamic(std::size_t rows, std::size_t cols, std::uint32_t seed) -> alg::dynamic_matrix<T>
+{
+    const auto values = bench::random_values<T>(rows * cols, T(-1), T(1), seed);
+    alg::dynamic_matrix<T> result{ rows, cols };
+    std::copy(values.begin(), values.end(), result.begin());
+    return result;
+}
+
+template <class T, std::size_t N>
+void dynamic_multiply_naive(const bench::state& state)
+{
+    static const auto lhs = random_dynamic<T>(N, N, 1);
+    static const auto rhs = random_dynamic<T>(N, N, 2);
+    alg::dynamic_matrix<T> result{ N, N };
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        std::fill(result.begin(), result.end(), T{});
+        for (std::size_t r = 0; r < N; ++r)
+        {
+            for (std::size_t k = 0; k < N; ++k)
+            {
+                const T value = lhs(r, k);
+                for (std::size_t c = 0; c < N; ++c)
+                {
+                    result(r, c) += value * rhs(k, c);
+                }
+            }
+        }
+        bench::do_not_optimize(result.data());
+        bench::clobber_memory();
+    }
+}
+
+template <class T, std::size_t N>
+void dynamic_multiply(const bench::state& state)
+{
+    static const auto lhs = random_dynamic<T>(N, N, 1);
+    static const auto rhs = random_dynamic<T>(N, N, 2);
+    alg::dynamic_matrix<T> result{ N, N };
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        alg::multiply(lhs.view(), rhs.view(), result.view());
+        bench::do_not_optimize(result.data());
+        bench::clobber_memory();
+    }
+}
+
+// Items are floating point operations, so ops/s reads as FLOP/s.
+template <class T, std::size_t N>
+void register_dynamic()
+{
+    bench::add(name<T, N>("dynamic_multiply_naive"), 2 * N * N * N, &dynamic_multiply_naive<T, N>);
+    bench::add(name<T, N>("dynamic_multiply"), 2 * N * N * N, &dynamic_multiply<T, N>);
+}
+
+template <class T, std::size_t N>
+void compose_matrix(const bench::state& state)
+{
+    static const auto input = random_affine_transforms<T, N>();
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        const auto result = input[i % input_count] * input[(i + 1) % input_count];
+        bench::do_not_optimize(result);
+    }
+}
+
+template <class T, std::size_t N>
+void compose_affine(const bench::state& state)
+{
+    static const auto matrices = random_affine_transforms<T, N>();
+    static const auto input = std::vector<alg::affine_transform<T, N - 1>>(matrices.begin(), matrices.end());
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        const auto result = input[i % input_count] * input[(i + 1) % input_count];
+        bench::do_not_optimize(result);
+    }
+}
+
+template <class T, std::size_t N>
+void transform_affine(const bench::state& state)
+{
+    static const auto points = random_matrices<T, 1, N - 1>(T(-100), T(100));
+    static const auto matrices = random_affine_transforms<T, N>();
+    static const auto transforms = std::vector<alg::affine_transform<T, N - 1>>(matrices.begin(), matrices.end());
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        const auto result = points[i % input_count] * transforms[(i / input_count) % input_count];
+        bench::do_not_optimize(result);
+    }
+}
+
+template <class T, std::size_t N>
+void register_affine()
+{
+    bench::add(name<T, N>("compose_matrix"), 1, &compose_matrix<T, N>);
+    bench::add(name<T, N>("compose_affine"), 1, &compose_affine<T, N>);
+    bench::add(name<T, N>("transform_affine"), 1, &transform_affine<T, N>);
+    bench::add(name<T, N>("invert_affine"), 1, &matrix_invert_affine<T, N>);
+    bench::add(name<T, N>("invert_affine_of_rigid"), 1, &matrix_invert_affine_of_rigid<T, N>);
+    bench::add(name<T, N>("invert_rigid"), 1, &matrix_invert_rigid<T, N>);
+}
+
+template <class T, std::size_t N>
+void register_size()
+{
+    bench::add(name<T, N>("matrix_multiply"), 1, &matrix_multiply<T, N>);
+    bench::add(name<T, N>("vector_transform"), 1, &vector_transform<T, N>);
+    bench::add(name<T, N>("determinant"), 1, &matrix_determinant<T, N>);
+    bench::add(name<T, N>("invert"), 1, &matrix_invert<T, N>);
+    bench::add(name<T, N>("solve"), 1, &matrix_solve<T, N>);
+    bench::add(name<T, N>("elementwise_eager"), 1, &elementwise_eager<T, N>);
+    bench::add(name<T, N>("elementwise_lazy"), 1, &elementwise_lazy<T, N>);
+}
+
+template <class T, std::size_t... N>
+void register_sizes(std::index_sequence<N...>)
+{
+    (register_size<T, N + 2>(), ...);
+}
+
+const bool registered = []()
+{
+    register_sizes<float>(std::make_index_sequence<7>{});
+    register_sizes<double>(std::make_index_sequence<7>{});
+    register_affine<float, 3>();
+    register_affine<float, 4>();
+    register_affine<double, 3>();
+    register_affine<double, 4>();
+    register_dynamic<float, 64>();
+    register_dynamic<float, 256>();
+    register_dynamic<float, 512>();
+    register_dynamic<double, 64>();
+    register_dynamic<double, 256>();
+    register_dynamic<double, 512>();
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,210 @@
+#include <benchmark.hpp>
+#include <ferrugo/alg/operations.hpp>
+
+using namespace ferrugo;
+
+namespace
+{
+
+constexpr std::size_t input_count = 1024;
+
+template <class T>
+auto random_points(T lo, T up, std::uint32_t seed) -> std::vector<alg::vector_2d<T>>
+{
+    const auto values = bench::random_values<T>(2 * input_count, lo, up, seed);
+    std::vector<alg::vector_2d<T>> result(input_count);
+    for (std::size_t i = 0; i < input_count; ++i)
+    {
+        result[i] = alg::vec(values[2 * i + 0], values[2 * i + 1]);
+    }
+    return result;
+}
+
+template <class T>
+auto random_segments(T lo, T up, std::uint32_t seed) -> std::vector<alg::segment_2d<T>>
+{
+    const auto a = random_points<T>(lo, up, seed);
+    const auto b = random_points<T>(lo, up, seed + 1);
+    std::vector<alg::segment_2d<T>> result;
+    for (std::size_t i = 0; i < input_count; ++i)
+    {
+        result.push_back(alg::segment_2d<T>{ a[i], b[i] });
+    }
+    return result;
+}
+
+template <class T>
+void contains_triangle_point(const bench::state& state)
+{
+    static const auto points = random_points<T>(T(-10), T(10), 1);
+    static const auto triangle = alg::triangle_2d<T>{ alg::vec(T(-5), T(-5)), alg::vec(T(5), T(-4)), alg::vec(T(0), T(6)) };
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        const bool result = alg::contains(triangle, points[i % input_count]);
+        bench::do_not_optimize(result);
+    }
+}
+
+template <class T>
+void contains_triangle_points(const bench::state& state)
+{
+    static const auto points = random_points<T>(T(-10), T(10), 1);
+    static const auto triangle = alg::triangle_2d<T>{ alg::vec(T(-5), T(-5)), alg::vec(T(5), T(-4)), alg::vec(T(0), T(6)) };
+    std::vector<std::uint64_t> mask(alg::bitmask_words(input_count));
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        const auto result = alg::contains(triangle, points, mask);
+        bench::do_not_optimize(result);
+    }
+}
+
+template <class T>
+void contains_triangles_points(const bench::state& state)
+{
+    static const auto points = random_points<T>(T(-10), T(10), 1);
+    static const auto corners = random_points<T>(T(-10), T(10), 3);
+    static const auto triangles = [&]()
+    {
+        std::vector<alg::triangle_2d<T>> result;
+        for (std::size_t i = 0; i + 2 < 3 * 16; i += 3)
+        {
+            result.push_back(alg::triangle_2d<T>{ corners[i], corners[i + 1], corners[i + 2] });
+        }
+        return result;
+    }();
+    std::vector<std::uint64_t> mask(alg::bitmask_words(input_count) * triangles.size());
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        const auto result = alg::contains(alg::span{ triangles }, points, mask);
+        bench::do_not_optimize(result);
+    }
+}
+
+template <class T>
+void intersection_segment_segment(const bench::state& state)
+{
+    static const auto segments = random_segments<T>(T(-10), T(10), 2);
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        const auto result = alg::intersection(segments[i % input_count], segments[(i + 1) % input_count]);
+        bench::do_not_optimize(result);
+    }
+}
+
+// Short segments scattered over a large area, like road segments queried during map matching.
+template <class T>
+auto scattered_segments() -> std::vector<alg::segment_2d<T>>
+{
+    const auto starts = random_points<T>(T(-100), T(100), 6);
+    const auto offsets = random_points<T>(T(-2), T(2), 7);
+    std::vector<alg::segment_2d<T>> result;
+    for (std::size_t i = 0; i < input_count; ++i)
+    {
+        result.push_back(alg::segment_2d<T>{ starts[i], starts[i] + offsets[i] });
+    }
+    return result;
+}
+
+template <class T>
+void intersection_segment_segments(const bench::state& state)
+{
+    static const auto segments = scattered_segments<T>();
+    static const auto query = alg::segment_2d<T>{ alg::vec(T(-60), T(-20)), alg::vec(T(50), T(30)) };
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        std::size_t count = 0;
+        for (const auto& item : segments)
+        {
+            count += alg::intersection(query, item).has_value();
+        }
+        bench::do_not_optimize(count);
+    }
+}
+
+template <class T>
+void intersect_all_segment_segments(const bench::state& state)
+{
+    static const auto segments = scattered_segments<T>();
+    static const auto query = alg::segment_2d<T>{ alg::vec(T(-60), T(-20)), alg::vec(T(50), T(30)) };
+    alg::intersection_hits<T> hits;
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        hits.indices.clear();
+        hits.points.clear();
+        const auto count = alg::intersect_all(query, segments, hits);
+        bench::do_not_optimize(count);
+    }
+}
+
+template <class T>
+auto star_polygon(std::size_t vertices) -> alg::polygon<T>
+{
+    const auto radii = bench::random_values<T>(vertices, T(5), T(10), 8);
+    alg::polygon<T> result;
+    for (std::size_t i = 0; i < vertices; ++i)
+    {
+        const T angle = T(6.2831853) * static_cast<T>(i) / static_cast<T>(vertices);
+        result.push_back(alg::vec(radii[i] * std::cos(angle), radii[i] * std::sin(angle)));
+    }
+    return result;
+}
+
+template <class T>
+void contains_polygon_point(const bench::state& state)
+{
+    static const auto points = random_points<T>(T(-10), T(10), 9);
+    static const auto polygon = star_polygon<T>(input_count);
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        const bool result = alg::contains(polygon, points[i % input_count]);
+        bench::do_not_optimize(result);
+    }
+}
+
+template <class T>
+void contains_prepared_polygon_point(const bench::state& state)
+{
+    static const auto points = random_points<T>(T(-10), T(10), 9);
+    static const auto polygon = alg::prepared_polygon<T>{ star_polygon<T>(input_count) };
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        const bool result = alg::contains(polygon, points[i % input_count]);
+        bench::do_not_optimize(result);
+    }
+}
+
+template <class T>
+void projection_point_segment(const bench::state& state)
+{
+    static const auto points = random_points<T>(T(-10), T(10), 4);
+    static const auto segments = random_segments<T>(T(-10), T(10), 5);
+    for (std::size_t i = 0; i < state.iterations; ++i)
+    {
+        const auto result = alg::projection(points[i % input_count], segments[(i + 7) % input_count], T(1e-6));
+        bench::do_not_optimize(result);
+    }
+}
+
+template <class T>
+void register_type()
+{
+    const auto suffix = "<" + bench::type_name<T>() + ">";
+    bench::add("contains(triangle, point)" + suffix, 1, &contains_triangle_point<T>);
+    bench::add("contains(triangle, points)" + suffix, input_count, &contains_triangle_points<T>);
+    bench::add("contains(triangles, points)" + suffix, 16 * input_count, &contains_triangles_points<T>);
+    bench::add("intersection(segment, segment)" + suffix, 1, &intersection_segment_segment<T>);
+    bench::add("intersection(segment, segments)" + suffix, input_count, &intersection_segment_segments<T>);
+    bench::add("intersect_all(segment, segments)" + suffix, input_count, &intersect_all_segment_segments<T>);
+    bench::add("contains(polygon, point)" + suffix, 1, &contains_polygon_point<T>);
+    bench::add("contains(prepared_polygon, point)" + suffix, 1, &contains_prepared_polygon_point<T>);
+    bench::add("projection(point, segment)" + suffix, 1, &projection_point_segment<T>);
+}
+
+const bool registered = []()
+{
+    register_type<float>();
+    register_type<double>();
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,89 @@
+#include <benchmark.hpp>
+#include <ferrugo/alg/operations.hpp>
+#include <ferrugo/alg/predicates.hpp>
+
+using namespace ferrugo;
+
+namespace
+{
+
+constexpr std::size_t point_count = 4096;
+
+auto random_points(double lo, double up, std::uint32_t seed) -> std::vector<alg::vector_2d<double>>
+{
+    const auto values = bench::random_values<double>(2 * point_count, lo, up, seed);
+    std::vector<alg::vector_2d<double>> result(point_count);
+    for (std::size_t i = 0; i < point_count; ++i)
+    {
+        result[i] = alg::vec(values[2 * i + 0], values[2 * i + 1]);
+    }
+    return result;
+}
+
+// Points near the line y = x, where most signs need the exact evaluation.
+auto collinear_points() -> std::vector<alg::vector_2d<double>>
+{
+    const auto values = bench::random_values<double>(point_count, 0.0, 100.0, 3);
+    const auto offsets = bench::random_values<double>(point_count, -4.0, 4.0, 4);
+    std::vector<alg::vector_2d<double>> result(point_count);
+    for (std::size_t i = 0; i < point_count; ++i)
+    {
+        result[i] = alg::vec(values[i], values[i] + std::ldexp(std::round(offsets[i]), -50));
+    }
+    return result;
+}
+
+template <class Func>
+void run(const bench::state& state, const std::vector<alg::vector_2d<double>>& points, Func&& func)
+{
+    const auto a = alg::vec(-1.0, -1.0);
+    const auto b = alg::vec(200.0, 200.0);
+
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        int sum = 0;
+        for (const auto& point : points)
+        {
+            sum += alg::sign(func(a, b, point));
+        }
+        bench::do_not_optimize(sum);
+    }
+}
+
+const auto cross = [](const auto& a, const auto& b, const auto& c) { return alg::cross(b - a, c - a); };
+
+void cross_random(const bench::state& state)
+{
+    static const auto points = random_points(0.0, 100.0, 1);
+    run(state, points, cross);
+}
+
+void orient2d_random(const bench::state& state)
+{
+    static const auto points = random_points(0.0, 100.0, 1);
+    run(state, points, alg::predicates::orient2d);
+}
+
+void orient2d_collinear(const bench::state& state)
+{
+    static const auto points = collinear_points();
+    run(state, points, alg::predicates::orient2d);
+}
+
+void incircle_random(const bench::state& state)
+{
+    static const auto points = random_points(0.0, 100.0, 1);
+    const auto c = alg::vec(-1.0, 150.0);
+    run(state, points, [&](const auto& a, const auto& b, const auto& d) { return alg::predicates::incircle(a, b, c, d); });
+}
+
+const bool registered = []()
+{
+    bench::add("cross product sign, random points", point_count, &cross_random);
+    bench::add("orient2d, random points", point_count, &orient2d_random);
+    bench::add("orient2d, nearly collinear points", point_count, &orient2d_collinear);
+    bench::add("incircle, random points", point_count, &incircle_random);
+    return true;
+}();
+
+}  // namespace
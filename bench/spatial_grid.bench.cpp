@@ -0,0 +1,84 @@
+#include <benchmark.hpp>
+#include <ferrugo/alg/spatial_grid.hpp>
+
+using namespace ferrugo;
+
+namespace
+{
+
+// Particles of radius 0.1 to 0.5 at about one per unit square, the cell size is the largest diameter.
+auto random_particles(std::size_t count) -> std::vector<alg::circle<float>>
+{
+    const float extent = std::sqrt(static_cast<float>(count));
+    const auto positions = bench::random_values<float>(2 * count, 0.F, extent, 1);
+    const auto radii = bench::random_values<float>(count, 0.1F, 0.5F, 2);
+
+    std::vector<alg::circle<float>> result(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        result[i] = alg::circle<float>{ alg::vec(positions[2 * i + 0], positions[2 * i + 1]), radii[i] };
+    }
+    return result;
+}
+
+// One simulation frame: rebuild the grid, then visit every overlapping pair. The grid outlives the measurements, as
+// it would outlive the frames of a simulation, so that rebuilds reuse its allocations. At 1M particles a frame takes
+// over 100 ms on one core, short of the tens of milliseconds aimed for; most of it is the pair pass, which computes
+// the cells around each particle.
+template <std::size_t Count>
+void spatial_grid_frame(const bench::state& state)
+{
+    static const auto particles = random_particles(Count);
+
+    static alg::spatial_grid_2d<float> grid{ 1.F };
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        grid.build(particles);
+
+        std::size_t count = 0;
+        grid.query_pairs(0.F, [&](std::size_t, std::size_t) { ++count; });
+        bench::do_not_optimize(count);
+    }
+}
+
+void spatial_grid_build(const bench::state& state)
+{
+    static const auto particles = random_particles(1 << 20);
+
+    static alg::spatial_grid_2d<float> grid{ 1.F };
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        grid.build(particles);
+        bench::clobber_memory();
+    }
+}
+
+void brute_force_frame(const bench::state& state)
+{
+    static const auto particles = random_particles(4096);
+
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        std::size_t count = 0;
+        for (std::size_t a = 0; a < particles.size(); ++a)
+        {
+            for (std::size_t b = a + 1; b < particles.size(); ++b)
+            {
+                count += alg::norm(particles[a].center - particles[b].center)
+                         <= alg::sqr(particles[a].radius + particles[b].radius);
+            }
+        }
+        bench::do_not_optimize(count);
+    }
+}
+
+const bool registered = []()
+{
+    bench::add("spatial_grid build + pairs, 4096 circles", 4096, &spatial_grid_frame<4096>);
+    bench::add("brute force pairs, 4096 circles", 4096, &brute_force_frame);
+    bench::add("spatial_grid build + pairs, 1M circles", 1 << 20, &spatial_grid_frame<1 << 20>);
+    bench::add("spatial_grid build, 1M circles", 1 << 20, &spatial_grid_build);
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,70 @@
+#include <benchmark.hpp>
+#include <ferrugo/alg/sweep_and_prune.hpp>
+
+using namespace ferrugo;
+
+namespace
+{
+
+// The scene of the aabb_tree benchmark, for comparison.
+constexpr std::size_t item_count = 4096;
+
+auto random_boxes() -> std::vector<alg::region_2d<float>>
+{
+    const auto positions = bench::random_values<float>(2 * item_count, 0.F, 400.F, 1);
+    std::vector<alg::region_2d<float>> result(item_count);
+    for (std::size_t i = 0; i < item_count; ++i)
+    {
+        const float x = positions[2 * i + 0];
+        const float y = positions[2 * i + 1];
+        result[i] = alg::region_2d<float>{ alg::interval<float>{ x, x + 2.F }, alg::interval<float>{ y, y + 2.F } };
+    }
+    return result;
+}
+
+// One simulation tick: every item moves a little, then all overlapping pairs are collected.
+void sweep_and_prune_tick(const bench::state& state)
+{
+    static const auto boxes = random_boxes();
+    static const auto steps = bench::random_values<float>(2 * item_count, -0.05F, 0.05F, 2);
+
+    alg::sweep_and_prune_2d<float> engine{};
+    auto current = boxes;
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        for (std::size_t i = 0; i < item_count; ++i)
+        {
+            current[i] += alg::vec(steps[2 * i + 0], steps[2 * i + 1]);
+        }
+
+        std::size_t count = 0;
+        engine.update(current, [&](std::size_t, std::size_t) { ++count; });
+        bench::do_not_optimize(count);
+    }
+}
+
+// The items change places every tick, so the previous order is of no use and every update sorts from scratch.
+void sweep_and_prune_incoherent(const bench::state& state)
+{
+    static const auto boxes = random_boxes();
+
+    alg::sweep_and_prune_2d<float> engine{};
+    auto current = boxes;
+    for (std::size_t n = 0; n < state.iterations; ++n)
+    {
+        std::rotate(current.begin(), current.begin() + 1, current.end());
+
+        std::size_t count = 0;
+        engine.update(current, [&](std::size_t, std::size_t) { ++count; });
+        bench::do_not_optimize(count);
+    }
+}
+
+const bool registered = []()
+{
+    bench::add("sweep_and_prune update, 4096 boxes", item_count, &sweep_and_prune_tick);
+    bench::add("sweep_and_prune update, incoherent", item_count, &sweep_and_prune_incoherent);
+    return true;
+}();
+
+}  // namespace
@@ -0,0 +1,444 @@
+#pragma once
+
+#include <ferrugo/alg/operations.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace ferrugo
+{
+namespace alg
+{
+
+// Dynamic bounding volume tree over regions that are inserted, moved and removed one at a time.
+// Each leaf keeps the region it was given and a copy fattened by `margin` on every side; the tree is built over the fat
+// regions, so a move that stays inside the fat region only updates the leaf. Inner nodes are kept balanced with
+// rotations. All nodes live in one pooled array with a free list, and the handle of an item is the index of its leaf,
+// which stays valid until the item is removed. Queries test the regions as given, not the fat ones.
+template <class T, std::size_t D>
+class aabb_tree
+{
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    explicit aabb_tree(T margin = T{}) : m_margin(margin), m_root(npos), m_free(npos), m_size(0)
+    {
+    }
+
+    auto size() const -> std::size_t
+    {
+        return m_size;
+    }
+
+    auto empty() const -> bool
+    {
+        return m_size == 0;
+    }
+
+    // Number of levels below the root; 0 for a tree with at most one item.
+    auto height() const -> std::size_t
+    {
+        return m_root == npos ? 0 : static_cast<std::size_t>(m_nodes[m_root].height);
+    }
+
+    auto bounds(std::size_t handle) const -> const region<T, D>&
+    {
+        return m_nodes[checked(handle)].item;
+    }
+
+    auto fat_bounds(std::size_t handle) const -> const region<T, D>&
+    {
+        return m_nodes[checked(handle)].bounds;
+    }
+
+    auto insert(const region<T, D>& item) -> std::size_t
+    {
+        const std::size_t leaf = allocate();
+        m_nodes[leaf].item = item;
+        m_nodes[leaf].bounds = fatten(item, vector<T, D>{});
+        m_nodes[leaf].height = 0;
+        insert_leaf(leaf);
+        ++m_size;
+        return leaf;
+    }
+
+    void remove(std::size_t handle)
+    {
+        remove_leaf(checked(handle));
+        release(handle);
+        --m_size;
+    }
+
+    // Updates the region of an item. If it leaves the fat region, the leaf is reinserted with a new fat region that
+    // is also extended by `displacement`, the expected motion until the next update; returns whether that happened.
+    auto move(std::size_t handle, const region<T, D>& item, const vector<T, D>& displacement = vector<T, D>{}) -> bool
+    {
+        node& leaf = m_nodes[checked(handle)];
+        leaf.item = item;
+
+        if (contains(leaf.bounds, item))
+        {
+            return false;
+        }
+
+        remove_leaf(handle);
+        m_nodes[handle].bounds = fatten(item, displacement);
+        insert_leaf(handle);
+        return true;
+    }
+
+    // Calls func(handle) for each item that intersects `range`.
+    template <class Func>
+    void query(const region<T, D>& range, Func&& func) const
+    {
+        std::vector<std::size_t> stack;
+        traverse(range, func, stack);
+    }
+
+    auto query(const region<T, D>& range) const -> std::vector<std::size_t>
+    {
+        std::vector<std::size_t> result;
+        query(range, [&](std::size_t handle) { result.push_back(handle); });
+        return result;
+    }
+
+    // Calls func(a, b) with a < b once for each pair of intersecting items.
+    template <class Func>
+    void query_pairs(Func&& func) const
+    {
+        std::vector<std::size_t> stack;
+
+        for (std::size_t a = 0; a < m_nodes.size(); ++a)
+        {
+            if (m_nodes[a].height != 0)
+            {
+                continue;
+            }
+
+            traverse(
+                m_nodes[a].item,
+                [&](std::size_t b)
+                {
+                    if (a < b)
+                    {
+                        func(a, b);
+                    }
+                },
+                stack);
+        }
+    }
+
+    auto query_pairs() const -> std::vector<std::pair<std::size_t, std::size_t>>
+    {
+        std::vector<std::pair<std::size_t, std::size_t>> result;
+        query_pairs([&](std::size_t a, std::size_t b) { result.emplace_back(a, b); });
+        return result;
+    }
+
+private:
+    struct node
+    {
+        region<T, D> bounds;  // fat region of a leaf, union of the children of an inner node
+        region<T, D> item;    // leaf only
+        std::size_t parent;   // next free node while in the free list
+        std::size_t children[2];
+        int height;  // 0 for leaves, -1 for free nodes
+    };
+
+    using real_type = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+
+    auto checked(std::size_t handle) const -> std::size_t
+    {
+        if (handle >= m_nodes.size() || m_nodes[handle].height != 0)
+        {
+            throw std::runtime_error{ "aabb_tree: invalid handle" };
+        }
+        return handle;
+    }
+
+    auto fatten(const region<T, D>& item, const vector<T, D>& displacement) const -> region<T, D>
+    {
+        region<T, D> result{};
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            const T lo = lower(item[d]) - m_margin;
+            const T up = upper(item[d]) + m_margin;
+            result[d] = displacement[d] < T{} ? interval<T>{ lo + displacement[d], up }  //
+                                              : interval<T>{ lo, up + displacement[d] };
+        }
+        return result;
+    }
+
+    static auto merge(const region<T, D>& lhs, const region<T, D>& rhs) -> region<T, D>
+    {
+        region<T, D> result{};
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            result[d] = interval<T>{ std::min(lower(lhs[d]), lower(rhs[d])), std::max(upper(lhs[d]), upper(rhs[d])) };
+        }
+        return result;
+    }
+
+    // Half of the surface area (the perimeter in 2d), the cost of a node in the insertion heuristic.
+    static auto half_area(const region<T, D>& item) -> real_type
+    {
+        real_type result{};
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            real_type product = real_type(1);
+            for (std::size_t e = 0; e < D; ++e)
+            {
+                if (e != d)
+                {
+                    product *= real_type(upper(item[e])) - real_type(lower(item[e]));
+                }
+            }
+            result += product;
+        }
+        return result;
+    }
+
+    auto allocate() -> std::size_t
+    {
+        std::size_t index = m_free;
+
+        if (index == npos)
+        {
+            index = m_nodes.size();
+            m_nodes.emplace_back();
+        }
+        else
+        {
+            m_free = m_nodes[index].parent;
+        }
+
+        node& result = m_nodes[index];
+        result.parent = npos;
+        result.children[0] = npos;
+        result.children[1] = npos;
+        result.height = 0;
+        return index;
+    }
+
+    void release(std::size_t index)
+    {
+        m_nodes[index].parent = m_free;
+        m_nodes[index].height = -1;
+        m_free = index;
+    }
+
+    void update(std::size_t index)
+    {
+        node& current = m_nodes[index];
+        const node& left = m_nodes[current.children[0]];
+        const node& right = m_nodes[current.children[1]];
+        current.bounds = merge(left.bounds, right.bounds);
+        current.height = 1 + std::max(left.height, right.height);
+    }
+
+    void replace_child(std::size_t parent, std::size_t old_child, std::size_t new_child)
+    {
+        if (parent == npos)
+        {
+            m_root = new_child;
+            return;
+        }
+
+        auto& children = m_nodes[parent].children;
+        children[children[0] == old_child ? 0 : 1] = new_child;
+    }
+
+    // Picks the sibling that minimizes the total area of the inner nodes, descending while that can still pay off.
+    auto find_sibling(const region<T, D>& bounds) const -> std::size_t
+    {
+        std::size_t index = m_root;
+
+        while (m_nodes[index].height != 0)
+        {
+            const node& current = m_nodes[index];
+            const real_type combined = half_area(merge(current.bounds, bounds));
+
+            // Cost of making the new leaf a sibling of this node, and the cost every deeper choice pays on top of its
+            // own for enlarging this node.
+            const real_type cost = 2 * combined;
+            const real_type inheritance = 2 * (combined - half_area(current.bounds));
+
+            real_type child_costs[2];
+            for (std::size_t c = 0; c < 2; ++c)
+            {
+                const node& child = m_nodes[current.children[c]];
+                const real_type area = half_area(merge(child.bounds, bounds));
+                child_costs[c] = inheritance + (child.height == 0 ? area : area - half_area(child.bounds));
+            }
+
+            if (cost < child_costs[0] && cost < child_costs[1])
+            {
+                break;
+            }
+
+            index = current.children[child_costs[0] < child_costs[1] ? 0 : 1];
+        }
+
+        return index;
+    }
+
+    void insert_leaf(std::size_t leaf)
+    {
+        if (m_root == npos)
+        {
+            m_root = leaf;
+            m_nodes[leaf].parent = npos;
+            return;
+        }
+
+        const std::size_t sibling = find_sibling(m_nodes[leaf].bounds);
+        const std::size_t old_parent = m_nodes[sibling].parent;
+        const std::size_t new_parent = allocate();
+
+        m_nodes[new_parent].parent = old_parent;
+        m_nodes[new_parent].children[0] = sibling;
+        m_nodes[new_parent].children[1] = leaf;
+        m_nodes[sibling].parent = new_parent;
+        m_nodes[leaf].parent = new_parent;
+        replace_child(old_parent, sibling, new_parent);
+
+        refit(new_parent);
+    }
+
+    void remove_leaf(std::size_t leaf)
+    {
+        if (leaf == m_root)
+        {
+            m_root = npos;
+            return;
+        }
+
+        const std::size_t parent = m_nodes[leaf].parent;
+        const std::size_t grandparent = m_nodes[parent].parent;
+        const std::size_t sibling = m_nodes[parent].children[m_nodes[parent].children[0] == leaf ? 1 : 0];
+
+        replace_child(grandparent, parent, sibling);
+        m_nodes[sibling].parent = grandparent;
+        release(parent);
+
+        if (grandparent != npos)
+        {
+            refit(grandparent);
+        }
+    }
+
+    // Rebalances and updates the ancestors of a changed subtree, starting at `index`.
+    void refit(std::size_t index)
+    {
+        while (index != npos)
+        {
+            index = balance(index);
+            update(index);
+            index = m_nodes[index].parent;
+        }
+    }
+
+    // If the children of `a` differ in height by more than one, rotates the taller child up and returns it, the new
+    // root of the subtree; otherwise returns `a`.
+    auto balance(std::size_t a) -> std::size_t
+    {
+        if (m_nodes[a].height < 2)
+        {
+            return a;
+        }
+
+        const int difference = m_nodes[m_nodes[a].children[1]].height - m_nodes[m_nodes[a].children[0]].height;
+
+        if (difference > 1)
+        {
+            return rotate_up(a, 1);
+        }
+        if (difference < -1)
+        {
+            return rotate_up(a, 0);
+        }
+        return a;
+    }
+
+    // Makes child `side` of `a` (called b) the parent of `a`. The taller child of b stays with b, the shorter one
+    // takes b's former place under `a`.
+    auto rotate_up(std::size_t a, std::size_t side) -> std::size_t
+    {
+        const std::size_t b = m_nodes[a].children[side];
+        const std::size_t first = m_nodes[b].children[0];
+        const std::size_t second = m_nodes[b].children[1];
+        const bool first_taller = m_nodes[first].height > m_nodes[second].height;
+        const std::size_t kept = first_taller ? first : second;
+        const std::size_t moved = first_taller ? second : first;
+
+        const std::size_t parent = m_nodes[a].parent;
+        replace_child(parent, a, b);
+        m_nodes[b].parent = parent;
+
+        m_nodes[b].children[0] = a;
+        m_nodes[b].children[1] = kept;
+        m_nodes[a].parent = b;
+
+        m_nodes[a].children[side] = moved;
+        m_nodes[moved].parent = a;
+
+        update(a);
+        update(b);
+        return b;
+    }
+
+    template <class Func>
+    void traverse(const region<T, D>& range, Func&& func, std::vector<std::size_t>& stack) const
+    {
+        if (m_root == npos)
+        {
+            return;
+        }
+
+        stack.clear();
+        stack.push_back(m_root);
+
+        while (!stack.empty())
+        {
+            const std::size_t index = stack.back();
+            stack.pop_back();
+
+            const node& current = m_nodes[index];
+
+            if (!intersects(current.bounds, range))
+            {
+                continue;
+            }
+
+            if (current.height == 0)
+            {
+                if (intersects(current.item, range))
+                {
+                    func(index);
+                }
+            }
+            else
+            {
+                stack.push_back(current.children[1]);
+                stack.push_back(current.children[0]);
+            }
+        }
+    }
+
+    T m_margin;
+    std::size_t m_root;
+    std::size_t m_free;
+    std::size_t m_size;
+    std::vector<node> m_nodes;
+};
+
+template <class T>
+using aabb_tree_2d = aabb_tree<T, 2>;
+
+template <class T>
+using aabb_tree_3d = aabb_tree<T, 3>;
+
+}  // namespace alg
+}  // namespace ferrugo
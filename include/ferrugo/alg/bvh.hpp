@@ -0,0 +1,588 @@
+#pragma once
+
+#include <ferrugo/alg/operations.hpp>
+#include <ferrugo/alg/span.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace ferrugo
+{
+namespace alg
+{
+
+// Static bounding volume hierarchy over a set of regions, built once with a binned surface area heuristic.
+// The nodes are stored depth-first in one array, with the two children of an inner node next to each other, and the
+// regions are copied into leaf order so that a traversal reads contiguous memory. Queries report the positions of the
+// regions in the span the hierarchy was built from.
+template <class T, std::size_t D>
+class bvh
+{
+public:
+    using real_type = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+
+    struct node
+    {
+        region<T, D> bounds;
+        std::uint32_t first;  // leaf: first item; inner node: left child, the right child is first + 1
+        std::uint32_t count;  // number of items of a leaf, 0 for inner nodes
+    };
+
+    static constexpr std::size_t max_leaf_size = 4;
+
+    bvh() = default;
+
+    // With threads > 1, the top levels are split on the calling thread and the subtrees below them are built in
+    // parallel. The tree is the same as with a single thread; only the order of the nodes in the array differs.
+    explicit bvh(span<const region<T, D>> items, std::size_t threads = 1)
+    {
+        if (items.size() >= std::numeric_limits<std::uint32_t>::max())
+        {
+            throw std::runtime_error{ "bvh: too many items" };
+        }
+
+        if (items.empty())
+        {
+            return;
+        }
+
+        std::vector<build_item> work(items.size());
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            work[i].bounds = items[i];
+            work[i].index = static_cast<std::uint32_t>(i);
+            for (std::size_t d = 0; d < D; ++d)
+            {
+                work[i].centroid[d] = (real_type(lower(items[i][d])) + real_type(upper(items[i][d]))) / 2;
+            }
+        }
+
+        m_nodes.reserve(2 * (items.size() / max_leaf_size) + 1);
+        m_nodes.emplace_back();
+
+        const auto root = make_range(work.data(), 0, work.size(), 0);
+
+        if (threads > 1 && items.size() >= 2 * parallel_threshold)
+        {
+            build_parallel(work.data(), root, threads);
+        }
+        else
+        {
+            build(m_nodes, 0, work.data(), root);
+        }
+
+        m_items.reserve(work.size());
+        m_indices.reserve(work.size());
+        for (const auto& item : work)
+        {
+            m_items.push_back(item.bounds);
+            m_indices.push_back(item.index);
+        }
+    }
+
+    auto size() const -> std::size_t
+    {
+        return m_items.size();
+    }
+
+    auto empty() const -> bool
+    {
+        return m_items.empty();
+    }
+
+    auto nodes() const -> span<const node>
+    {
+        return span<const node>{ m_nodes.data(), m_nodes.size() };
+    }
+
+    // Calls func(index) for each item that intersects `range`.
+    template <class Func>
+    void query(const region<T, D>& range, Func&& func) const
+    {
+        traverse(
+            [&](const region<T, D>& bounds) { return intersects(bounds, range); },
+            [&](std::size_t i)
+            {
+                if (intersects(m_items[i], range))
+                {
+                    func(std::size_t{ m_indices[i] });
+                }
+            });
+    }
+
+    // Calls func(index) for each item that contains `point`.
+    template <class Func>
+    void query(const vector<T, D>& point, Func&& func) const
+    {
+        traverse(
+            [&](const region<T, D>& bounds) { return contains(bounds, point); },
+            [&](std::size_t i)
+            {
+                if (contains(m_items[i], point))
+                {
+                    func(std::size_t{ m_indices[i] });
+                }
+            });
+    }
+
+    // Calls func(index, t) for each item hit by `item`, where item[0] + t * (item[1] - item[0]) is the entry point
+    // (t = 0 if the ray starts inside). Items are reported in traversal order, not by distance.
+    template <class Func>
+    void query(const ray<T, D>& item, Func&& func) const
+    {
+        vector<real_type, D> origin{ detail::raw };
+        vector<real_type, D> inverse{ detail::raw };
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            origin[d] = real_type(item[0][d]);
+            inverse[d] = real_type(1) / (real_type(item[1][d]) - origin[d]);
+        }
+
+        traverse(
+            [&](const region<T, D>& bounds) { return ray_entry(bounds, origin, inverse).has_value(); },
+            [&](std::size_t i)
+            {
+                if (const auto t = ray_entry(m_items[i], origin, inverse))
+                {
+                    func(std::size_t{ m_indices[i] }, *t);
+                }
+            });
+    }
+
+    auto query(const region<T, D>& range) const -> std::vector<std::size_t>
+    {
+        std::vector<std::size_t> result;
+        query(range, [&](std::size_t index) { result.push_back(index); });
+        return result;
+    }
+
+    auto query(const vector<T, D>& point) const -> std::vector<std::size_t>
+    {
+        std::vector<std::size_t> result;
+        query(point, [&](std::size_t index) { result.push_back(index); });
+        return result;
+    }
+
+    auto query(const ray<T, D>& item) const -> std::vector<std::size_t>
+    {
+        std::vector<std::size_t> result;
+        query(item, [&](std::size_t index, real_type) { result.push_back(index); });
+        return result;
+    }
+
+private:
+    static constexpr std::size_t bin_count = 16;
+
+    // Below this depth splits follow the surface area heuristic; deeper nodes are split at the median, which bounds
+    // the depth of the tree (and the traversal stack) for any input.
+    static constexpr std::size_t max_sah_depth = 64;
+    static constexpr std::size_t max_depth = 128;
+
+    // Ranges smaller than this are not worth a task of their own.
+    static constexpr std::size_t parallel_threshold = 4096;
+
+    struct build_item
+    {
+        region<T, D> bounds;
+        vector<real_type, D> centroid;
+        std::uint32_t index;
+    };
+
+    template <class NodeTest, class ItemFunc>
+    void traverse(NodeTest&& node_test, ItemFunc&& item_func) const
+    {
+        if (m_nodes.empty())
+        {
+            return;
+        }
+
+        std::uint32_t stack[max_depth];
+        std::size_t top = 0;
+        stack[top++] = 0;
+
+        while (top != 0)
+        {
+            const node& current = m_nodes[stack[--top]];
+
+            if (!node_test(current.bounds))
+            {
+                continue;
+            }
+
+            if (current.count != 0)
+            {
+                for (std::size_t i = current.first; i < current.first + current.count; ++i)
+                {
+                    item_func(i);
+                }
+            }
+            else
+            {
+                stack[top++] = current.first + 1;
+                stack[top++] = current.first;
+            }
+        }
+    }
+
+    // Slab test; an axis in which the ray does not move yields infinite (or NaN) parameters, which the min / max
+    // ordering below ignores.
+    static auto ray_entry(
+        const region<T, D>& bounds, const vector<real_type, D>& origin, const vector<real_type, D>& inverse)
+        -> std::optional<real_type>
+    {
+        real_type near = real_type(0);
+        real_type far = std::numeric_limits<real_type>::infinity();
+
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            const real_type t0 = (real_type(lower(bounds[d])) - origin[d]) * inverse[d];
+            const real_type t1 = (real_type(upper(bounds[d])) - origin[d]) * inverse[d];
+            near = std::max(near, std::min(t0, t1));
+            far = std::min(far, std::max(t0, t1));
+        }
+
+        if (near <= far)
+        {
+            return near;
+        }
+        return {};
+    }
+
+    template <class U>
+    static auto merge(const region<U, D>& lhs, const region<U, D>& rhs) -> region<U, D>
+    {
+        region<U, D> result{};
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            result[d] = interval<U>{ std::min(lower(lhs[d]), lower(rhs[d])), std::max(upper(lhs[d]), upper(rhs[d])) };
+        }
+        return result;
+    }
+
+    // Identity of merge.
+    template <class U>
+    static auto empty_region() -> region<U, D>
+    {
+        region<U, D> result{};
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            result[d] = interval<U>{ std::numeric_limits<U>::max(), std::numeric_limits<U>::lowest() };
+        }
+        return result;
+    }
+
+    static auto point_region(const vector<real_type, D>& point) -> region<real_type, D>
+    {
+        region<real_type, D> result{};
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            result[d] = interval<real_type>{ point[d], point[d] };
+        }
+        return result;
+    }
+
+    // Half of the surface area of a box (the perimeter in 2d), the cost measure of the heuristic.
+    static auto half_area(const region<T, D>& item) -> real_type
+    {
+        real_type result{};
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            real_type product = real_type(1);
+            for (std::size_t e = 0; e < D; ++e)
+            {
+                if (e != d)
+                {
+                    product *= real_type(upper(item[e])) - real_type(lower(item[e]));
+                }
+            }
+            result += product;
+        }
+        return result;
+    }
+
+    // Items [first, last) with their bounds and the bounds of their centroids. The binning pass of a split yields the
+    // bounds of both children, so no level needs a separate pass to compute them.
+    struct build_range
+    {
+        std::size_t first;
+        std::size_t last;
+        std::size_t depth;
+        region<T, D> bounds;
+        region<real_type, D> centroids;
+    };
+
+    static auto make_range(const build_item* items, std::size_t first, std::size_t last, std::size_t depth) -> build_range
+    {
+        build_range result{ first, last, depth, empty_region<T>(), empty_region<real_type>() };
+        for (std::size_t i = first; i < last; ++i)
+        {
+            result.bounds = merge(result.bounds, items[i].bounds);
+            result.centroids = merge(result.centroids, point_region(items[i].centroid));
+        }
+        return result;
+    }
+
+    // Reorders the items of `range` and returns true with the two halves in `left` and `right`, or returns false if
+    // the items form a leaf.
+    static auto split(build_item* items, const build_range& range, build_range& left, build_range& right) -> bool
+    {
+        const std::size_t count = range.last - range.first;
+
+        if (count <= max_leaf_size)
+        {
+            return false;
+        }
+
+        const auto split_at = [&](std::size_t mid)
+        {
+            left = make_range(items, range.first, mid, range.depth + 1);
+            right = make_range(items, mid, range.last, range.depth + 1);
+            return true;
+        };
+
+        const auto size = alg::size(range.centroids);
+        std::size_t axis = 0;
+        for (std::size_t d = 1; d < D; ++d)
+        {
+            if (size[d] > size[axis])
+            {
+                axis = d;
+            }
+        }
+
+        const real_type extent = size[axis];
+        const real_type origin = lower(range.centroids[axis]);
+
+        // All centroids coincide: every split is as good as any other.
+        if (!(extent > real_type(0)))
+        {
+            return split_at(range.first + count / 2);
+        }
+
+        const auto split_at_median = [&]()
+        {
+            const std::size_t mid = range.first + count / 2;
+            std::nth_element(
+                items + range.first,
+                items + mid,
+                items + range.last,
+                [&](const build_item& lhs, const build_item& rhs) { return lhs.centroid[axis] < rhs.centroid[axis]; });
+            return split_at(mid);
+        };
+
+        if (range.depth >= max_sah_depth)
+        {
+            return split_at_median();
+        }
+
+        const real_type scale = real_type(bin_count) / extent;
+        const auto bin_of = [&](const build_item& item)
+        { return std::min(bin_count - 1, static_cast<std::size_t>((item.centroid[axis] - origin) * scale)); };
+
+        struct bin
+        {
+            std::size_t size;
+            region<T, D> bounds;
+            region<real_type, D> centroids;
+        };
+
+        bin bins[bin_count];
+        for (auto& item : bins)
+        {
+            item = bin{ 0, empty_region<T>(), empty_region<real_type>() };
+        }
+
+        for (std::size_t i = range.first; i < range.last; ++i)
+        {
+            bin& target = bins[bin_of(items[i])];
+            ++target.size;
+            target.bounds = merge(target.bounds, items[i].bounds);
+            target.centroids = merge(target.centroids, point_region(items[i].centroid));
+        }
+
+        // suffixes[b]: the bins after b, combined.
+        bin suffixes[bin_count];
+        suffixes[bin_count - 1] = bin{ 0, empty_region<T>(), empty_region<real_type>() };
+        for (std::size_t b = bin_count - 1; b > 0; --b)
+        {
+            suffixes[b - 1] = bin{ suffixes[b].size + bins[b].size,
+                                   merge(suffixes[b].bounds, bins[b].bounds),
+                                   merge(suffixes[b].centroids, bins[b].centroids) };
+        }
+
+        std::size_t best_bin = bin_count;
+        real_type best_cost = std::numeric_limits<real_type>::infinity();
+        bin best_prefix{};
+
+        bin prefix{ 0, empty_region<T>(), empty_region<real_type>() };
+        for (std::size_t b = 0; b + 1 < bin_count; ++b)
+        {
+            prefix = bin{ prefix.size + bins[b].size,
+                          merge(prefix.bounds, bins[b].bounds),
+                          merge(prefix.centroids, bins[b].centroids) };
+
+            if (prefix.size == 0 || prefix.size == count)
+            {
+                continue;
+            }
+
+            const real_type cost = half_area(prefix.bounds) * real_type(prefix.size)
+                                   + half_area(suffixes[b].bounds) * real_type(suffixes[b].size);
+            if (cost < best_cost)
+            {
+                best_cost = cost;
+                best_bin = b;
+                best_prefix = prefix;
+            }
+        }
+
+        if (best_bin == bin_count)
+        {
+            return split_at_median();
+        }
+
+        std::partition(
+            items + range.first, items + range.last, [&](const build_item& item) { return bin_of(item) <= best_bin; });
+
+        const std::size_t mid = range.first + best_prefix.size;
+        left = build_range{ range.first, mid, range.depth + 1, best_prefix.bounds, best_prefix.centroids };
+        right = build_range{ mid, range.last, range.depth + 1, suffixes[best_bin].bounds, suffixes[best_bin].centroids };
+        return true;
+    }
+
+    // Makes nodes[index] a leaf over `range`, or appends its two children and returns true with their ranges.
+    static auto build_node(
+        std::vector<node>& nodes,
+        std::size_t index,
+        build_item* items,
+        const build_range& range,
+        build_range& left,
+        build_range& right) -> bool
+    {
+        if (!split(items, range, left, right))
+        {
+            nodes[index] = node{ range.bounds,
+                                 static_cast<std::uint32_t>(range.first),
+                                 static_cast<std::uint32_t>(range.last - range.first) };
+            return false;
+        }
+
+        nodes[index] = node{ range.bounds, static_cast<std::uint32_t>(nodes.size()), 0 };
+        nodes.emplace_back();
+        nodes.emplace_back();
+        return true;
+    }
+
+    static void build(std::vector<node>& nodes, std::size_t index, build_item* items, const build_range& range)
+    {
+        build_range left;
+        build_range right;
+
+        if (build_node(nodes, index, items, range, left, right))
+        {
+            const std::size_t child = nodes[index].first;
+            build(nodes, child, items, left);
+            build(nodes, child + 1, items, right);
+        }
+    }
+
+    void build_parallel(build_item* items, const build_range& root, std::size_t threads)
+    {
+        struct task
+        {
+            std::size_t index;
+            build_range range;
+            std::vector<node> nodes;
+        };
+
+        // Split breadth-first until there are a few ranges per thread; each range becomes an independent subtree.
+        std::vector<task> tasks;
+        std::vector<task> pending{ task{ 0, root, {} } };
+
+        while (!pending.empty() && tasks.size() + pending.size() < 4 * threads)
+        {
+            std::vector<task> next;
+            for (auto& item : pending)
+            {
+                if (item.range.last - item.range.first < parallel_threshold)
+                {
+                    tasks.push_back(std::move(item));
+                    continue;
+                }
+
+                build_range left;
+                build_range right;
+
+                if (build_node(m_nodes, item.index, items, item.range, left, right))
+                {
+                    const std::size_t child = m_nodes[item.index].first;
+                    next.push_back(task{ child, left, {} });
+                    next.push_back(task{ child + 1, right, {} });
+                }
+            }
+            pending = std::move(next);
+        }
+
+        for (auto& item : pending)
+        {
+            tasks.push_back(std::move(item));
+        }
+
+        std::atomic<std::size_t> next_task{ 0 };
+        const auto worker = [&]()
+        {
+            for (std::size_t t = next_task++; t < tasks.size(); t = next_task++)
+            {
+                auto& item = tasks[t];
+                item.nodes.emplace_back();
+                build(item.nodes, 0, items, item.range);
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (std::size_t i = 1; i < std::min(threads, tasks.size()); ++i)
+        {
+            workers.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : workers)
+        {
+            thread.join();
+        }
+
+        // Local node i > 0 of a task ends up at offset + i - 1.
+        for (auto& item : tasks)
+        {
+            const auto offset = static_cast<std::uint32_t>(m_nodes.size());
+
+            for (auto& n : item.nodes)
+            {
+                if (n.count == 0)
+                {
+                    n.first += offset - 1;
+                }
+            }
+
+            m_nodes[item.index] = item.nodes[0];
+            m_nodes.insert(m_nodes.end(), item.nodes.begin() + 1, item.nodes.end());
+        }
+    }
+
+    std::vector<node> m_nodes;
+    std::vector<region<T, D>> m_items;
+    std::vector<std::uint32_t> m_indices;
+};
+
+template <class T>
+using bvh_2d = bvh<T, 2>;
+
+template <class T>
+using bvh_3d = bvh<T, 3>;
+
+}  // namespace alg
+}  // namespace ferrugo
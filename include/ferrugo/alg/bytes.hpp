@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <ferrugo/alg/span.hpp>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace ferrugo
+{
+namespace alg
+{
+namespace detail
+{
+
+// Bulk snapshots of contiguous buffers of value types (matrices, intervals, regions, shapes) as raw bytes.
+// The byte layout is the in-memory object representation, so it is only portable between builds that agree on
+// the element type, its size and endianness.
+
+struct write_bytes_fn
+{
+    // Copies the items to the front of `out`; returns the number of bytes written.
+    template <class T>
+    auto operator()(span<const T> items, span<std::byte> out) const -> std::size_t
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "write_bytes: type is not trivially copyable");
+
+        const std::size_t size = items.size() * sizeof(T);
+
+        if (out.size() < size)
+        {
+            throw std::runtime_error{ "write_bytes: buffer too small" };
+        }
+
+        if (size != 0)
+        {
+            std::memcpy(out.data(), items.data(), size);
+        }
+
+        return size;
+    }
+
+    template <class Container>
+    auto operator()(const Container& items, span<std::byte> out) const -> std::size_t
+    {
+        return (*this)(as_const_span(items), out);
+    }
+
+    template <class Container>
+    auto operator()(const Container& items) const -> std::vector<std::byte>
+    {
+        const auto view = as_const_span(items);
+        std::vector<std::byte> result(view.size_bytes());
+        (*this)(view, span<std::byte>{ result });
+        return result;
+    }
+
+private:
+    template <class Container>
+    static auto as_const_span(const Container& items)
+    {
+        return span<const std::remove_pointer_t<decltype(std::data(items))>>{ items };
+    }
+};
+
+static constexpr inline auto write_bytes = write_bytes_fn{};
+
+struct read_bytes_fn
+{
+    // Fills all of `out` from the front of `bytes`; returns the number of bytes consumed.
+    template <class T>
+    auto operator()(span<const std::byte> bytes, span<T> out) const -> std::size_t
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "read_bytes: type is not trivially copyable");
+        static_assert(!std::is_const_v<T>, "read_bytes: output is const");
+
+        const std::size_t size = out.size() * sizeof(T);
+
+        if (bytes.size() < size)
+        {
+            throw std::runtime_error{ "read_bytes: not enough data" };
+        }
+
+        if (size != 0)
+        {
+            std::memcpy(out.data(), bytes.data(), size);
+        }
+
+        return size;
+    }
+
+    template <class Container>
+    auto operator()(span<const std::byte> bytes, Container& out) const -> std::size_t
+    {
+        return (*this)(bytes, span{ out });
+    }
+};
+
+static constexpr inline auto read_bytes = read_bytes_fn{};
+
+}  // namespace detail
+
+using detail::read_bytes;
+using detail::write_bytes;
+
+}  // namespace alg
+}  // namespace ferrugo
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <ferrugo/alg/matrix.hpp>
+#include <algorithm>
+#include <type_traits>
 
 namespace ferrugo
 {
@@ -27,6 +29,8 @@ using sphere = circular_shape<T, 3>;
 template <class T>
 using circle_2d = circle<T>;
 
+static_assert(std::is_trivially_copyable_v<sphere<double>> && std::is_standard_layout_v<sphere<double>>);
+
 template <class T, class U, std::size_t D>
 auto operator+=(circular_shape<T, D>& lhs, const vector<U, D>& rhs) -> circular_shape<T, D>&
 {
@@ -55,5 +59,107 @@ auto operator-(circular_shape<T, D> lhs, const vector<U, D>& rhs) -> circular_sh
     return lhs;
 }
 
+namespace detail
+{
+
+// The largest stretch |p * linear| / |p| of a linear map, i.e. its largest singular value: the square root of the
+// largest eigenvalue of the Gram matrix of its rows. Closed form in 2d and 3d (the trigonometric solution of the
+// characteristic cubic); in higher dimensions the Frobenius norm, which is an upper bound.
+template <class T, std::size_t D>
+auto largest_stretch(const square_matrix<T, D>& linear)
+{
+    using R = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+
+    square_matrix<R, D> gram{};
+
+    for (std::size_t r = 0; r < D; ++r)
+    {
+        for (std::size_t c = 0; c < D; ++c)
+        {
+            for (std::size_t k = 0; k < D; ++k)
+            {
+                gram(r, c) += static_cast<R>(linear(r, k)) * static_cast<R>(linear(c, k));
+            }
+        }
+    }
+
+    R eigenvalue = R{};
+
+    if constexpr (D == 1)
+    {
+        eigenvalue = gram(0, 0);
+    }
+    else if constexpr (D == 2)
+    {
+        const R mean = (gram(0, 0) + gram(1, 1)) / 2;
+        const R half_difference = (gram(0, 0) - gram(1, 1)) / 2;
+        eigenvalue = mean + sqrt(half_difference * half_difference + gram(0, 1) * gram(0, 1));
+    }
+    else if constexpr (D == 3)
+    {
+        const R off_diagonal = gram(0, 1) * gram(0, 1) + gram(0, 2) * gram(0, 2) + gram(1, 2) * gram(1, 2);
+        const R mean = (gram(0, 0) + gram(1, 1) + gram(2, 2)) / 3;
+        const R spread = (gram(0, 0) - mean) * (gram(0, 0) - mean) + (gram(1, 1) - mean) * (gram(1, 1) - mean)
+                         + (gram(2, 2) - mean) * (gram(2, 2) - mean) + 2 * off_diagonal;
+
+        if (spread == R{})
+        {
+            eigenvalue = mean;
+        }
+        else
+        {
+            const R p = sqrt(spread / 6);
+            square_matrix<R, D> b = gram;
+            for (std::size_t i = 0; i < D; ++i)
+            {
+                b(i, i) -= mean;
+            }
+            for (auto& value : b)
+            {
+                value /= p;
+            }
+            const R det = b(0, 0) * (b(1, 1) * b(2, 2) - b(1, 2) * b(2, 1))
+                          - b(0, 1) * (b(1, 0) * b(2, 2) - b(1, 2) * b(2, 0))
+                          + b(0, 2) * (b(1, 0) * b(2, 1) - b(1, 1) * b(2, 0));
+            const R half_det = std::clamp(det / 2, R(-1), R(1));
+            eigenvalue = mean + 2 * p * cos(acos(half_det) / 3);
+        }
+    }
+    else
+    {
+        for (std::size_t i = 0; i < D; ++i)
+        {
+            eigenvalue += gram(i, i);
+        }
+    }
+
+    return sqrt(std::max(eigenvalue, R{}));
+}
+
+}  // namespace detail
+
+// The smallest circle (sphere) containing the image of the shape: exact for rotations, reflections and uniform scales.
+// Under other linear parts the image is an ellipse, and the radius is scaled by the largest stretch of the map, so
+// that the result is its bounding circle (above 3 dimensions a larger one, see largest_stretch).
+template <class T, class U, std::size_t D>
+auto operator*=(circular_shape<T, D>& lhs, const affine_transform<U, D>& rhs) -> circular_shape<T, D>&
+{
+    lhs.center *= rhs;
+    lhs.radius = static_cast<T>(lhs.radius * detail::largest_stretch(rhs.linear));
+    return lhs;
+}
+
+template <class T, class U, std::size_t D>
+auto operator*(circular_shape<T, D> lhs, const affine_transform<U, D>& rhs) -> circular_shape<T, D>
+{
+    return lhs *= rhs;
+}
+
+template <class T, class U, std::size_t D>
+auto operator*(const affine_transform<U, D>& lhs, circular_shape<T, D> rhs) -> circular_shape<T, D>
+{
+    return rhs *= lhs;
+}
+
 }  // namespace alg
 }  // namespace ferrugo
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <ferrugo/alg/operations.hpp>
+#include <ferrugo/alg/polygon.hpp>
+#include <ferrugo/alg/region.hpp>
+#include <ferrugo/alg/span.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace ferrugo
+{
+namespace alg
+{
+
+// Number of vertices a convex polygon of n vertices can have after clipping to a rectangle.
+constexpr auto clip_capacity(std::size_t n) -> std::size_t
+{
+    return n + 4;
+}
+
+// Result of clip_all: the clipped items[indices[i]] has the vertices [offsets[i], offsets[i + 1]), the last polygon
+// ending at vertices.size().
+template <class T>
+struct clipped_polygons
+{
+    std::vector<std::size_t> indices;
+    std::vector<std::size_t> offsets;
+    std::vector<vector_2d<T>> vertices;
+
+    void clear()
+    {
+        indices.clear();
+        offsets.clear();
+        vertices.clear();
+    }
+};
+
+namespace detail
+{
+
+struct clip_fn
+{
+    // Sutherland-Hodgman clipping of a convex polygon to the closed rectangle `rect`. Writes the vertices of the
+    // clipped polygon to `out`, which needs room for clip_capacity(N) of them, and returns their number: N for
+    // polygons inside of the rectangle, which are copied, and 0 for polygons outside of it or touching it in fewer
+    // than three distinct points. Only the sides of the rectangle crossed by the bounds of the polygon are clipped
+    // against. A new vertex is interpolated from the end of the edge inside of the side, so edges shared by adjacent
+    // polygons are cut at the same point.
+    template <class T, std::size_t N>
+    auto operator()(
+        const polygon_base<T, 2, N>& item, const region_2d<T>& rect, span<vector_2d<nondeduced_t<T>>> out) const
+        -> std::size_t
+    {
+        static_assert(std::is_floating_point_v<T>, "clip: floating point coordinates expected");
+
+        if (out.size() < clip_capacity(N))
+        {
+            throw std::runtime_error{ "clip: output buffer too small" };
+        }
+
+        const auto box = bounds(item);
+        if (contains(rect, box))
+        {
+            std::copy(item.begin(), item.end(), out.begin());
+            return N;
+        }
+        if (!intersects(rect, box))
+        {
+            return 0;
+        }
+
+        std::array<vector_2d<T>, clip_capacity(N)> buffers[2];
+        std::copy(item.begin(), item.end(), buffers[0].begin());
+        std::size_t size = N;
+        std::size_t current = 0;
+
+        for (std::size_t d = 0; d < 2; ++d)
+        {
+            if (lower(box[d]) < lower(rect[d]))
+            {
+                size = clip_side(buffers[current], size, d, lower(rect[d]), false, buffers[1 - current]);
+                current = 1 - current;
+            }
+            if (upper(rect[d]) < upper(box[d]))
+            {
+                size = clip_side(buffers[current], size, d, upper(rect[d]), true, buffers[1 - current]);
+                current = 1 - current;
+            }
+        }
+
+        if (size < 3)
+        {
+            return 0;
+        }
+        std::copy(buffers[current].begin(), buffers[current].begin() + size, out.begin());
+        return size;
+    }
+
+private:
+    // Keeps the part of the polygon with coordinate d not above `limit` if `below`, not below it otherwise. Vertices
+    // repeating the previous one, as made where the polygon only touches the side, are dropped. Only a polygon that is
+    // not convex can cross the side more than twice and make more than one new vertex.
+    template <class T, std::size_t Capacity>
+    static auto clip_side(
+        const std::array<vector_2d<T>, Capacity>& vertices,
+        std::size_t size,
+        std::size_t d,
+        T limit,
+        bool below,
+        std::array<vector_2d<T>, Capacity>& out) -> std::size_t
+    {
+        const auto inside = [&](const vector_2d<T>& point) { return below ? point[d] <= limit : limit <= point[d]; };
+
+        const auto crossing = [&](const vector_2d<T>& in, const vector_2d<T>& out_point)
+        {
+            const T t = (limit - in[d]) / (out_point[d] - in[d]);
+            vector_2d<T> result = in + (out_point - in) * t;
+            result[d] = limit;
+            return result;
+        };
+
+        std::size_t count = 0;
+        const auto push = [&](const vector_2d<T>& point)
+        {
+            if (count != 0 && out[count - 1] == point)
+            {
+                return;
+            }
+            if (count == Capacity)
+            {
+                throw std::runtime_error{ "clip: polygon not convex" };
+            }
+            out[count++] = point;
+        };
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            const auto& start = vertices[i == 0 ? size - 1 : i - 1];
+            const auto& end = vertices[i];
+            const bool start_inside = inside(start);
+            const bool end_inside = inside(end);
+
+            if (start_inside != end_inside)
+            {
+                push(start_inside ? crossing(start, end) : crossing(end, start));
+            }
+            if (end_inside)
+            {
+                push(end);
+            }
+        }
+        if (count > 1 && out[count - 1] == out[0])
+        {
+            --count;
+        }
+        return count;
+    }
+};
+
+static constexpr inline auto clip = clip_fn{};
+
+struct clip_all_fn
+{
+    // Appends the items clipped to `rect` to `out`, skipping the ones outside of it, and returns their number.
+    template <class T, std::size_t N>
+    auto operator()(span<const polygon_base<T, 2, N>> items, const region_2d<T>& rect, clipped_polygons<T>& out) const
+        -> std::size_t
+    {
+        const std::size_t initial_size = out.indices.size();
+        std::array<vector_2d<T>, clip_capacity(N)> buffer;
+
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            const std::size_t size = clip(items[i], rect, span<vector_2d<T>>{ buffer });
+            if (size != 0)
+            {
+                out.indices.push_back(i);
+                out.offsets.push_back(out.vertices.size());
+                out.vertices.insert(out.vertices.end(), buffer.begin(), buffer.begin() + size);
+            }
+        }
+
+        return out.indices.size() - initial_size;
+    }
+
+    template <class T, std::size_t N>
+    auto operator()(const std::vector<polygon_base<T, 2, N>>& items, const region_2d<T>& rect, clipped_polygons<T>& out)
+        const -> std::size_t
+    {
+        return (*this)(span<const polygon_base<T, 2, N>>{ items }, rect, out);
+    }
+
+    template <class T, std::size_t N>
+    auto operator()(const std::vector<polygon_base<T, 2, N>>& items, const region_2d<T>& rect) const
+        -> clipped_polygons<T>
+    {
+        clipped_polygons<T> result;
+        (*this)(items, rect, result);
+        return result;
+    }
+};
+
+static constexpr inline auto clip_all = clip_all_fn{};
+
+}  // namespace detail
+
+using detail::clip;
+using detail::clip_all;
+
+}  // namespace alg
+}  // namespace ferrugo
@@ -0,0 +1,295 @@
+#pragma once
+
+#include <ferrugo/alg/operations.hpp>
+#include <ferrugo/alg/polygon.hpp>
+#include <ferrugo/alg/predicates.hpp>
+#include <ferrugo/alg/span.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ferrugo
+{
+namespace alg
+{
+namespace detail
+{
+
+struct convex_hull_fn
+{
+    // Vertices of the convex hull of the points in counterclockwise order, starting from the one with the smallest
+    // coordinates, without collinear or repeated vertices; fewer than three for degenerate inputs.
+    // Before sorting, the points strictly inside the octagon spanned by the points extreme along the axes and the
+    // diagonals are dropped (Akl-Toussaint), so that only the survivors are copied and sorted for Andrew's monotone
+    // chain. With threads > 1, the input is split into parts whose hulls are computed in parallel and then merged by
+    // taking the hull of their vertices. The turns are tested with predicates::orient2d for floating point coordinates.
+    template <class T>
+    auto operator()(span<const vector_2d<T>> points, std::size_t threads = 1) const -> polygon<T>
+    {
+        const std::size_t parts = std::max<std::size_t>(1, std::min(threads, points.size() / min_part_size));
+        const std::size_t part_size = (points.size() + parts - 1) / std::max<std::size_t>(1, parts);
+        const auto part = [&](std::size_t i)
+        {
+            const std::size_t first = std::min(points.size(), i * part_size);
+            const std::size_t last = std::min(points.size(), first + part_size);
+            return span<const vector_2d<T>>{ points.data() + first, last - first };
+        };
+
+        std::vector<std::array<vector_2d<T>, 8>> part_extremes(parts);
+        parallel_for(parts, [&](std::size_t i) { part_extremes[i] = extremes(part(i)); });
+
+        octagon<T> inner;
+        if (!points.empty())
+        {
+            std::array<vector_2d<T>, 8> all = part_extremes[0];
+            for (std::size_t i = 1; i < parts; ++i)
+            {
+                for (std::size_t d = 0; d < 8; ++d)
+                {
+                    if (keys(all[d])[d] < keys(part_extremes[i][d])[d])
+                    {
+                        all[d] = part_extremes[i][d];
+                    }
+                }
+            }
+            inner = make_octagon(all);
+        }
+
+        std::vector<polygon<T>> part_hulls(parts);
+        parallel_for(
+            parts,
+            [&](std::size_t i)
+            {
+                std::vector<vector_2d<T>> survivors;
+                for (const auto& point : part(i))
+                {
+                    if (!discarded(inner, point))
+                    {
+                        survivors.push_back(point);
+                    }
+                }
+                part_hulls[i] = monotone_chain(survivors);
+            });
+
+        if (parts == 1)
+        {
+            return std::move(part_hulls[0]);
+        }
+
+        std::vector<vector_2d<T>> vertices;
+        for (const auto& hull : part_hulls)
+        {
+            vertices.insert(vertices.end(), hull.begin(), hull.end());
+        }
+        return monotone_chain(vertices);
+    }
+
+    template <class T>
+    auto operator()(const std::vector<vector_2d<T>>& points, std::size_t threads = 1) const -> polygon<T>
+    {
+        return (*this)(span<const vector_2d<T>>{ points }, threads);
+    }
+
+private:
+    // Parts smaller than this are not worth a thread.
+    static constexpr std::size_t min_part_size = 1 << 14;
+
+    // Distinct vertices of the polygon spanned by the extreme points in counterclockwise order, the first one repeated
+    // at the end, and an axis-aligned box inside of it, which is empty if none was found.
+    template <class T>
+    struct octagon
+    {
+        std::array<vector_2d<T>, 9> vertices;
+        std::size_t size = 0;
+        vector_2d<T> box_lower = vec(T(1), T(1));
+        vector_2d<T> box_upper = vec(T(0), T(0));
+    };
+
+    template <class Func>
+    static void parallel_for(std::size_t count, Func&& func)
+    {
+        std::vector<std::thread> workers;
+        for (std::size_t i = 1; i < count; ++i)
+        {
+            workers.emplace_back([&func, i]() { func(i); });
+        }
+        func(0);
+        for (auto& thread : workers)
+        {
+            thread.join();
+        }
+    }
+
+    template <class T>
+    static auto turn(const vector_2d<T>& a, const vector_2d<T>& b, const vector_2d<T>& c) -> T
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            return predicates::orient2d(a, b, c);
+        }
+        else
+        {
+            return cross(b - a, c - a);
+        }
+    }
+
+    // Projections onto the directions -y, x - y, x, x + y, y, y - x, -x, -x - y, which are in counterclockwise order,
+    // so that the points maximizing them are too.
+    template <class T>
+    static auto keys(const vector_2d<T>& point) -> std::array<T, 8>
+    {
+        const T x = point[0];
+        const T y = point[1];
+        return { -y, x - y, x, x + y, y, y - x, -x, -x - y };
+    }
+
+    template <class T>
+    static auto extremes(span<const vector_2d<T>> points) -> std::array<vector_2d<T>, 8>
+    {
+        std::array<vector_2d<T>, 8> result{};
+        if (points.empty())
+        {
+            return result;
+        }
+
+        std::array<T, 8> best = keys(points[0]);
+        std::array<std::size_t, 8> indices{};
+
+        // Selects without branches, which would be mispredicted while the extremes are still changing.
+        for (std::size_t i = 1; i < points.size(); ++i)
+        {
+            const auto values = keys(points[i]);
+            for (std::size_t d = 0; d < 8; ++d)
+            {
+                const bool better = best[d] < values[d];
+                best[d] = better ? values[d] : best[d];
+                indices[d] = better ? i : indices[d];
+            }
+        }
+
+        for (std::size_t d = 0; d < 8; ++d)
+        {
+            result[d] = points[indices[d]];
+        }
+        return result;
+    }
+
+    template <class T>
+    static auto make_octagon(const std::array<vector_2d<T>, 8>& points) -> octagon<T>
+    {
+        octagon<T> result;
+        for (const auto& point : points)
+        {
+            if (result.size == 0 || !(point == result.vertices[result.size - 1]))
+            {
+                result.vertices[result.size++] = point;
+            }
+        }
+        while (result.size > 1 && result.vertices[result.size - 1] == result.vertices[0])
+        {
+            --result.size;
+        }
+        result.vertices[result.size] = result.vertices[0];
+
+        // Most points fall into the box spanned by the innermost coordinates of the extremes, which is kept if its
+        // corners pass the exact test, as then all its points do.
+        const auto lower = vec(
+            std::max({ points[5][0], points[6][0], points[7][0] }),
+            std::max({ points[7][1], points[0][1], points[1][1] }));
+        const auto upper = vec(
+            std::min({ points[1][0], points[2][0], points[3][0] }),
+            std::min({ points[3][1], points[4][1], points[5][1] }));
+        if (lower[0] <= upper[0] && lower[1] <= upper[1] && strictly_inside(result, lower)
+            && strictly_inside(result, upper) && strictly_inside(result, vec(lower[0], upper[1]))
+            && strictly_inside(result, vec(upper[0], lower[1])))
+        {
+            result.box_lower = lower;
+            result.box_upper = upper;
+        }
+        return result;
+    }
+
+    // Being strictly left of all the edges of the octagon makes the point an interior point of the hull, even if the
+    // extremes were picked with rounding and the octagon is not quite convex; for degenerate octagons no point is.
+    template <class T>
+    static auto strictly_inside(const octagon<T>& inner, const vector_2d<T>& point) -> bool
+    {
+        if (inner.size < 3)
+        {
+            return false;
+        }
+        for (std::size_t i = 0; i < inner.size; ++i)
+        {
+            if (!(turn(inner.vertices[i], inner.vertices[i + 1], point) > T(0)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <class T>
+    static auto discarded(const octagon<T>& inner, const vector_2d<T>& point) -> bool
+    {
+        if (inner.box_lower[0] <= point[0] && point[0] <= inner.box_upper[0] && inner.box_lower[1] <= point[1]
+            && point[1] <= inner.box_upper[1])
+        {
+            return true;
+        }
+        return strictly_inside(inner, point);
+    }
+
+    // Sorts and deduplicates `points` in place.
+    template <class T>
+    static auto monotone_chain(std::vector<vector_2d<T>>& points) -> polygon<T>
+    {
+        const auto less = [](const vector_2d<T>& lhs, const vector_2d<T>& rhs)
+        { return lhs[0] < rhs[0] || (lhs[0] == rhs[0] && lhs[1] < rhs[1]); };
+
+        std::sort(points.begin(), points.end(), less);
+        points.erase(std::unique(points.begin(), points.end()), points.end());
+
+        const std::size_t n = points.size();
+        if (n < 3)
+        {
+            return polygon<T>(points.begin(), points.end());
+        }
+
+        polygon<T> result(2 * n);
+        std::size_t k = 0;
+
+        // The lower chain from left to right, then the upper one back, popping the vertices that do not turn left.
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            while (k >= 2 && !(turn(result[k - 2], result[k - 1], points[i]) > T(0)))
+            {
+                --k;
+            }
+            result[k++] = points[i];
+        }
+
+        const std::size_t lower_size = k + 1;
+        for (std::size_t i = n - 1; i-- > 0;)
+        {
+            while (k >= lower_size && !(turn(result[k - 2], result[k - 1], points[i]) > T(0)))
+            {
+                --k;
+            }
+            result[k++] = points[i];
+        }
+
+        // The first vertex was added again at the end.
+        result.resize(k - 1);
+        return result;
+    }
+};
+
+}  // namespace detail
+
+static constexpr inline auto convex_hull = detail::convex_hull_fn{};
+
+}  // namespace alg
+}  // namespace ferrugo
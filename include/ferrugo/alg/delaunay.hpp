@@ -0,0 +1,474 @@
+#pragma once
+
+#include <ferrugo/alg/operations.hpp>
+#include <ferrugo/alg/polygon.hpp>
+#include <ferrugo/alg/predicates.hpp>
+#include <ferrugo/alg/span.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ferrugo
+{
+namespace alg
+{
+
+// Delaunay triangulation of a set of points, built by Bowyer-Watson incremental insertion.
+// The points are inserted in the order of a Hilbert curve over their bounding box, so that each one is located by a
+// short walk from the triangles created for the previous one. The hull is closed by ghost triangles sharing a vertex at
+// infinity, which makes points outside of the current hull ordinary insertions. All decisions are taken with
+// predicates::orient2d and predicates::incircle, so the result is a valid triangulation for any input; for cocircular
+// points one of the possible triangulations is chosen. Repeated points are inserted once; if all points are collinear
+// there are no triangles.
+// Triangles are stored as indices of their vertices in counterclockwise order, together with the adjacent triangles:
+// neighbors()[i][j] is the triangle sharing the edge of triangle i opposite to its vertex j, or no_neighbor on the
+// hull.
+template <class T>
+class delaunay_triangulation
+{
+public:
+    static_assert(std::is_floating_point_v<T>, "delaunay_triangulation: floating point coordinates expected");
+
+    using index_type = std::uint32_t;
+    using indexed_triangle = std::array<index_type, 3>;
+
+    static constexpr index_type no_neighbor = std::numeric_limits<index_type>::max();
+
+    delaunay_triangulation() = default;
+
+    explicit delaunay_triangulation(span<const vector_2d<T>> points) : m_points(points.begin(), points.end())
+    {
+        if (points.size() >= std::numeric_limits<index_type>::max() - 1)
+        {
+            throw std::runtime_error{ "delaunay_triangulation: too many points" };
+        }
+
+        const auto order = hilbert_order(m_points);
+
+        builder b{ m_points };
+        if (!b.start(order))
+        {
+            return;
+        }
+        for (const index_type index : order)
+        {
+            b.insert(index);
+        }
+        b.finish(m_triangles, m_neighbors);
+    }
+
+    auto points() const -> const std::vector<vector_2d<T>>&
+    {
+        return m_points;
+    }
+
+    auto triangles() const -> const std::vector<indexed_triangle>&
+    {
+        return m_triangles;
+    }
+
+    auto neighbors() const -> const std::vector<indexed_triangle>&
+    {
+        return m_neighbors;
+    }
+
+    // The number of triangles.
+    auto size() const -> std::size_t
+    {
+        return m_triangles.size();
+    }
+
+    auto empty() const -> bool
+    {
+        return m_triangles.empty();
+    }
+
+    auto triangle(std::size_t index) const -> triangle_2d<T>
+    {
+        const auto& item = m_triangles[index];
+        return triangle_2d<T>{ m_points[item[0]], m_points[item[1]], m_points[item[2]] };
+    }
+
+    auto to_triangles() const -> std::vector<triangle_2d<T>>
+    {
+        std::vector<triangle_2d<T>> result(size());
+        for (std::size_t i = 0; i < size(); ++i)
+        {
+            result[i] = triangle(i);
+        }
+        return result;
+    }
+
+private:
+    // The vertex of the ghost triangles.
+    static constexpr index_type infinite_vertex = std::numeric_limits<index_type>::max();
+
+    static constexpr auto next(std::size_t j) -> std::size_t
+    {
+        return j == 2 ? 0 : j + 1;
+    }
+
+    static constexpr auto prev(std::size_t j) -> std::size_t
+    {
+        return j == 0 ? 2 : j - 1;
+    }
+
+    // Index of (x, y) along the Hilbert curve filling a 2^16 x 2^16 grid.
+    static auto hilbert_index(std::uint32_t x, std::uint32_t y) -> std::uint64_t
+    {
+        constexpr std::uint32_t n = 1 << 16;
+
+        std::uint64_t result = 0;
+        for (std::uint32_t s = n / 2; s > 0; s /= 2)
+        {
+            const std::uint32_t rx = (x & s) != 0;
+            const std::uint32_t ry = (y & s) != 0;
+            result += std::uint64_t(s) * s * ((3 * rx) ^ ry);
+            if (ry == 0)
+            {
+                if (rx == 1)
+                {
+                    x = n - 1 - x;
+                    y = n - 1 - y;
+                }
+                std::swap(x, y);
+            }
+        }
+        return result;
+    }
+
+    static auto hilbert_order(const std::vector<vector_2d<T>>& points) -> std::vector<index_type>
+    {
+        std::vector<std::pair<std::uint64_t, index_type>> keys(points.size());
+        if (points.empty())
+        {
+            return {};
+        }
+
+        auto lower = points[0];
+        auto upper = points[0];
+        for (const auto& point : points)
+        {
+            for (std::size_t d = 0; d < 2; ++d)
+            {
+                lower[d] = std::min(lower[d], point[d]);
+                upper[d] = std::max(upper[d], point[d]);
+            }
+        }
+
+        const auto cell = [&](std::size_t d, T value) -> std::uint32_t
+        {
+            const T extent = upper[d] - lower[d];
+            return extent > T(0) ? static_cast<std::uint32_t>((value - lower[d]) / extent * T(65535)) : 0;
+        };
+
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            keys[i] = { hilbert_index(cell(0, points[i][0]), cell(1, points[i][1])), static_cast<index_type>(i) };
+        }
+        std::sort(keys.begin(), keys.end());
+
+        std::vector<index_type> result(points.size());
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            result[i] = keys[i].second;
+        }
+        return result;
+    }
+
+    // State of the construction, including the ghost triangles and the triangles freed for reuse.
+    struct builder
+    {
+        struct boundary_edge
+        {
+            index_type start;
+            index_type end;
+            index_type outside;
+        };
+
+        const std::vector<vector_2d<T>>& points;
+        std::vector<indexed_triangle> vertices;
+        std::vector<indexed_triangle> neighbors;
+        std::vector<std::uint32_t> visits;  // the last insertion that tested the triangle for conflicts...
+        std::vector<std::uint8_t> conflicts;  // ...and its result
+        std::vector<index_type> free;
+        std::vector<index_type> stack;
+        std::vector<boundary_edge> boundary;
+        std::vector<index_type> made;
+        std::uint32_t epoch = 0;
+        std::uint32_t random = 1;
+        index_type last = 0;  // a finite triangle made by the last insertion, where the next walk starts
+
+        explicit builder(const std::vector<vector_2d<T>>& points) : points(points)
+        {
+        }
+
+        auto allocate() -> index_type
+        {
+            if (!free.empty())
+            {
+                const index_type result = free.back();
+                free.pop_back();
+                return result;
+            }
+            vertices.emplace_back();
+            neighbors.emplace_back();
+            visits.push_back(0);
+            conflicts.push_back(0);
+            return static_cast<index_type>(vertices.size() - 1);
+        }
+
+        static auto is_ghost(const indexed_triangle& item) -> bool
+        {
+            return item[0] == infinite_vertex || item[1] == infinite_vertex || item[2] == infinite_vertex;
+        }
+
+        // Makes the first triangle from the first point, the next one different from it and the next one not collinear
+        // with both, and closes it with three ghost triangles. False if all points are collinear.
+        auto start(const std::vector<index_type>& order) -> bool
+        {
+            if (order.empty())
+            {
+                return false;
+            }
+
+            const index_type a = order[0];
+            const auto second = std::find_if(
+                order.begin(), order.end(), [&](index_type index) { return !(points[index] == points[a]); });
+            if (second == order.end())
+            {
+                return false;
+            }
+
+            index_type b = *second;
+            const auto third = std::find_if(
+                second,
+                order.end(),
+                [&](index_type index) { return predicates::orient2d(points[a], points[b], points[index]) != T(0); });
+            if (third == order.end())
+            {
+                return false;
+            }
+
+            index_type c = *third;
+            if (predicates::orient2d(points[a], points[b], points[c]) < T(0))
+            {
+                std::swap(b, c);
+            }
+
+            // Ghost i lies across the edge opposite to vertex i.
+            const indexed_triangle corners = { a, b, c };
+            const index_type t = allocate();
+            vertices[t] = corners;
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                const index_type ghost = allocate();
+                vertices[ghost] = { corners[prev(i)], corners[next(i)], infinite_vertex };
+                neighbors[t][i] = ghost;
+            }
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                neighbors[neighbors[t][i]] = { neighbors[t][prev(i)], neighbors[t][next(i)], t };
+            }
+            last = t;
+            return true;
+        }
+
+        // p is strictly inside the circumcircle of a finite triangle, or strictly outside of the hull edge of a ghost
+        // triangle, or inside of that edge.
+        auto in_conflict(index_type t, index_type p) const -> bool
+        {
+            const auto& item = vertices[t];
+            const auto& point = points[p];
+
+            for (std::size_t j = 0; j < 3; ++j)
+            {
+                if (item[j] == infinite_vertex)
+                {
+                    const auto& a = points[item[next(j)]];
+                    const auto& b = points[item[prev(j)]];
+                    const T turn = predicates::orient2d(a, b, point);
+                    if (turn != T(0))
+                    {
+                        return turn > T(0);
+                    }
+                    const std::size_t d = a[0] != b[0] ? 0 : 1;
+                    return std::min(a[d], b[d]) < point[d] && point[d] < std::max(a[d], b[d]);
+                }
+            }
+
+            return predicates::incircle(points[item[0]], points[item[1]], points[item[2]], point) > T(0);
+        }
+
+        // A triangle in conflict with p, found by walking from the last one towards p: a finite triangle containing
+        // it or a ghost triangle whose edge it lies beyond. no_neighbor if p repeats a vertex.
+        auto locate(index_type p) -> index_type
+        {
+            const auto& point = points[p];
+            index_type t = last;
+            while (true)
+            {
+                const auto& item = vertices[t];
+                if (is_ghost(item))
+                {
+                    return t;
+                }
+
+                // Tries the edges from a random one, so that the walk cannot cycle.
+                random ^= random << 13;
+                random ^= random >> 17;
+                random ^= random << 5;
+                const std::size_t first = random % 3;
+
+                bool moved = false;
+                for (std::size_t k = 0; k < 3 && !moved; ++k)
+                {
+                    const std::size_t j = (first + k) % 3;
+                    if (predicates::orient2d(points[item[next(j)]], points[item[prev(j)]], point) < T(0))
+                    {
+                        t = neighbors[t][j];
+                        moved = true;
+                    }
+                }
+
+                if (!moved)
+                {
+                    for (const index_type vertex : item)
+                    {
+                        if (points[vertex] == point)
+                        {
+                            return no_neighbor;
+                        }
+                    }
+                    return t;
+                }
+            }
+        }
+
+        void insert(index_type p)
+        {
+            const index_type t = locate(p);
+            if (t == no_neighbor)
+            {
+                return;
+            }
+
+            // The cavity: the triangles in conflict with p, which are connected and are freed for the new ones.
+            ++epoch;
+            boundary.clear();
+            stack.assign(1, t);
+            visits[t] = epoch;
+            conflicts[t] = 1;
+
+            while (!stack.empty())
+            {
+                const index_type current = stack.back();
+                stack.pop_back();
+                free.push_back(current);
+
+                for (std::size_t j = 0; j < 3; ++j)
+                {
+                    const index_type other = neighbors[current][j];
+                    if (visits[other] != epoch)
+                    {
+                        visits[other] = epoch;
+                        conflicts[other] = in_conflict(other, p);
+                        if (conflicts[other])
+                        {
+                            stack.push_back(other);
+                        }
+                    }
+                    if (!conflicts[other])
+                    {
+                        boundary.push_back({ vertices[current][next(j)], vertices[current][prev(j)], other });
+                    }
+                }
+            }
+
+            // Fans the boundary to p. The triangle made of edge (start, end) shares (end, p) with the one starting at
+            // end and (p, start) with the one ending at start.
+            made.clear();
+            for (const auto& edge : boundary)
+            {
+                const index_type created = allocate();
+                vertices[created] = { edge.start, edge.end, p };
+                neighbors[created][2] = edge.outside;
+
+                auto& outside = neighbors[edge.outside];
+                const auto& outside_vertices = vertices[edge.outside];
+                for (std::size_t j = 0; j < 3; ++j)
+                {
+                    if (outside_vertices[next(j)] == edge.end && outside_vertices[prev(j)] == edge.start)
+                    {
+                        outside[j] = created;
+                    }
+                }
+
+                made.push_back(created);
+                if (edge.start != infinite_vertex && edge.end != infinite_vertex)
+                {
+                    last = created;
+                }
+            }
+
+            for (std::size_t i = 0; i < made.size(); ++i)
+            {
+                for (std::size_t k = 0; k < made.size(); ++k)
+                {
+                    if (boundary[k].start == boundary[i].end)
+                    {
+                        neighbors[made[i]][0] = made[k];
+                    }
+                    if (boundary[k].end == boundary[i].start)
+                    {
+                        neighbors[made[i]][1] = made[k];
+                    }
+                }
+            }
+        }
+
+        // Keeps the finite triangles, renumbered, with the ghost neighbors replaced by no_neighbor.
+        void finish(std::vector<indexed_triangle>& triangles, std::vector<indexed_triangle>& adjacent) const
+        {
+            std::vector<bool> freed(vertices.size(), false);
+            for (const index_type index : free)
+            {
+                freed[index] = true;
+            }
+
+            std::vector<index_type> renumbered(vertices.size(), no_neighbor);
+            for (std::size_t i = 0; i < vertices.size(); ++i)
+            {
+                if (!freed[i] && !is_ghost(vertices[i]))
+                {
+                    renumbered[i] = static_cast<index_type>(triangles.size());
+                    triangles.push_back(vertices[i]);
+                }
+            }
+
+            adjacent.resize(triangles.size());
+            for (std::size_t i = 0; i < vertices.size(); ++i)
+            {
+                if (renumbered[i] != no_neighbor)
+                {
+                    for (std::size_t j = 0; j < 3; ++j)
+                    {
+                        adjacent[renumbered[i]][j] = renumbered[neighbors[i][j]];
+                    }
+                }
+            }
+        }
+    };
+
+    std::vector<vector_2d<T>> m_points;
+    std::vector<indexed_triangle> m_triangles;
+    std::vector<indexed_triangle> m_neighbors;
+};
+
+}  // namespace alg
+}  // namespace ferrugo
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <array>
 #include <functional>
 #include <iostream>
+#include <type_traits>
 
 namespace ferrugo
 {
@@ -26,6 +28,8 @@ struct interval : std::array<T, 2>
     }
 };
 
+static_assert(std::is_trivially_copyable_v<interval<float>> && std::is_standard_layout_v<interval<float>>);
+
 template <class T, class U>
 bool operator==(const interval<T>& lhs, const interval<U>& rhs)
 {
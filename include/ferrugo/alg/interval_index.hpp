@@ -0,0 +1,198 @@
+#pragma once
+
+#include <ferrugo/alg/operations.hpp>
+#include <ferrugo/alg/span.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace ferrugo
+{
+namespace alg
+{
+
+// Immutable index over a set of half-open intervals [lo, up), for stabbing and overlap queries.
+// The intervals are sorted by their lower bounds and the sorted array is read as an implicit balanced search tree: the
+// root of every range [first, last) is its middle element. Each position also stores the largest upper bound within
+// its range, which lets a query skip the ranges that end too early. Counting only needs the sorted lower bounds and a
+// sorted copy of the upper bounds. Empty intervals (up <= lo) contain no value and are never reported.
+// An interval contains t if lo <= t < up, as in contains(interval, value); two intervals overlap if they contain a
+// common value, so unlike intersects(interval, interval), intervals that only touch do not overlap.
+template <class T>
+class interval_index
+{
+public:
+    interval_index() = default;
+
+    explicit interval_index(span<const interval<T>> items)
+    {
+        if (items.size() >= std::numeric_limits<std::uint32_t>::max())
+        {
+            throw std::runtime_error{ "interval_index: too many intervals" };
+        }
+
+        struct entry
+        {
+            T lo;
+            T up;
+            std::uint32_t index;
+        };
+
+        std::vector<entry> entries;
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            if (lower(items[i]) < upper(items[i]))
+            {
+                entries.push_back(entry{ lower(items[i]), upper(items[i]), static_cast<std::uint32_t>(i) });
+            }
+        }
+
+        std::sort(entries.begin(), entries.end(), [](const entry& lhs, const entry& rhs) { return lhs.lo < rhs.lo; });
+
+        m_lower.reserve(entries.size());
+        m_upper.reserve(entries.size());
+        m_indices.reserve(entries.size());
+        for (const auto& item : entries)
+        {
+            m_lower.push_back(item.lo);
+            m_upper.push_back(item.up);
+            m_indices.push_back(item.index);
+        }
+
+        m_max_upper.resize(m_upper.size());
+        if (!m_upper.empty())
+        {
+            build(0, m_upper.size());
+        }
+
+        m_sorted_upper = m_upper;
+        std::sort(m_sorted_upper.begin(), m_sorted_upper.end());
+    }
+
+    // Number of non-empty intervals in the index.
+    auto size() const -> std::size_t
+    {
+        return m_indices.size();
+    }
+
+    auto empty() const -> bool
+    {
+        return m_indices.empty();
+    }
+
+    // Calls func(index) for each interval that contains `value`, in order of the lower bounds.
+    template <class Func>
+    void stabbing(T value, Func&& func) const
+    {
+        search(0, m_lower.size(), value, [&](T lo) { return value < lo; }, func);
+    }
+
+    auto stabbing(T value) const -> std::vector<std::size_t>
+    {
+        std::vector<std::size_t> result;
+        stabbing(value, [&](std::size_t index) { result.push_back(index); });
+        return result;
+    }
+
+    // Calls func(index) for each interval that overlaps `range`, in order of the lower bounds.
+    template <class Func>
+    void overlapping(const interval<T>& range, Func&& func) const
+    {
+        const T up = upper(range);
+        if (lower(range) < up)
+        {
+            search(0, m_lower.size(), lower(range), [&](T lo) { return up <= lo; }, func);
+        }
+    }
+
+    auto overlapping(const interval<T>& range) const -> std::vector<std::size_t>
+    {
+        std::vector<std::size_t> result;
+        overlapping(range, [&](std::size_t index) { result.push_back(index); });
+        return result;
+    }
+
+    // Number of intervals that contain `value`: those starting at or before it, minus those that also end at or before
+    // it.
+    auto count(T value) const -> std::size_t
+    {
+        const auto started = std::upper_bound(m_lower.begin(), m_lower.end(), value) - m_lower.begin();
+        const auto ended = std::upper_bound(m_sorted_upper.begin(), m_sorted_upper.end(), value) - m_sorted_upper.begin();
+        return static_cast<std::size_t>(started - ended);
+    }
+
+    // Number of intervals that overlap `range`: those starting before its end, minus those that end at or before its
+    // start.
+    auto count(const interval<T>& range) const -> std::size_t
+    {
+        if (!(lower(range) < upper(range)))
+        {
+            return 0;
+        }
+
+        const auto started = std::lower_bound(m_lower.begin(), m_lower.end(), upper(range)) - m_lower.begin();
+        const auto ended
+            = std::upper_bound(m_sorted_upper.begin(), m_sorted_upper.end(), lower(range)) - m_sorted_upper.begin();
+        return static_cast<std::size_t>(started - ended);
+    }
+
+private:
+    auto build(std::size_t first, std::size_t last) -> T
+    {
+        const std::size_t mid = first + (last - first) / 2;
+        T result = m_upper[mid];
+
+        if (first < mid)
+        {
+            result = std::max(result, build(first, mid));
+        }
+        if (mid + 1 < last)
+        {
+            result = std::max(result, build(mid + 1, last));
+        }
+
+        m_max_upper[mid] = result;
+        return result;
+    }
+
+    // Reports the intervals of the range that end after `value` and do not start too late. The lower bounds are
+    // sorted, so once the root starts too late, so does everything after it.
+    template <class StartsTooLate, class Func>
+    void search(std::size_t first, std::size_t last, T value, StartsTooLate&& starts_too_late, Func& func) const
+    {
+        while (first < last)
+        {
+            const std::size_t mid = first + (last - first) / 2;
+
+            if (m_max_upper[mid] <= value)
+            {
+                return;
+            }
+
+            search(first, mid, value, starts_too_late, func);
+
+            if (starts_too_late(m_lower[mid]))
+            {
+                return;
+            }
+
+            if (value < m_upper[mid])
+            {
+                func(std::size_t{ m_indices[mid] });
+            }
+
+            first = mid + 1;
+        }
+    }
+
+    std::vector<T> m_lower;
+    std::vector<T> m_upper;
+    std::vector<T> m_max_upper;  // largest upper bound of the range whose middle element is at this position
+    std::vector<T> m_sorted_upper;
+    std::vector<std::uint32_t> m_indices;
+};
+
+}  // namespace alg
+}  // namespace ferrugo
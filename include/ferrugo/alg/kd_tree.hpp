@@ -0,0 +1,364 @@
+#pragma once
+
+#include <ferrugo/alg/operations.hpp>
+#include <ferrugo/alg/span.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ferrugo
+{
+namespace alg
+{
+
+// Static k-d tree over a set of points, for nearest neighbor and radius queries.
+// The tree is implicit: the points are reordered so that the root of every range [first, last) is its middle element,
+// with the points before it on the lower side of the splitting plane and the points after it on the upper side. Only
+// the splitting axis of each root is stored; ranges of at most max_leaf_size points are not split and are scanned.
+// Distances are compared squared, using norm; the reported distances are the square roots of those.
+template <class T, std::size_t D>
+class kd_tree
+{
+public:
+    static_assert(std::is_floating_point_v<T>, "kd_tree: floating point coordinates expected");
+
+    struct neighbor
+    {
+        std::size_t index;
+        T distance;
+    };
+
+    static constexpr std::size_t max_leaf_size = 8;
+
+    kd_tree() = default;
+
+    explicit kd_tree(span<const vector<T, D>> points)
+    {
+        if (points.size() >= std::numeric_limits<std::uint32_t>::max())
+        {
+            throw std::runtime_error{ "kd_tree: too many points" };
+        }
+
+        std::vector<build_item> work(points.size());
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            work[i].point = points[i];
+            work[i].index = static_cast<std::uint32_t>(i);
+        }
+
+        m_axes.resize(points.size());
+        build(work.data(), 0, work.size());
+
+        m_points.reserve(work.size());
+        m_indices.reserve(work.size());
+        for (const auto& item : work)
+        {
+            m_points.push_back(item.point);
+            m_indices.push_back(item.index);
+        }
+    }
+
+    auto size() const -> std::size_t
+    {
+        return m_points.size();
+    }
+
+    auto empty() const -> bool
+    {
+        return m_points.empty();
+    }
+
+    auto nearest(const vector<T, D>& point) const -> neighbor
+    {
+        if (empty())
+        {
+            throw std::runtime_error{ "kd_tree: empty tree" };
+        }
+
+        nearest_visitor visitor{ m_points.size(), std::numeric_limits<T>::infinity() };
+        search(0, m_points.size(), point, visitor);
+        return neighbor{ m_indices[visitor.best], std::sqrt(visitor.bound) };
+    }
+
+    // The min(k, size()) points closest to `point`, nearest first.
+    auto k_nearest(const vector<T, D>& point, std::size_t k) const -> std::vector<neighbor>
+    {
+        std::vector<neighbor> result(std::min(k, size()));
+        std::vector<neighbor> heap;
+        k_nearest(point, result.size(), result.data(), heap);
+        return result;
+    }
+
+    // Calls func(index, distance) for each point within `radius` of `center`, in no particular order.
+    template <class Func>
+    void within_radius(const vector<T, D>& center, T radius, Func&& func) const
+    {
+        radius_visitor<Func> visitor{ sqr(radius), func, m_indices };
+        search(0, m_points.size(), center, visitor);
+    }
+
+    auto within_radius(const vector<T, D>& center, T radius) const -> std::vector<neighbor>
+    {
+        std::vector<neighbor> result;
+        within_radius(center, radius, [&](std::size_t index, T distance) { result.push_back(neighbor{ index, distance }); });
+        return result;
+    }
+
+    // nearest() for each of the queries, split over `threads` threads.
+    auto nearest_all(span<const vector<T, D>> queries, std::size_t threads = 1) const -> std::vector<neighbor>
+    {
+        if (empty() && !queries.empty())
+        {
+            throw std::runtime_error{ "kd_tree: empty tree" };
+        }
+
+        std::vector<neighbor> result(queries.size());
+        parallel_for(
+            queries.size(),
+            threads,
+            [&](std::size_t first, std::size_t last)
+            {
+                for (std::size_t i = first; i < last; ++i)
+                {
+                    result[i] = nearest(queries[i]);
+                }
+            });
+        return result;
+    }
+
+    // k_nearest() for each of the queries, split over `threads` threads. The neighbors of query i are the elements
+    // [i * m, (i + 1) * m) of the result, where m = min(k, size()).
+    auto k_nearest_all(span<const vector<T, D>> queries, std::size_t k, std::size_t threads = 1) const
+        -> std::vector<neighbor>
+    {
+        const std::size_t count = std::min(k, size());
+        std::vector<neighbor> result(queries.size() * count);
+        parallel_for(
+            queries.size(),
+            threads,
+            [&](std::size_t first, std::size_t last)
+            {
+                std::vector<neighbor> heap;
+                for (std::size_t i = first; i < last; ++i)
+                {
+                    k_nearest(queries[i], count, result.data() + i * count, heap);
+                }
+            });
+        return result;
+    }
+
+private:
+    // Queries are handed out to the threads in chunks of this size.
+    static constexpr std::size_t chunk_size = 256;
+
+    struct build_item
+    {
+        vector<T, D> point;
+        std::uint32_t index;
+    };
+
+    struct nearest_visitor
+    {
+        std::size_t best;
+        T bound;
+
+        void operator()(std::size_t i, T squared_distance)
+        {
+            if (squared_distance < bound)
+            {
+                best = i;
+                bound = squared_distance;
+            }
+        }
+    };
+
+    // Max-heap of the k nearest squared distances found so far, ordered by distance.
+    struct k_nearest_visitor
+    {
+        std::vector<neighbor>& heap;
+        std::size_t k;
+        T bound;
+
+        static auto less(const neighbor& lhs, const neighbor& rhs) -> bool
+        {
+            return lhs.distance < rhs.distance;
+        }
+
+        void operator()(std::size_t i, T squared_distance)
+        {
+            if (heap.size() < k)
+            {
+                heap.push_back(neighbor{ i, squared_distance });
+                std::push_heap(heap.begin(), heap.end(), &less);
+                if (heap.size() == k)
+                {
+                    bound = heap.front().distance;
+                }
+            }
+            else if (squared_distance < bound)
+            {
+                std::pop_heap(heap.begin(), heap.end(), &less);
+                heap.back() = neighbor{ i, squared_distance };
+                std::push_heap(heap.begin(), heap.end(), &less);
+                bound = heap.front().distance;
+            }
+        }
+    };
+
+    template <class Func>
+    struct radius_visitor
+    {
+        T bound;
+        Func& func;
+        const std::vector<std::uint32_t>& indices;
+
+        void operator()(std::size_t i, T squared_distance)
+        {
+            if (squared_distance <= bound)
+            {
+                func(std::size_t{ indices[i] }, std::sqrt(squared_distance));
+            }
+        }
+    };
+
+    void build(build_item* items, std::size_t first, std::size_t last)
+    {
+        if (last - first <= max_leaf_size)
+        {
+            return;
+        }
+
+        // Split the widest axis of the range at its median.
+        vector<T, D> lo = items[first].point;
+        vector<T, D> up = items[first].point;
+        for (std::size_t i = first + 1; i < last; ++i)
+        {
+            for (std::size_t d = 0; d < D; ++d)
+            {
+                lo[d] = std::min(lo[d], items[i].point[d]);
+                up[d] = std::max(up[d], items[i].point[d]);
+            }
+        }
+
+        std::size_t axis = 0;
+        for (std::size_t d = 1; d < D; ++d)
+        {
+            if (up[d] - lo[d] > up[axis] - lo[axis])
+            {
+                axis = d;
+            }
+        }
+
+        const std::size_t mid = first + (last - first) / 2;
+        std::nth_element(
+            items + first,
+            items + mid,
+            items + last,
+            [&](const build_item& lhs, const build_item& rhs) { return lhs.point[axis] < rhs.point[axis]; });
+
+        m_axes[mid] = static_cast<std::uint8_t>(axis);
+        build(items, first, mid);
+        build(items, mid + 1, last);
+    }
+
+    // Calls visitor(i, squared distance) for the points of the range that may lie within visitor.bound, which the
+    // visitor may shrink as it goes. The side of the splitting plane that contains `point` is searched first.
+    template <class Visitor>
+    void search(std::size_t first, std::size_t last, const vector<T, D>& point, Visitor& visitor) const
+    {
+        if (last - first <= max_leaf_size)
+        {
+            for (std::size_t i = first; i < last; ++i)
+            {
+                visitor(i, norm(m_points[i] - point));
+            }
+            return;
+        }
+
+        const std::size_t mid = first + (last - first) / 2;
+        const std::size_t axis = m_axes[mid];
+        const T difference = point[axis] - m_points[mid][axis];
+
+        visitor(mid, norm(m_points[mid] - point));
+
+        if (difference < T(0))
+        {
+            search(first, mid, point, visitor);
+            if (sqr(difference) <= visitor.bound)
+            {
+                search(mid + 1, last, point, visitor);
+            }
+        }
+        else
+        {
+            search(mid + 1, last, point, visitor);
+            if (sqr(difference) <= visitor.bound)
+            {
+                search(first, mid, point, visitor);
+            }
+        }
+    }
+
+    void k_nearest(const vector<T, D>& point, std::size_t k, neighbor* out, std::vector<neighbor>& heap) const
+    {
+        if (k == 0)
+        {
+            return;
+        }
+
+        heap.clear();
+        k_nearest_visitor visitor{ heap, k, std::numeric_limits<T>::infinity() };
+        search(0, m_points.size(), point, visitor);
+
+        std::sort_heap(heap.begin(), heap.end(), &k_nearest_visitor::less);
+        for (std::size_t i = 0; i < k; ++i)
+        {
+            out[i] = neighbor{ m_indices[heap[i].index], std::sqrt(heap[i].distance) };
+        }
+    }
+
+    template <class Func>
+    static void parallel_for(std::size_t count, std::size_t threads, Func&& func)
+    {
+        const std::size_t chunks = (count + chunk_size - 1) / chunk_size;
+
+        std::atomic<std::size_t> next_chunk{ 0 };
+        const auto worker = [&]()
+        {
+            for (std::size_t c = next_chunk++; c < chunks; c = next_chunk++)
+            {
+                func(c * chunk_size, std::min(count, (c + 1) * chunk_size));
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (std::size_t i = 1; i < std::min(threads, chunks); ++i)
+        {
+            workers.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : workers)
+        {
+            thread.join();
+        }
+    }
+
+    std::vector<vector<T, D>> m_points;
+    std::vector<std::uint32_t> m_indices;
+    std::vector<std::uint8_t> m_axes;  // splitting axis of the range whose middle element is at this position
+};
+
+template <class T>
+using kd_tree_2d = kd_tree<T, 2>;
+
+template <class T>
+using kd_tree_3d = kd_tree<T, 3>;
+
+}  // namespace alg
+}  // namespace ferrugo
@@ -0,0 +1,559 @@
+#pragma once
+
+#include <ferrugo/alg/linear_shapes.hpp>
+#include <ferrugo/alg/operations.hpp>
+#include <ferrugo/alg/region.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <type_traits>
+
+namespace ferrugo
+{
+namespace alg
+{
+
+// Orders of the cells of a region: dimension 0 varying fastest, like the rows of an image, or along the Morton
+// (Z-order) curve, which keeps cells close in the order close in space.
+struct row_major_tag
+{
+};
+
+struct morton_tag
+{
+};
+
+// The end of the lattice ranges below; their iterators know when they are done.
+struct lattice_sentinel
+{
+};
+
+// The cells of an integer region, lo <= cell < up along each dimension as for contains(region, vector), in row-major
+// order. Lazy: the range holds only the bounds and its iterator only the current cell. It is not free: the single loop
+// costs about 1.5 times the nested loops it replaces in bench/lattice.bench.cpp (0.97 against 0.63 ns per cell). Only
+// row_major_rows matches handwritten loops, hot loops over the cells of large regions should use it instead.
+template <class T, std::size_t D>
+class row_major_cells
+{
+public:
+    static_assert(std::is_integral_v<T>, "cells: integer coordinates expected");
+
+    class iterator
+    {
+    public:
+        iterator(const vector<T, D>& lower, const vector<T, D>& upper) : m_value(lower), m_lower(lower), m_upper(upper)
+        {
+            for (std::size_t d = 0; d < D; ++d)
+            {
+                if (!(lower[d] < upper[d]))
+                {
+                    m_value[0] = m_upper[0];
+                }
+            }
+        }
+
+        auto operator*() const -> const vector<T, D>&
+        {
+            return m_value;
+        }
+
+        // The end is marked by dimension 0 staying at its upper bound, so that in a loop the test against the
+        // sentinel repeats the one made here and is dropped by the compiler, as in a handwritten innermost loop.
+        auto operator++() -> iterator&
+        {
+            if (++m_value[0] == m_upper[0])
+            {
+                next_row();
+            }
+            return *this;
+        }
+
+        friend auto operator!=(const iterator& lhs, lattice_sentinel) -> bool
+        {
+            return lhs.m_value[0] != lhs.m_upper[0];
+        }
+
+        friend auto operator==(const iterator& lhs, lattice_sentinel rhs) -> bool
+        {
+            return !(lhs != rhs);
+        }
+
+    private:
+        void next_row()
+        {
+            for (std::size_t d = 1; d < D; ++d)
+            {
+                if (++m_value[d] != m_upper[d])
+                {
+                    for (std::size_t k = 0; k < d; ++k)
+                    {
+                        m_value[k] = m_lower[k];
+                    }
+                    return;
+                }
+                m_value[d] = m_lower[d];
+            }
+        }
+
+        vector<T, D> m_value;
+        vector<T, D> m_lower;
+        vector<T, D> m_upper;
+    };
+
+    explicit row_major_cells(const region<T, D>& item) : m_lower(min(item)), m_upper{}
+    {
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            m_upper[d] = upper(item[d]);
+        }
+    }
+
+    auto begin() const -> iterator
+    {
+        return iterator{ m_lower, m_upper };
+    }
+
+    auto end() const -> lattice_sentinel
+    {
+        return {};
+    }
+
+    auto size() const -> std::size_t
+    {
+        std::size_t result = 1;
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            result *= m_lower[d] < m_upper[d] ? static_cast<std::size_t>(m_upper[d] - m_lower[d]) : 0;
+        }
+        return result;
+    }
+
+    auto empty() const -> bool
+    {
+        return size() == 0;
+    }
+
+private:
+    vector<T, D> m_lower;
+    vector<T, D> m_upper;
+};
+
+// A row of cells along dimension 0: first, first + (1, 0, ...), ... up to, not including, the coordinate upper.
+template <class T, std::size_t D>
+struct lattice_row
+{
+    vector<T, D> first;
+    T upper;
+
+    auto size() const -> std::size_t
+    {
+        return static_cast<std::size_t>(upper - first[0]);
+    }
+};
+
+// The rows of an integer region in the order of row_major_cells. A loop over the coordinates of each row is the
+// innermost loop of a handwritten traversal, with the other coordinates invariant in it; the compiler cannot see that
+// through the single loop over row_major_cells. In bench/lattice.bench.cpp it costs the same as the nested loops (0.57
+// against 0.63 ns per cell).
+template <class T, std::size_t D>
+class row_major_rows
+{
+public:
+    static_assert(std::is_integral_v<T>, "rows: integer coordinates expected");
+
+    // Walks the cells of the region with dimension 0 reduced to its first coordinate.
+    class iterator
+    {
+    public:
+        iterator(const typename row_major_cells<T, D>::iterator& cell, T upper) : m_cell(cell), m_upper(upper)
+        {
+        }
+
+        auto operator*() const -> lattice_row<T, D>
+        {
+            return lattice_row<T, D>{ *m_cell, m_upper };
+        }
+
+        auto operator++() -> iterator&
+        {
+            ++m_cell;
+            return *this;
+        }
+
+        friend auto operator!=(const iterator& lhs, lattice_sentinel rhs) -> bool
+        {
+            return lhs.m_cell != rhs;
+        }
+
+        friend auto operator==(const iterator& lhs, lattice_sentinel rhs) -> bool
+        {
+            return !(lhs != rhs);
+        }
+
+    private:
+        typename row_major_cells<T, D>::iterator m_cell;
+        T m_upper;
+    };
+
+    explicit row_major_rows(const region<T, D>& item) : m_starts(item), m_upper(upper(item[0]))
+    {
+        const T lo = lower(item[0]);
+        m_starts[0] = interval<T>{ lo, lo < m_upper ? static_cast<T>(lo + 1) : lo };
+    }
+
+    auto begin() const -> iterator
+    {
+        return iterator{ row_major_cells<T, D>{ m_starts }.begin(), m_upper };
+    }
+
+    auto end() const -> lattice_sentinel
+    {
+        return {};
+    }
+
+    auto size() const -> std::size_t
+    {
+        return row_major_cells<T, D>{ m_starts }.size();
+    }
+
+    auto empty() const -> bool
+    {
+        return size() == 0;
+    }
+
+private:
+    region<T, D> m_starts;
+    T m_upper;
+};
+
+// The cells of an integer region in Morton order of their offsets from its lower corner. The region is split
+// recursively into aligned blocks of 2^level cells per side, whose cells have consecutive Morton codes; blocks within
+// the region are walked by incrementing the code, the others are split further or skipped. The pending blocks are kept
+// in a fixed-size stack inside the iterator. The extents of the region are limited to 2^(63 / D) cells.
+template <class T, std::size_t D>
+class morton_cells
+{
+public:
+    static_assert(std::is_integral_v<T>, "cells: integer coordinates expected");
+
+    static constexpr std::size_t max_levels = 63 / D;
+
+    class iterator
+    {
+    public:
+        iterator(const vector<T, D>& lower, const std::array<std::uint64_t, D>& extents)
+            : m_lower(lower), m_extents(extents)
+        {
+            if (std::find(extents.begin(), extents.end(), 0) != extents.end())
+            {
+                m_done = true;
+                return;
+            }
+
+            const std::uint64_t largest = *std::max_element(extents.begin(), extents.end());
+
+            std::size_t levels = 0;
+            while ((std::uint64_t(1) << levels) < largest)
+            {
+                ++levels;
+            }
+            m_stack[m_stack_size++] = block{ 0, levels };
+            next_run();
+        }
+
+        auto operator*() const -> const vector<T, D>&
+        {
+            return m_value;
+        }
+
+        // Incrementing the code sets its lowest zero bit t and resets the bits below it, which are the lowest
+        // ceil((t - d) / D) bits of the offset along each dimension d; bit t itself is bit t / D of dimension t % D.
+        auto operator++() -> iterator&
+        {
+            if (++m_code == m_run_end)
+            {
+                next_run();
+                return *this;
+            }
+
+            const std::size_t t = detail::count_trailing_zeros(m_code);
+            for (std::size_t d = 0; d < D && d < t; ++d)
+            {
+                const std::size_t below = (t - d + D - 1) / D;
+                m_offset[d] &= ~((std::uint64_t(1) << below) - 1);
+            }
+            m_offset[t % D] |= std::uint64_t(1) << (t / D);
+            update_value();
+            return *this;
+        }
+
+        friend auto operator!=(const iterator& lhs, lattice_sentinel) -> bool
+        {
+            return !lhs.m_done;
+        }
+
+        friend auto operator==(const iterator& lhs, lattice_sentinel rhs) -> bool
+        {
+            return !(lhs != rhs);
+        }
+
+    private:
+        struct block
+        {
+            std::uint64_t code;
+            std::size_t level;
+        };
+
+        static constexpr std::size_t children = std::size_t(1) << D;
+
+        void update_value()
+        {
+            for (std::size_t d = 0; d < D; ++d)
+            {
+                m_value[d] = static_cast<T>(m_lower[d] + static_cast<T>(m_offset[d]));
+            }
+        }
+
+        // Pops blocks until one lies within the region and starts walking it.
+        void next_run()
+        {
+            while (m_stack_size != 0)
+            {
+                const block item = m_stack[--m_stack_size];
+
+                std::array<std::uint64_t, D> origin{};
+                for (std::size_t bit = 0; bit < D * max_levels; ++bit)
+                {
+                    origin[bit % D] |= ((item.code >> bit) & 1) << (bit / D);
+                }
+
+                const std::uint64_t side = std::uint64_t(1) << item.level;
+                bool outside = false;
+                bool inside = true;
+                for (std::size_t d = 0; d < D; ++d)
+                {
+                    outside = outside || m_extents[d] <= origin[d];
+                    inside = inside && origin[d] + side <= m_extents[d];
+                }
+
+                if (outside)
+                {
+                    continue;
+                }
+
+                if (inside)
+                {
+                    m_code = item.code;
+                    m_run_end = item.code + (std::uint64_t(1) << (item.level * D));
+                    m_offset = origin;
+                    update_value();
+                    return;
+                }
+
+                const std::uint64_t child_span = std::uint64_t(1) << ((item.level - 1) * D);
+                for (std::size_t k = children; k-- > 0;)
+                {
+                    m_stack[m_stack_size++] = block{ item.code + k * child_span, item.level - 1 };
+                }
+            }
+            m_done = true;
+        }
+
+        vector<T, D> m_value;
+        vector<T, D> m_lower;
+        std::array<std::uint64_t, D> m_extents;
+        std::array<std::uint64_t, D> m_offset{};
+        std::uint64_t m_code = 0;
+        std::uint64_t m_run_end = 0;
+        std::array<block, (children - 1) * max_levels + 1> m_stack;
+        std::size_t m_stack_size = 0;
+        bool m_done = false;
+    };
+
+    explicit morton_cells(const region<T, D>& item) : m_lower(min(item)), m_extents{}
+    {
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            const T lo = lower(item[d]);
+            const T up = upper(item[d]);
+            m_extents[d] = lo < up ? static_cast<std::uint64_t>(static_cast<std::int64_t>(up) - lo) : 0;
+            if (m_extents[d] > (std::uint64_t(1) << max_levels))
+            {
+                throw std::runtime_error{ "cells: region too large for Morton order" };
+            }
+        }
+    }
+
+    auto begin() const -> iterator
+    {
+        return iterator{ m_lower, m_extents };
+    }
+
+    auto end() const -> lattice_sentinel
+    {
+        return {};
+    }
+
+    auto size() const -> std::size_t
+    {
+        std::size_t result = 1;
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            result *= static_cast<std::size_t>(m_extents[d]);
+        }
+        return result;
+    }
+
+    auto empty() const -> bool
+    {
+        return size() == 0;
+    }
+
+private:
+    vector<T, D> m_lower;
+    std::array<std::uint64_t, D> m_extents;
+};
+
+// The cells of the Bresenham line between the endpoints of an integer segment, both of them included, from the first
+// one to the second; max(|dx|, |dy|) + 1 cells, with one cell per step along the major axis. In bench/lattice.bench.cpp
+// it costs the same as a handwritten Bresenham loop (2.13 against 2.33 ns per cell).
+template <class T>
+class raster_range
+{
+public:
+    static_assert(std::is_integral_v<T>, "raster: integer coordinates expected");
+
+    class iterator
+    {
+    public:
+        explicit iterator(const segment_2d<T>& item)
+            : m_value(item[0])
+            , m_dx(std::abs(item[1][0] - item[0][0]))
+            , m_dy(-std::abs(item[1][1] - item[0][1]))
+            , m_sx(item[0][0] < item[1][0] ? 1 : -1)
+            , m_sy(item[0][1] < item[1][1] ? 1 : -1)
+            , m_error(m_dx + m_dy)
+            , m_remaining(static_cast<std::size_t>(std::max(m_dx, -m_dy)) + 1)
+        {
+        }
+
+        auto operator*() const -> const vector_2d<T>&
+        {
+            return m_value;
+        }
+
+        auto operator++() -> iterator&
+        {
+            const T twice = 2 * m_error;
+            if (twice >= m_dy)
+            {
+                m_error += m_dy;
+                m_value[0] += m_sx;
+            }
+            if (twice <= m_dx)
+            {
+                m_error += m_dx;
+                m_value[1] += m_sy;
+            }
+            --m_remaining;
+            return *this;
+        }
+
+        friend auto operator!=(const iterator& lhs, lattice_sentinel) -> bool
+        {
+            return lhs.m_remaining != 0;
+        }
+
+        friend auto operator==(const iterator& lhs, lattice_sentinel rhs) -> bool
+        {
+            return !(lhs != rhs);
+        }
+
+    private:
+        vector_2d<T> m_value;
+        T m_dx;
+        T m_dy;
+        T m_sx;
+        T m_sy;
+        T m_error;
+        std::size_t m_remaining;
+    };
+
+    explicit raster_range(const segment_2d<T>& item) : m_segment(item)
+    {
+    }
+
+    auto begin() const -> iterator
+    {
+        return iterator{ m_segment };
+    }
+
+    auto end() const -> lattice_sentinel
+    {
+        return {};
+    }
+
+    auto size() const -> std::size_t
+    {
+        return static_cast<std::size_t>(
+                   std::max(std::abs(m_segment[1][0] - m_segment[0][0]), std::abs(m_segment[1][1] - m_segment[0][1])))
+               + 1;
+    }
+
+private:
+    segment_2d<T> m_segment;
+};
+
+namespace detail
+{
+
+struct cells_fn
+{
+    template <class T, std::size_t D>
+    auto operator()(const region<T, D>& item, row_major_tag = {}) const -> row_major_cells<T, D>
+    {
+        return row_major_cells<T, D>{ item };
+    }
+
+    template <class T, std::size_t D>
+    auto operator()(const region<T, D>& item, morton_tag) const -> morton_cells<T, D>
+    {
+        return morton_cells<T, D>{ item };
+    }
+};
+
+static constexpr inline auto cells = cells_fn{};
+
+struct rows_fn
+{
+    template <class T, std::size_t D>
+    auto operator()(const region<T, D>& item) const -> row_major_rows<T, D>
+    {
+        return row_major_rows<T, D>{ item };
+    }
+};
+
+static constexpr inline auto rows = rows_fn{};
+
+struct raster_fn
+{
+    template <class T>
+    auto operator()(const segment_2d<T>& item) const -> raster_range<T>
+    {
+        return raster_range<T>{ item };
+    }
+};
+
+static constexpr inline auto raster = raster_fn{};
+
+}  // namespace detail
+
+using detail::cells;
+using detail::raster;
+using detail::rows;
+
+}  // namespace alg
+}  // namespace ferrugo
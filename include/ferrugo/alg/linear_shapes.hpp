@@ -40,6 +40,8 @@ using ray = detail::linear_shape<detail::ray_tag, T, D>;
 template <class T, std::size_t D>
 using segment = detail::linear_shape<detail::segment_tag, T, D>;
 
+static_assert(std::is_trivially_copyable_v<segment<float, 2>> && std::is_standard_layout_v<segment<float, 2>>);
+
 template <class T, std::size_t D>
 std::ostream& operator<<(std::ostream& os, const line<T, D>& item)
 {
@@ -112,6 +114,29 @@ auto operator*(const square_matrix<U, D + 1>& lhs, const linear_shape<Tag, T, D>
     return rhs * lhs;
 }
 
+template <class Tag, class T, class U, std::size_t D>
+auto operator*=(linear_shape<Tag, T, D>& lhs, const affine_transform<U, D>& rhs) -> linear_shape<Tag, T, D>&
+{
+    std::transform(
+        std::begin(lhs), std::end(lhs), std::begin(lhs), std::bind(std::multiplies<>{}, std::placeholders::_1, rhs));
+    return lhs;
+}
+
+template <class Tag, class T, class U, std::size_t D, class Res = std::invoke_result_t<std::multiplies<>, T, U>>
+auto operator*(const linear_shape<Tag, T, D>& lhs, const affine_transform<U, D>& rhs) -> linear_shape<Tag, Res, D>
+{
+    linear_shape<Tag, Res, D> result{};
+    std::transform(
+        std::begin(lhs), std::end(lhs), std::begin(result), std::bind(std::multiplies<>{}, std::placeholders::_1, rhs));
+    return result;
+}
+
+template <class Tag, class T, class U, std::size_t D, class Res = std::invoke_result_t<std::multiplies<>, T, U>>
+auto operator*(const affine_transform<U, D>& lhs, const linear_shape<Tag, T, D>& rhs) -> linear_shape<Tag, Res, D>
+{
+    return rhs * lhs;
+}
+
 }  // namespace detail
 
 using detail::line;
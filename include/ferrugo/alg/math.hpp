@@ -1,7 +1,16 @@
 #pragma once
 
+#include <ferrugo/alg/matrix/matrix.simd.hpp>
+#include <ferrugo/alg/span.hpp>
+#include <array>
 #include <cmath>
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace ferrugo
 {
@@ -119,8 +128,673 @@ struct acos_fn
     }
 };
 
+struct sincos_fn
+{
+    // (sin(x), cos(x)); compilers merge the two calls into one to sincos where the C library has it.
+    template <class T>
+    auto operator()(T x) const -> std::pair<decltype(std::sin(x)), decltype(std::cos(x))>
+    {
+        return { std::sin(x), std::cos(x) };
+    }
+};
+
+// Constants of the fast approximations, after Cephes. sin and cos reduce their argument to r = x - k * pi/2,
+// |r| <= pi/4, with pi/2 split into three parts whose first products with k are exact (Cody-Waite), and evaluate
+// minimax polynomials in r^2. Arguments with |x * 2/pi| beyond quadrant_limit are replaced by NaN. The arctangent of
+// a = min(|x|, |y|) / max(|x|, |y|) is reduced once more to (a - 1) / (a + 1) above atan_threshold.
+template <class T>
+struct fast_math_constants;
+
+template <>
+struct fast_math_constants<float>
+{
+    static constexpr float pi = 3.14159265358979323846F;
+    static constexpr float half_pi = 1.57079632679489661923F;
+    static constexpr float quarter_pi = 0.785398163397448309616F;
+    static constexpr float quarter_pi_low = -2.18556941e-8F;
+    static constexpr float two_over_pi = 0.636619772367581343076F;
+    static constexpr float quadrant_limit = 1073741824.F;
+    static constexpr std::array<float, 3> half_pi_parts = {
+        1.5703125F, 4.837512969970703125e-4F, 7.54978995489188216e-8F
+    };
+    static constexpr std::array<float, 3> sin = { -1.9515295891e-4F, 8.3321608736e-3F, -1.6666654611e-1F };
+    static constexpr std::array<float, 3> cos = {
+        2.443315711809948e-5F, -1.388731625493765e-3F, 4.166664568298827e-2F
+    };
+    static constexpr float atan_threshold = 0.414213562373095049F;
+    static constexpr std::array<float, 4> atan = {
+        8.05374449538e-2F, -1.38776856032e-1F, 1.99777106478e-1F, -3.33329491539e-1F
+    };
+};
+
+template <>
+struct fast_math_constants<double>
+{
+    static constexpr double pi = 3.14159265358979323846;
+    static constexpr double half_pi = 1.57079632679489661923;
+    static constexpr double quarter_pi = 0.785398163397448309616;
+    static constexpr double quarter_pi_low = 3.061616997868382943065e-17;
+    static constexpr double two_over_pi = 0.636619772367581343076;
+    static constexpr double quadrant_limit = 1073741824.0;
+    static constexpr std::array<double, 3> half_pi_parts = {
+        1.57079625129699707031, 7.54978941586159635336e-8, 5.39030285815811905290e-15
+    };
+    static constexpr std::array<double, 6> sin = {
+        1.58962301576546568060e-10, -2.50507477628578072866e-8, 2.75573136213857245213e-6,
+        -1.98412698295895385996e-4, 8.33333333332211858878e-3,  -1.66666666666666307295e-1,
+    };
+    static constexpr std::array<double, 6> cos = {
+        -1.13585365213876817300e-11, 2.08757008419747316778e-9,  -2.75573141792967388112e-7,
+        2.48015872888517045348e-5,   -1.38888888888730564116e-3, 4.16666666666665929218e-2,
+    };
+    static constexpr double atan_threshold = 0.66;
+    static constexpr std::array<double, 5> atan_numerator = {
+        -8.750608600031904122785e-1, -1.615753718733365076637e1, -7.500855792314704667340e1,
+        -1.228866684490136173410e2,  -6.485021904942025371773e1,
+    };
+    static constexpr std::array<double, 6> atan_denominator = {
+        1.0, 2.485846490142306297962e1, 1.650270098316988542046e2, 4.328810604912902668951e2, 4.853903996359136964868e2,
+        1.945506571482613964425e2,
+    };
+};
+
+template <class T, std::size_t N>
+auto horner(T x, const std::array<T, N>& coefficients) -> T
+{
+    T result = coefficients[0];
+    for (std::size_t i = 1; i < N; ++i)
+    {
+        result = result * x + coefficients[i];
+    }
+    return result;
+}
+
+namespace simd
+{
+
+#if FERRUGO_ALG_SIMD
+
+// The kernels of the fast functions, four floats or two doubles at a time. The scalar versions below, used without
+// SIMD, follow them operation by operation.
+
+template <std::size_t N>
+inline auto horner(__m128 x, const std::array<float, N>& coefficients) -> __m128
+{
+    __m128 result = _mm_set1_ps(coefficients[0]);
+    for (std::size_t i = 1; i < N; ++i)
+    {
+        result = madd(result, x, _mm_set1_ps(coefficients[i]));
+    }
+    return result;
+}
+
+template <std::size_t N>
+inline auto horner(__m128d x, const std::array<double, N>& coefficients) -> __m128d
+{
+    __m128d result = _mm_set1_pd(coefficients[0]);
+    for (std::size_t i = 1; i < N; ++i)
+    {
+        result = madd(result, x, _mm_set1_pd(coefficients[i]));
+    }
+    return result;
+}
+
+inline auto select(__m128 mask, __m128 lhs, __m128 rhs) -> __m128
+{
+    return _mm_or_ps(_mm_and_ps(mask, lhs), _mm_andnot_ps(mask, rhs));
+}
+
+inline auto select(__m128d mask, __m128d lhs, __m128d rhs) -> __m128d
+{
+    return _mm_or_pd(_mm_and_pd(mask, lhs), _mm_andnot_pd(mask, rhs));
+}
+
+inline void fast_sincos(__m128 x, __m128& sin_x, __m128& cos_x)
+{
+    using constants = fast_math_constants<float>;
+
+    const __m128 sign_bit = _mm_set1_ps(-0.F);
+    const __m128 t = _mm_mul_ps(x, _mm_set1_ps(constants::two_over_pi));
+    const __m128 in_range = _mm_cmplt_ps(_mm_andnot_ps(sign_bit, t), _mm_set1_ps(constants::quadrant_limit));
+    const __m128 half = _mm_or_ps(_mm_set1_ps(0.5F), _mm_and_ps(sign_bit, t));
+    const __m128i q = _mm_cvttps_epi32(_mm_and_ps(in_range, _mm_add_ps(t, half)));
+    const __m128 k = _mm_cvtepi32_ps(q);
+
+    __m128 r = _mm_sub_ps(x, _mm_mul_ps(k, _mm_set1_ps(constants::half_pi_parts[0])));
+    r = _mm_sub_ps(r, _mm_mul_ps(k, _mm_set1_ps(constants::half_pi_parts[1])));
+    r = _mm_sub_ps(r, _mm_mul_ps(k, _mm_set1_ps(constants::half_pi_parts[2])));
+    r = _mm_or_ps(r, _mm_andnot_ps(in_range, _mm_castsi128_ps(_mm_set1_epi32(-1))));
+    const __m128 z = _mm_mul_ps(r, r);
+    const __m128 s = madd(_mm_mul_ps(r, z), horner(z, constants::sin), r);
+    const __m128 c = _mm_add_ps(
+        _mm_sub_ps(_mm_mul_ps(_mm_mul_ps(z, z), horner(z, constants::cos)), _mm_mul_ps(_mm_set1_ps(0.5F), z)),
+        _mm_set1_ps(1.F));
+
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i two = _mm_set1_epi32(2);
+    const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, one), one));
+    const __m128 sin_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(q, two), 30));
+    const __m128 cos_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(q, one), two), 30));
+    sin_x = _mm_xor_ps(select(swap, c, s), sin_sign);
+    cos_x = _mm_xor_ps(select(swap, s, c), cos_sign);
+}
+
+inline void fast_sincos(__m128d x, __m128d& sin_x, __m128d& cos_x)
+{
+    using constants = fast_math_constants<double>;
+
+    const __m128d sign_bit = _mm_set1_pd(-0.0);
+    const __m128d t = _mm_mul_pd(x, _mm_set1_pd(constants::two_over_pi));
+    const __m128d in_range = _mm_cmplt_pd(_mm_andnot_pd(sign_bit, t), _mm_set1_pd(constants::quadrant_limit));
+    const __m128d half = _mm_or_pd(_mm_set1_pd(0.5), _mm_and_pd(sign_bit, t));
+    const __m128i q = _mm_cvttpd_epi32(_mm_and_pd(in_range, _mm_add_pd(t, half)));
+    const __m128d k = _mm_cvtepi32_pd(q);
+
+    __m128d r = _mm_sub_pd(x, _mm_mul_pd(k, _mm_set1_pd(constants::half_pi_parts[0])));
+    r = _mm_sub_pd(r, _mm_mul_pd(k, _mm_set1_pd(constants::half_pi_parts[1])));
+    r = _mm_sub_pd(r, _mm_mul_pd(k, _mm_set1_pd(constants::half_pi_parts[2])));
+    r = _mm_or_pd(r, _mm_andnot_pd(in_range, _mm_castsi128_pd(_mm_set1_epi32(-1))));
+    const __m128d z = _mm_mul_pd(r, r);
+    const __m128d s = madd(_mm_mul_pd(r, z), horner(z, constants::sin), r);
+    const __m128d c = _mm_add_pd(
+        _mm_sub_pd(_mm_mul_pd(_mm_mul_pd(z, z), horner(z, constants::cos)), _mm_mul_pd(_mm_set1_pd(0.5), z)),
+        _mm_set1_pd(1.0));
+
+    // Each quadrant in both halves of its 64-bit lane, so that the masks and the sign bits come out 64 bits wide.
+    const __m128i wide_q = _mm_shuffle_epi32(q, _MM_SHUFFLE(1, 1, 0, 0));
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i two = _mm_set1_epi64x(2);
+    const __m128d swap = _mm_castsi128_pd(_mm_cmpeq_epi32(_mm_and_si128(wide_q, one), one));
+    const __m128d sin_sign = _mm_castsi128_pd(_mm_slli_epi64(_mm_and_si128(wide_q, two), 62));
+    const __m128d cos_sign = _mm_castsi128_pd(_mm_slli_epi64(_mm_and_si128(_mm_add_epi32(wide_q, one), two), 62));
+    sin_x = _mm_xor_pd(select(swap, c, s), sin_sign);
+    cos_x = _mm_xor_pd(select(swap, s, c), cos_sign);
+}
+
+inline auto fast_atan2(__m128 y, __m128 x) -> __m128
+{
+    using constants = fast_math_constants<float>;
+
+    const __m128 sign_bit = _mm_set1_ps(-0.F);
+    const __m128 one = _mm_set1_ps(1.F);
+    const __m128 ax = _mm_andnot_ps(sign_bit, x);
+    const __m128 ay = _mm_andnot_ps(sign_bit, y);
+    const __m128 large = _mm_max_ps(ax, ay);
+    const __m128 small = _mm_min_ps(ax, ay);
+    const __m128 a = _mm_div_ps(small, select(_mm_cmpeq_ps(large, _mm_setzero_ps()), one, large));
+    const __m128 reduced = _mm_cmplt_ps(_mm_set1_ps(constants::atan_threshold), a);
+    const __m128 t = select(reduced, _mm_div_ps(_mm_sub_ps(a, one), _mm_add_ps(a, one)), a);
+    const __m128 z = _mm_mul_ps(t, t);
+
+    __m128 r = madd(_mm_mul_ps(t, z), horner(z, constants::atan), t);
+    r = select(
+        reduced,
+        _mm_add_ps(_mm_set1_ps(constants::quarter_pi), _mm_add_ps(r, _mm_set1_ps(constants::quarter_pi_low))),
+        r);
+    r = select(_mm_cmplt_ps(ax, ay), _mm_sub_ps(_mm_set1_ps(constants::half_pi), r), r);
+    r = select(_mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(x), 31)), _mm_sub_ps(_mm_set1_ps(constants::pi), r), r);
+    r = _mm_or_ps(r, _mm_and_ps(sign_bit, y));
+    return select(_mm_cmpunord_ps(x, y), _mm_add_ps(x, y), r);
+}
+
+inline auto fast_atan2(__m128d y, __m128d x) -> __m128d
+{
+    using constants = fast_math_constants<double>;
+
+    const __m128d sign_bit = _mm_set1_pd(-0.0);
+    const __m128d one = _mm_set1_pd(1.0);
+    const __m128d ax = _mm_andnot_pd(sign_bit, x);
+    const __m128d ay = _mm_andnot_pd(sign_bit, y);
+    const __m128d large = _mm_max_pd(ax, ay);
+    const __m128d small = _mm_min_pd(ax, ay);
+    const __m128d a = _mm_div_pd(small, select(_mm_cmpeq_pd(large, _mm_setzero_pd()), one, large));
+    const __m128d reduced = _mm_cmplt_pd(_mm_set1_pd(constants::atan_threshold), a);
+    const __m128d t = select(reduced, _mm_div_pd(_mm_sub_pd(a, one), _mm_add_pd(a, one)), a);
+    const __m128d z = _mm_mul_pd(t, t);
+
+    const __m128d ratio = _mm_div_pd(horner(z, constants::atan_numerator), horner(z, constants::atan_denominator));
+    __m128d r = madd(_mm_mul_pd(t, z), ratio, t);
+    r = select(
+        reduced,
+        _mm_add_pd(_mm_set1_pd(constants::quarter_pi), _mm_add_pd(r, _mm_set1_pd(constants::quarter_pi_low))),
+        r);
+    r = select(_mm_cmplt_pd(ax, ay), _mm_sub_pd(_mm_set1_pd(constants::half_pi), r), r);
+    const __m128i x_sign = _mm_shuffle_epi32(_mm_srai_epi32(_mm_castpd_si128(x), 31), _MM_SHUFFLE(3, 3, 1, 1));
+    r = select(_mm_castsi128_pd(x_sign), _mm_sub_pd(_mm_set1_pd(constants::pi), r), r);
+    r = _mm_or_pd(r, _mm_and_pd(sign_bit, y));
+    return select(_mm_cmpunord_pd(x, y), _mm_add_pd(x, y), r);
+}
+
+inline auto fast_sqrt(__m128 x) -> __m128
+{
+    return _mm_sqrt_ps(x);
+}
+
+inline auto fast_sqrt(__m128d x) -> __m128d
+{
+    return _mm_sqrt_pd(x);
+}
+
+// The batch kernels process whole registers and return the number of values done; the caller handles the rest.
+// Each register is loaded before its results are stored, so the outputs may alias the inputs.
+
+// Null outputs are skipped.
+template <class T>
+auto sincos_lanes(const T* x, T* sin_x, T* cos_x, std::size_t n) -> std::size_t
+{
+    using reg = decltype(broadcast(T{}));
+
+    constexpr std::size_t width = sizeof(reg) / sizeof(T);
+
+    std::size_t i = 0;
+    for (; i + width <= n; i += width)
+    {
+        reg s;
+        reg c;
+        fast_sincos(load(x + i), s, c);
+        if (sin_x)
+        {
+            store(sin_x + i, s);
+        }
+        if (cos_x)
+        {
+            store(cos_x + i, c);
+        }
+    }
+    return i;
+}
+
+template <class T>
+auto atan2_lanes(const T* y, const T* x, T* out, std::size_t n) -> std::size_t
+{
+    using reg = decltype(broadcast(T{}));
+
+    constexpr std::size_t width = sizeof(reg) / sizeof(T);
+
+    std::size_t i = 0;
+    for (; i + width <= n; i += width)
+    {
+        store(out + i, fast_atan2(load(y + i), load(x + i)));
+    }
+    return i;
+}
+
+template <class T>
+auto sqrt_lanes(const T* x, T* out, std::size_t n) -> std::size_t
+{
+    using reg = decltype(broadcast(T{}));
+
+    constexpr std::size_t width = sizeof(reg) / sizeof(T);
+
+    std::size_t i = 0;
+    for (; i + width <= n; i += width)
+    {
+        store(out + i, fast_sqrt(load(x + i)));
+    }
+    return i;
+}
+
+#endif
+
+}  // namespace simd
+
+// With SIMD, the scalar functions run the kernels on one lane: they are free of the branches that compilers make of
+// the selections, which would be mispredicted for arguments in random quadrants, and give the same results as the
+// batch functions.
+template <class T>
+void fast_sincos(T x, T& sin_x, T& cos_x)
+{
+#if FERRUGO_ALG_SIMD
+    if constexpr (std::is_same_v<T, float>)
+    {
+        __m128 s;
+        __m128 c;
+        simd::fast_sincos(_mm_set_ss(x), s, c);
+        sin_x = _mm_cvtss_f32(s);
+        cos_x = _mm_cvtss_f32(c);
+    }
+    else
+    {
+        __m128d s;
+        __m128d c;
+        simd::fast_sincos(_mm_set_sd(x), s, c);
+        sin_x = _mm_cvtsd_f64(s);
+        cos_x = _mm_cvtsd_f64(c);
+    }
+#else
+    using constants = fast_math_constants<T>;
+
+    const T t = x * constants::two_over_pi;
+    const bool in_range = std::abs(t) < constants::quadrant_limit;
+    const auto q = static_cast<std::int32_t>(in_range ? t + std::copysign(T(0.5), t) : T(0));
+    const T k = static_cast<T>(q);
+    const auto& parts = constants::half_pi_parts;
+    const T r = in_range ? ((x - k * parts[0]) - k * parts[1]) - k * parts[2] : std::numeric_limits<T>::quiet_NaN();
+    const T z = r * r;
+    const T s = r + r * z * horner(z, constants::sin);
+    const T c = (z * z * horner(z, constants::cos) - T(0.5) * z) + T(1);
+
+    // Quadrant q takes (sin(r), cos(r)) to (s, c), (c, -s), (-s, -c) or (-c, s).
+    const T values[2] = { s, c };
+    const T signs[2] = { T(1), T(-1) };
+    sin_x = values[q & 1] * signs[(q & 2) >> 1];
+    cos_x = values[(q & 1) ^ 1] * signs[((q + 1) & 2) >> 1];
+#endif
+}
+
+template <class T>
+auto fast_atan2(T y, T x) -> T
+{
+#if FERRUGO_ALG_SIMD
+    if constexpr (std::is_same_v<T, float>)
+    {
+        return _mm_cvtss_f32(simd::fast_atan2(_mm_set_ss(y), _mm_set_ss(x)));
+    }
+    else
+    {
+        return _mm_cvtsd_f64(simd::fast_atan2(_mm_set_sd(y), _mm_set_sd(x)));
+    }
+#else
+    using constants = fast_math_constants<T>;
+
+    const T ax = std::abs(x);
+    const T ay = std::abs(y);
+    const T large = ax < ay ? ay : ax;
+    const T small = ax < ay ? ax : ay;
+    const T a = small / (large == T(0) ? T(1) : large);
+    const bool reduced = constants::atan_threshold < a;
+    const T t = reduced ? (a - T(1)) / (a + T(1)) : a;
+    const T z = t * t;
+
+    T r;
+    if constexpr (std::is_same_v<T, float>)
+    {
+        r = t + t * z * horner(z, constants::atan);
+    }
+    else
+    {
+        r = t + t * z * (horner(z, constants::atan_numerator) / horner(z, constants::atan_denominator));
+    }
+    r = reduced ? constants::quarter_pi + (r + constants::quarter_pi_low) : r;
+    r = ax < ay ? constants::half_pi - r : r;
+    r = std::signbit(x) ? constants::pi - r : r;
+    r = std::copysign(r, y);
+    return x != x || y != y ? x + y : r;
+#endif
+}
+
+// The square root instruction alone; std::sqrt adds a test of the sign for errno, which keeps loops over it scalar.
+template <class T>
+auto fast_sqrt(T x) -> T
+{
+#if FERRUGO_ALG_SIMD
+    if constexpr (std::is_same_v<T, float>)
+    {
+        return _mm_cvtss_f32(simd::fast_sqrt(_mm_set_ss(x)));
+    }
+    else
+    {
+        return _mm_cvtsd_f64(simd::fast_sqrt(_mm_set_sd(x)));
+    }
+#else
+    return std::sqrt(x);
+#endif
+}
+
+template <class T>
+void fast_sincos(const T* x, T* sin_x, T* cos_x, std::size_t n)
+{
+    std::size_t i = 0;
+
+#if FERRUGO_ALG_SIMD
+    if constexpr (simd::is_simd_type_v<T>)
+    {
+        i = simd::sincos_lanes(x, sin_x, cos_x, n);
+    }
+#endif
+
+    for (; i < n; ++i)
+    {
+        T s;
+        T c;
+        fast_sincos(x[i], s, c);
+        if (sin_x)
+        {
+            sin_x[i] = s;
+        }
+        if (cos_x)
+        {
+            cos_x[i] = c;
+        }
+    }
+}
+
+// The type the scalar fast functions compute in: integer arguments are converted to double, as by the functions of
+// <cmath>, so that the fast policy accepts the same vectors as the precise one.
+template <class T>
+using fast_math_t = std::conditional_t<std::is_integral_v<T>, double, T>;
+
+template <class T>
+void check_fast_math_type()
+{
+    static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "fast math: float or double expected");
+}
+
+template <class T>
+void check_batch_sizes(const char* message, span<const T> x, span<T> out)
+{
+    if (x.size() != out.size())
+    {
+        throw std::runtime_error{ message };
+    }
+}
+
+// Maximum errors of the fast functions against the exact values, for finite arguments: sin and cos 1 ulp for
+// |x| <= pi/4, where no reduction takes place. Beyond it the reduction by pi/2 cancels near the multiples of pi/2,
+// where sin or cos approach zero, so the error there is only bounded absolutely: 2e-16 up to |x| = 2^30 * pi/2
+// (double), 1e-7 up to |x| = 1e4 (float), where the three parts of pi/2 run out of bits. Away from those zeros it
+// stays within a few ulp. atan2 2 ulp (double) or 3 ulp (float); sqrt is correctly rounded. Unlike std::sin and
+// std::cos, the fast ones give NaN for arguments beyond 2^30 * pi/2.
+
+struct fast_sin_fn
+{
+    template <class T, class F = fast_math_t<T>>
+    auto operator()(T x) const -> F
+    {
+        check_fast_math_type<F>();
+        F s;
+        F c;
+        fast_sincos(static_cast<F>(x), s, c);
+        return s;
+    }
+
+    // out[i] = sin(x[i]); `out` may be `x` itself.
+    template <class T>
+    void operator()(span<const T> x, span<T> out) const
+    {
+        check_fast_math_type<T>();
+        check_batch_sizes("sin: size mismatch", x, out);
+        fast_sincos(x.data(), out.data(), static_cast<T*>(nullptr), x.size());
+    }
+
+    template <class T>
+    void operator()(const std::vector<T>& x, std::vector<T>& out) const
+    {
+        out.resize(x.size());
+        (*this)(span<const T>{ x }, span<T>{ out });
+    }
+};
+
+struct fast_cos_fn
+{
+    template <class T, class F = fast_math_t<T>>
+    auto operator()(T x) const -> F
+    {
+        check_fast_math_type<F>();
+        F s;
+        F c;
+        fast_sincos(static_cast<F>(x), s, c);
+        return c;
+    }
+
+    // out[i] = cos(x[i]); `out` may be `x` itself.
+    template <class T>
+    void operator()(span<const T> x, span<T> out) const
+    {
+        check_fast_math_type<T>();
+        check_batch_sizes("cos: size mismatch", x, out);
+        fast_sincos(x.data(), static_cast<T*>(nullptr), out.data(), x.size());
+    }
+
+    template <class T>
+    void operator()(const std::vector<T>& x, std::vector<T>& out) const
+    {
+        out.resize(x.size());
+        (*this)(span<const T>{ x }, span<T>{ out });
+    }
+};
+
+struct fast_sincos_fn
+{
+    // (sin(x), cos(x)), sharing the argument reduction.
+    template <class T, class F = fast_math_t<T>>
+    auto operator()(T x) const -> std::pair<F, F>
+    {
+        check_fast_math_type<F>();
+        std::pair<F, F> result;
+        fast_sincos(static_cast<F>(x), result.first, result.second);
+        return result;
+    }
+
+    // sin_x[i], cos_x[i] = sin(x[i]), cos(x[i]); either output may be `x` itself.
+    template <class T>
+    void operator()(span<const T> x, span<T> sin_x, span<T> cos_x) const
+    {
+        check_fast_math_type<T>();
+        check_batch_sizes("sincos: size mismatch", x, sin_x);
+        check_batch_sizes("sincos: size mismatch", x, cos_x);
+        fast_sincos(x.data(), sin_x.data(), cos_x.data(), x.size());
+    }
+
+    template <class T>
+    void operator()(const std::vector<T>& x, std::vector<T>& sin_x, std::vector<T>& cos_x) const
+    {
+        sin_x.resize(x.size());
+        cos_x.resize(x.size());
+        (*this)(span<const T>{ x }, span<T>{ sin_x }, span<T>{ cos_x });
+    }
+};
+
+struct fast_sqrt_fn
+{
+    template <class T, class F = fast_math_t<T>>
+    auto operator()(T x) const -> F
+    {
+        check_fast_math_type<F>();
+        return fast_sqrt(static_cast<F>(x));
+    }
+
+    // out[i] = sqrt(x[i]); `out` may be `x` itself.
+    template <class T>
+    void operator()(span<const T> x, span<T> out) const
+    {
+        check_fast_math_type<T>();
+        check_batch_sizes("sqrt: size mismatch", x, out);
+
+        std::size_t i = 0;
+
+#if FERRUGO_ALG_SIMD
+        i = simd::sqrt_lanes(x.data(), out.data(), x.size());
+#endif
+
+        for (; i < x.size(); ++i)
+        {
+            out[i] = fast_sqrt(x[i]);
+        }
+    }
+
+    template <class T>
+    void operator()(const std::vector<T>& x, std::vector<T>& out) const
+    {
+        out.resize(x.size());
+        (*this)(span<const T>{ x }, span<T>{ out });
+    }
+};
+
+struct fast_atan2_fn
+{
+    template <class T, class F = fast_math_t<T>>
+    auto operator()(T y, T x) const -> F
+    {
+        check_fast_math_type<F>();
+        return fast_atan2(static_cast<F>(y), static_cast<F>(x));
+    }
+
+    // out[i] = atan2(y[i], x[i]); `out` may be `y` or `x` itself.
+    template <class T>
+    void operator()(span<const T> y, span<const T> x, span<T> out) const
+    {
+        check_fast_math_type<T>();
+        check_batch_sizes("atan2: size mismatch", y, out);
+        check_batch_sizes("atan2: size mismatch", x, out);
+
+        std::size_t i = 0;
+
+#if FERRUGO_ALG_SIMD
+        i = simd::atan2_lanes(y.data(), x.data(), out.data(), x.size());
+#endif
+
+        for (; i < x.size(); ++i)
+        {
+            out[i] = fast_atan2(y[i], x[i]);
+        }
+    }
+
+    template <class T>
+    void operator()(const std::vector<T>& y, const std::vector<T>& x, std::vector<T>& out) const
+    {
+        out.resize(x.size());
+        (*this)(span<const T>{ y }, span<const T>{ x }, span<T>{ out });
+    }
+};
+
+struct fast_acos_fn
+{
+    // atan2(sqrt(1 - x^2), x), with 1 - x^2 computed as (1 - x) * (1 + x), which is exact enough near |x| = 1.
+    template <class T, class F = fast_math_t<T>>
+    auto operator()(T x) const -> F
+    {
+        check_fast_math_type<F>();
+        const F value = static_cast<F>(x);
+        return fast_atan2(fast_sqrt((F(1) - value) * (F(1) + value)), value);
+    }
+};
+
 }  // namespace detail
 
+// Math policies, passed as template arguments to the function objects of angle, length, unit and rotation: the
+// functions of the standard library, or the fast approximations, which are branchless, have batch versions running
+// on SIMD registers and are accurate to the bounds stated above.
+struct precise_math
+{
+    static constexpr auto sin = detail::sin_fn{};
+    static constexpr auto cos = detail::cos_fn{};
+    static constexpr auto sincos = detail::sincos_fn{};
+    static constexpr auto sqrt = detail::sqrt_fn{};
+    static constexpr auto atan2 = detail::atan2_fn{};
+    static constexpr auto acos = detail::acos_fn{};
+};
+
+struct fast_math
+{
+    static constexpr auto sin = detail::fast_sin_fn{};
+    static constexpr auto cos = detail::fast_cos_fn{};
+    static constexpr auto sincos = detail::fast_sincos_fn{};
+    static constexpr auto sqrt = detail::fast_sqrt_fn{};
+    static constexpr auto atan2 = detail::fast_atan2_fn{};
+    static constexpr auto acos = detail::fast_acos_fn{};
+};
+
 static constexpr inline auto sqr = detail::sqr_fn{};
 static constexpr inline auto sqrt = detail::sqrt_fn{};
 static constexpr inline auto abs = detail::abs_fn{};
@@ -128,10 +802,24 @@ static constexpr inline auto floor = detail::floor_fn{};
 static constexpr inline auto ceil = detail::ceil_fn{};
 static constexpr inline auto sin = detail::sin_fn{};
 static constexpr inline auto cos = detail::cos_fn{};
+static constexpr inline auto atan2 = detail::atan2_fn{};
 static constexpr inline auto atans = detail::atan2_fn{};
 static constexpr inline auto asin = detail::asin_fn{};
 static constexpr inline auto acos = detail::acos_fn{};
 static constexpr inline auto sign = detail::sign_fn{};
+static constexpr inline auto sincos = detail::sincos_fn{};
+
+namespace fast
+{
+
+static constexpr inline auto sin = fast_math::sin;
+static constexpr inline auto cos = fast_math::cos;
+static constexpr inline auto sincos = fast_math::sincos;
+static constexpr inline auto sqrt = fast_math::sqrt;
+static constexpr inline auto atan2 = fast_math::atan2;
+static constexpr inline auto acos = fast_math::acos;
+
+}  // namespace fast
 
 }  // namespace alg
 }  // namespace ferrugo
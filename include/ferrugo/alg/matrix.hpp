@@ -1,6 +1,9 @@
 #pragma once
 
+#include <ferrugo/alg/matrix/matrix.affine.hpp>
 #include <ferrugo/alg/matrix/matrix.base.hpp>
 #include <ferrugo/alg/matrix/matrix.creation.hpp>
+#include <ferrugo/alg/matrix/matrix.dynamic.hpp>
+#include <ferrugo/alg/matrix/matrix.expression.hpp>
 #include <ferrugo/alg/matrix/matrix.operations.hpp>
 #include <ferrugo/alg/matrix/matrix.operators.hpp>
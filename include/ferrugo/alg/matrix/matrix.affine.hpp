@@ -0,0 +1,225 @@
+#pragma once
+
+#include <cstddef>
+#include <ferrugo/alg/matrix/matrix.base.hpp>
+#include <ferrugo/alg/matrix/matrix.creation.hpp>
+#include <ferrugo/alg/matrix/matrix.simd.hpp>
+
+namespace ferrugo
+{
+namespace alg
+{
+
+// Affine transform stored without the constant (0, ..., 0, 1) column of its homogeneous matrix:
+// p * transform = p * linear + offset. Equivalent to the square_matrix<T, D + 1>
+//
+//   [ linear 0 ]
+//   [ offset 1 ]
+//
+// in the row-vector convention of translation / rotation / scale, using 6 (2d) or 12 (3d) values instead of 9 or 16.
+template <class T, std::size_t D>
+struct affine_transform
+{
+    square_matrix<T, D> linear;
+    vector<T, D> offset;
+
+    constexpr affine_transform() : linear(identity), offset{}
+    {
+    }
+
+    constexpr affine_transform(const square_matrix<T, D>& linear, const vector<T, D>& offset)
+        : linear(linear)
+        , offset(offset)
+    {
+    }
+
+    // Takes the top-left block and the last row; the last column is assumed to be (0, ..., 0, 1).
+    constexpr explicit affine_transform(const square_matrix<T, D + 1>& value) : linear{}, offset{}
+    {
+        for (std::size_t r = 0; r < D; ++r)
+        {
+            for (std::size_t c = 0; c < D; ++c)
+            {
+                linear(r, c) = value(r, c);
+            }
+        }
+
+        for (std::size_t c = 0; c < D; ++c)
+        {
+            offset[c] = value(D, c);
+        }
+    }
+
+    template <class U>
+    constexpr explicit affine_transform(const affine_transform<U, D>& other) : linear(other.linear), offset(other.offset)
+    {
+    }
+
+    constexpr auto to_matrix() const -> square_matrix<T, D + 1>
+    {
+        square_matrix<T, D + 1> result{};
+
+        for (std::size_t r = 0; r < D; ++r)
+        {
+            for (std::size_t c = 0; c < D; ++c)
+            {
+                result(r, c) = linear(r, c);
+            }
+        }
+
+        for (std::size_t c = 0; c < D; ++c)
+        {
+            result(D, c) = offset[c];
+        }
+
+        result(D, D) = T(1);
+
+        return result;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const affine_transform& item)
+    {
+        return os << "(affine " << item.linear << " " << item.offset << ")";
+    }
+};
+
+template <class T>
+using affine_transform_2d = affine_transform<T, 2>;
+
+template <class T>
+using affine_transform_3d = affine_transform<T, 3>;
+
+static_assert(
+    std::is_trivially_copyable_v<affine_transform_3d<float>> && std::is_standard_layout_v<affine_transform_3d<float>>);
+static_assert(sizeof(affine_transform_2d<float>) == 6 * sizeof(float));
+
+namespace detail
+{
+namespace simd
+{
+
+template <class T, class U, std::size_t D>
+static constexpr inline bool has_affine_v = is_simd_type_v<T> && std::is_same_v<T, U> && D == 3;
+
+}  // namespace simd
+}  // namespace detail
+
+template <class T, class U, std::size_t D>
+constexpr bool operator==(const affine_transform<T, D>& lhs, const affine_transform<U, D>& rhs)
+{
+    return lhs.linear == rhs.linear && lhs.offset == rhs.offset;
+}
+
+template <class T, class U, std::size_t D>
+constexpr bool operator!=(const affine_transform<T, D>& lhs, const affine_transform<U, D>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <class T, class U, std::size_t D, class Res = std::invoke_result_t<std::multiplies<>, T, U>>
+constexpr auto operator*(const vector<T, D>& lhs, const affine_transform<U, D>& rhs) -> vector<Res, D>
+{
+#if FERRUGO_ALG_SIMD
+    if constexpr (detail::simd::has_affine_v<T, U, D>)
+    {
+        if (!FERRUGO_ALG_IS_CONSTANT_EVALUATED())
+        {
+            vector<Res, D> result{ detail::raw };
+            detail::simd::affine_transform_3d(
+                lhs.m_data.data(),
+                rhs.linear.m_data.data(),
+                rhs.offset.m_data.data(),
+                result.m_data.data());
+            return result;
+        }
+    }
+#endif
+
+    vector<Res, D> result{};
+
+    for (std::size_t c = 0; c < D; ++c)
+    {
+        Res sum = static_cast<Res>(rhs.offset[c]);
+
+        for (std::size_t r = 0; r < D; ++r)
+        {
+            sum += lhs[r] * rhs.linear(r, c);
+        }
+
+        result[c] = sum;
+    }
+
+    return result;
+}
+
+template <class T, class U, std::size_t D, class Res = std::invoke_result_t<std::multiplies<>, T, U>>
+constexpr auto operator*(const affine_transform<T, D>& lhs, const vector<U, D>& rhs) -> vector<Res, D>
+{
+    return rhs * lhs;
+}
+
+template <class T, class U, std::size_t D, class = std::invoke_result_t<std::multiplies<>, T, U>>
+constexpr auto operator*=(vector<T, D>& lhs, const affine_transform<U, D>& rhs) -> vector<T, D>&
+{
+    return lhs = lhs * rhs;
+}
+
+// Applies `lhs` first, then `rhs`, like the product of the equivalent matrices.
+template <class T, class U, std::size_t D, class Res = std::invoke_result_t<std::multiplies<>, T, U>>
+constexpr auto operator*(const affine_transform<T, D>& lhs, const affine_transform<U, D>& rhs) -> affine_transform<Res, D>
+{
+#if FERRUGO_ALG_SIMD
+    if constexpr (detail::simd::has_affine_v<T, U, D>)
+    {
+        if (!FERRUGO_ALG_IS_CONSTANT_EVALUATED())
+        {
+            affine_transform<Res, D> result{ square_matrix<Res, D>{ detail::raw }, vector<Res, D>{ detail::raw } };
+            detail::simd::affine_compose_3d(
+                lhs.linear.m_data.data(),
+                lhs.offset.m_data.data(),
+                rhs.linear.m_data.data(),
+                rhs.offset.m_data.data(),
+                result.linear.m_data.data(),
+                result.offset.m_data.data());
+            return result;
+        }
+    }
+#endif
+
+    affine_transform<Res, D> result{ square_matrix<Res, D>{}, vector<Res, D>{} };
+
+    for (std::size_t c = 0; c < D; ++c)
+    {
+        Res sum = static_cast<Res>(rhs.offset[c]);
+
+        for (std::size_t k = 0; k < D; ++k)
+        {
+            sum += lhs.offset[k] * rhs.linear(k, c);
+        }
+
+        result.offset[c] = sum;
+
+        for (std::size_t r = 0; r < D; ++r)
+        {
+            Res value = Res{};
+
+            for (std::size_t k = 0; k < D; ++k)
+            {
+                value += lhs.linear(r, k) * rhs.linear(k, c);
+            }
+
+            result.linear(r, c) = value;
+        }
+    }
+
+    return result;
+}
+
+template <class T, class U, std::size_t D, class = std::invoke_result_t<std::multiplies<>, T, U>>
+constexpr auto operator*=(affine_transform<T, D>& lhs, const affine_transform<U, D>& rhs) -> affine_transform<T, D>&
+{
+    return lhs = lhs * rhs;
+}
+
+}  // namespace alg
+}  // namespace ferrugo
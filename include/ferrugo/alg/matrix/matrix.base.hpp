@@ -4,6 +4,7 @@
 #include <array>
 #include <iostream>
 #include <type_traits>
+#include <utility>
 
 namespace ferrugo
 {
@@ -35,36 +36,31 @@ public:
     using iterator = typename data_type::iterator;
     using const_iterator = typename data_type::const_iterator;
 
-    constexpr matrix()
+    constexpr matrix() : m_data{}
     {
-        std::fill(begin(), end(), value_type{});
     }
 
+    // Leaves the storage uninitialized; not usable in constant expressions.
     constexpr explicit matrix(detail::raw_t)
     {
     }
 
-    constexpr matrix(std::initializer_list<value_type> init)
+    constexpr matrix(std::initializer_list<value_type> init) : matrix(init, std::make_index_sequence<R * C>{})
     {
-        std::copy(std::begin(init), std::end(init), begin());
     }
 
-    constexpr matrix(const matrix& other)
-    {
-        std::copy(std::begin(other), std::end(other), begin());
-    }
+    constexpr matrix(const matrix&) = default;
 
     template <class U>
-    constexpr matrix(const matrix<U, R, C>& other)
+    constexpr matrix(const matrix<U, R, C>& other) : m_data{}
     {
-        std::transform(std::begin(other), std::end(other), begin(), [](U v) -> T { return static_cast<T>(v); });
+        for (size_type index = 0; index < R * C; ++index)
+        {
+            m_data[index] = static_cast<T>(other[index]);
+        }
     }
 
-    constexpr matrix& operator=(matrix other)
-    {
-        std::swap(m_data, other.m_data);
-        return *this;
-    }
+    constexpr matrix& operator=(const matrix&) = default;
 
     constexpr size_type row_count() const
     {
@@ -140,6 +136,13 @@ public:
     }
 
     data_type m_data;
+
+private:
+    template <std::size_t... I>
+    constexpr matrix(std::initializer_list<value_type> init, std::index_sequence<I...>)
+        : m_data{ { (I < init.size() ? init.begin()[I] : value_type{})... } }
+    {
+    }
 };
 
 template <class T, std::size_t D>
@@ -160,6 +163,11 @@ using vector_2d = vector<T, 2>;
 template <class T>
 using vector_3d = vector<T, 3>;
 
+// Value types are kept trivially copyable and standard-layout, so that containers of them relocate with memcpy
+// and buffers of them can be snapshotted as raw bytes (see write_bytes / read_bytes).
+static_assert(std::is_trivially_copyable_v<square_matrix<float, 4>> && std::is_standard_layout_v<square_matrix<float, 4>>);
+static_assert(std::is_trivially_copyable_v<vector_2d<int>> && std::is_standard_layout_v<vector_2d<int>>);
+
 template <class T, std::size_t R, std::size_t C>
 std::ostream& operator<<(std::ostream& os, const matrix<T, R, C>& item)
 {
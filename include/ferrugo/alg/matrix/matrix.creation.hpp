@@ -15,7 +15,7 @@ namespace detail
 struct identity_fn
 {
     template <size_t D, class T = double>
-    square_matrix<T, D> create() const
+    constexpr square_matrix<T, D> create() const
     {
         square_matrix<T, D> result;
 
@@ -31,7 +31,7 @@ struct identity_fn
     }
 
     template <class T, std::size_t D>
-    operator square_matrix<T, D>() const
+    constexpr operator square_matrix<T, D>() const
     {
         return create<D, T>();
     }
@@ -42,7 +42,7 @@ static constexpr inline auto identity = identity_fn{};
 struct scale_fn
 {
     template <class T>
-    square_matrix_2d<T> operator()(const vector_2d<T>& scale) const
+    constexpr square_matrix_2d<T> operator()(const vector_2d<T>& scale) const
     {
         square_matrix_2d<T> result = identity;
 
@@ -53,7 +53,7 @@ struct scale_fn
     }
 
     template <class T>
-    square_matrix_3d<T> operator()(const vector_3d<T>& scale) const
+    constexpr square_matrix_3d<T> operator()(const vector_3d<T>& scale) const
     {
         square_matrix_3d<T> result = identity;
 
@@ -64,28 +64,38 @@ struct scale_fn
         return result;
     }
 
-    template <class T>  
-    square_matrix_2d<T> operator()(T x, T y) const
+    template <class T>
+    constexpr square_matrix_2d<T> operator()(T x, T y) const
     {
         return (*this)(vector_2d<T>{ x, y });
     }
 
     template <class T>
-    square_matrix_3d<T> operator()(T x, T y, T z) const
+    constexpr square_matrix_3d<T> operator()(T x, T y, T z) const
     {
         return (*this)(vector_3d<T>{ x, y, z });
     }
 };
 
+template <class Policy = precise_math>
 struct rotation_fn
 {
     template <class T>
     square_matrix_2d<T> operator()(T angle) const
+    {
+        const auto [s, c] = Policy::sincos(angle);
+        return (*this)(vector_2d<T>{ c, s });
+    }
+
+    // Rotation taking the x axis onto `direction` = (cos(angle), sin(angle)), which must be of unit length.
+    // Usable in constant expressions with precomputed sine and cosine.
+    template <class T>
+    constexpr square_matrix_2d<T> operator()(const vector_2d<T>& direction) const
     {
         square_matrix_2d<T> result = identity;
 
-        const auto c = cos(angle);
-        const auto s = sin(angle);
+        const auto c = get<0>(direction);
+        const auto s = get<1>(direction);
 
         get<0, 0>(result) = c;
         get<0, 1>(result) = s;
@@ -99,7 +109,7 @@ struct rotation_fn
 struct translation_fn
 {
     template <class T>
-    square_matrix_2d<T> operator()(const vector_2d<T>& offset) const
+    constexpr square_matrix_2d<T> operator()(const vector_2d<T>& offset) const
     {
         square_matrix_2d<T> result = identity;
 
@@ -110,7 +120,7 @@ struct translation_fn
     }
 
     template <class T>
-    square_matrix_3d<T> operator()(const vector_3d<T>& offset) const
+    constexpr square_matrix_3d<T> operator()(const vector_3d<T>& offset) const
     {
         square_matrix_3d<T> result = identity;
 
@@ -122,13 +132,13 @@ struct translation_fn
     }
 
     template <class T>
-    square_matrix_2d<T> operator()(T x, T y) const
+    constexpr square_matrix_2d<T> operator()(T x, T y) const
     {
         return (*this)(vector_2d<T>{ x, y });
     }
 
     template <class T>
-    square_matrix_3d<T> operator()(T x, T y, T z) const
+    constexpr square_matrix_3d<T> operator()(T x, T y, T z) const
     {
         return (*this)(vector_3d<T>{ x, y, z });
     }
@@ -140,7 +150,14 @@ using detail::identity;
 
 static constexpr inline auto scale = detail::scale_fn{};
 static constexpr inline auto translation = detail::translation_fn{};
-static constexpr inline auto rotation = detail::rotation_fn{};
+static constexpr inline auto rotation = detail::rotation_fn<>{};
+
+namespace fast
+{
+
+static constexpr inline auto rotation = detail::rotation_fn<fast_math>{};
+
+}  // namespace fast
 
 }  // namespace alg
 }  // namespace ferrugo
\ No newline at end of file
@@ -0,0 +1,607 @@
+#pragma once
+
+#include <ferrugo/alg/matrix/matrix.base.hpp>
+#include <ferrugo/alg/matrix/matrix.simd.hpp>
+#include <ferrugo/alg/span.hpp>
+#include <stdexcept>
+#include <vector>
+
+namespace ferrugo
+{
+namespace alg
+{
+
+// Non-owning, row-major view of a rectangular block of elements; consecutive rows are `stride` elements apart.
+// Blocks of a view are views themselves, so sub-matrices never need to be copied.
+template <class T>
+class matrix_view
+{
+public:
+    using size_type = std::size_t;
+    using value_type = std::remove_cv_t<T>;
+    using reference = T&;
+    using pointer = T*;
+
+    constexpr matrix_view() : m_data(nullptr), m_rows(0), m_cols(0), m_stride(0)
+    {
+    }
+
+    constexpr matrix_view(pointer data, size_type rows, size_type cols, size_type stride)
+        : m_data(data)
+        , m_rows(rows)
+        , m_cols(cols)
+        , m_stride(stride)
+    {
+    }
+
+    constexpr matrix_view(pointer data, size_type rows, size_type cols) : matrix_view(data, rows, cols, cols)
+    {
+    }
+
+    template <class U, class = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr matrix_view(const matrix_view<U>& other)
+        : matrix_view(other.data(), other.row_count(), other.col_count(), other.stride())
+    {
+    }
+
+    template <class U, std::size_t R, std::size_t C, class = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr matrix_view(matrix<U, R, C>& other) : matrix_view(other.m_data.data(), R, C)
+    {
+    }
+
+    template <class U, std::size_t R, std::size_t C, class = std::enable_if_t<std::is_convertible_v<const U (*)[], T (*)[]>>>
+    constexpr matrix_view(const matrix<U, R, C>& other) : matrix_view(other.m_data.data(), R, C)
+    {
+    }
+
+    constexpr size_type row_count() const
+    {
+        return m_rows;
+    }
+
+    constexpr size_type col_count() const
+    {
+        return m_cols;
+    }
+
+    constexpr size_type size() const
+    {
+        return m_rows * m_cols;
+    }
+
+    constexpr size_type stride() const
+    {
+        return m_stride;
+    }
+
+    constexpr pointer data() const
+    {
+        return m_data;
+    }
+
+    constexpr reference operator()(size_type r, size_type c) const
+    {
+        return m_data[r * m_stride + c];
+    }
+
+    constexpr span<T> row(size_type r) const
+    {
+        return span<T>{ m_data + r * m_stride, m_cols };
+    }
+
+    constexpr matrix_view block(size_type r, size_type c, size_type rows, size_type cols) const
+    {
+        if (r + rows > m_rows || c + cols > m_cols)
+        {
+            throw std::runtime_error{ "block: out of range" };
+        }
+
+        return matrix_view{ m_data + r * m_stride + c, rows, cols, m_stride };
+    }
+
+private:
+    pointer m_data;
+    size_type m_rows;
+    size_type m_cols;
+    size_type m_stride;
+};
+
+// Matrix with dimensions chosen at run time; elements are stored contiguously in row-major order.
+template <class T>
+class dynamic_matrix
+{
+public:
+    using data_type = std::vector<T>;
+
+    using size_type = std::size_t;
+
+    using value_type = T;
+    using const_reference = const T&;
+    using reference = T&;
+    using const_pointer = const T*;
+    using pointer = T*;
+    using iterator = typename data_type::iterator;
+    using const_iterator = typename data_type::const_iterator;
+
+    dynamic_matrix() : m_data{}, m_rows(0), m_cols(0)
+    {
+    }
+
+    dynamic_matrix(size_type rows, size_type cols, const value_type& value = value_type{})
+        : m_data(rows * cols, value)
+        , m_rows(rows)
+        , m_cols(cols)
+    {
+    }
+
+    dynamic_matrix(size_type rows, size_type cols, std::initializer_list<value_type> init)
+        : dynamic_matrix(rows, cols)
+    {
+        std::copy(init.begin(), init.begin() + std::min(init.size(), size()), m_data.begin());
+    }
+
+    template <class U>
+    explicit dynamic_matrix(matrix_view<U> view) : dynamic_matrix(view.row_count(), view.col_count())
+    {
+        for (size_type r = 0; r < m_rows; ++r)
+        {
+            for (size_type c = 0; c < m_cols; ++c)
+            {
+                (*this)(r, c) = static_cast<T>(view(r, c));
+            }
+        }
+    }
+
+    template <class U, std::size_t R, std::size_t C>
+    explicit dynamic_matrix(const matrix<U, R, C>& other) : m_data(other.begin(), other.end()), m_rows(R), m_cols(C)
+    {
+    }
+
+    size_type row_count() const
+    {
+        return m_rows;
+    }
+
+    size_type col_count() const
+    {
+        return m_cols;
+    }
+
+    size_type size() const
+    {
+        return m_data.size();
+    }
+
+    bool empty() const
+    {
+        return m_data.empty();
+    }
+
+    const_pointer data() const
+    {
+        return m_data.data();
+    }
+
+    pointer data()
+    {
+        return m_data.data();
+    }
+
+    const_reference operator()(size_type r, size_type c) const
+    {
+        return m_data[r * m_cols + c];
+    }
+
+    reference operator()(size_type r, size_type c)
+    {
+        return m_data[r * m_cols + c];
+    }
+
+    const_reference operator[](size_type index) const
+    {
+        return m_data[index];
+    }
+
+    reference operator[](size_type index)
+    {
+        return m_data[index];
+    }
+
+    const_iterator begin() const
+    {
+        return m_data.begin();
+    }
+
+    const_iterator end() const
+    {
+        return m_data.end();
+    }
+
+    iterator begin()
+    {
+        return m_data.begin();
+    }
+
+    iterator end()
+    {
+        return m_data.end();
+    }
+
+    matrix_view<const T> view() const
+    {
+        return matrix_view<const T>{ data(), m_rows, m_cols };
+    }
+
+    matrix_view<T> view()
+    {
+        return matrix_view<T>{ data(), m_rows, m_cols };
+    }
+
+    operator matrix_view<const T>() const
+    {
+        return view();
+    }
+
+    operator matrix_view<T>()
+    {
+        return view();
+    }
+
+    matrix_view<const T> block(size_type r, size_type c, size_type rows, size_type cols) const
+    {
+        return view().block(r, c, rows, cols);
+    }
+
+    matrix_view<T> block(size_type r, size_type c, size_type rows, size_type cols)
+    {
+        return view().block(r, c, rows, cols);
+    }
+
+    span<const T> row(size_type r) const
+    {
+        return view().row(r);
+    }
+
+    span<T> row(size_type r)
+    {
+        return view().row(r);
+    }
+
+    template <std::size_t R, std::size_t C>
+    auto to_matrix() const -> matrix<T, R, C>
+    {
+        if (m_rows != R || m_cols != C)
+        {
+            throw std::runtime_error{ "to_matrix: size mismatch" };
+        }
+
+        matrix<T, R, C> result{};
+        std::copy(begin(), end(), result.begin());
+        return result;
+    }
+
+private:
+    data_type m_data;
+    size_type m_rows;
+    size_type m_cols;
+};
+
+namespace detail
+{
+
+template <class T>
+struct product_blocking
+{
+    // Register tile (rows x columns of the output held in registers by the kernel).
+    static constexpr std::size_t mr = 6;
+    static constexpr std::size_t nr = simd::is_simd_type_v<T> ? 32 / sizeof(T) : 4;
+
+    // Cache blocks: a kc x nr panel of the right-hand side stays in L1 across the rows of an mc x kc panel
+    // of the left-hand side, which stays in L2 across the nc columns of the packed right-hand side block.
+    static constexpr std::size_t kc = 256;
+    static constexpr std::size_t mc = 72;
+    static constexpr std::size_t nc = 1024;
+};
+
+struct multiply_fn
+{
+    // out = lhs * rhs. `out` must not overlap with the operands.
+    template <class T>
+    void operator()(matrix_view<const T> lhs, matrix_view<const T> rhs, matrix_view<T> out) const
+    {
+        if (lhs.col_count() != rhs.row_count() || out.row_count() != lhs.row_count() || out.col_count() != rhs.col_count())
+        {
+            throw std::runtime_error{ "multiply: size mismatch" };
+        }
+
+        const std::size_t m = lhs.row_count();
+        const std::size_t n = rhs.col_count();
+        const std::size_t k = lhs.col_count();
+
+        for (std::size_t r = 0; r < m; ++r)
+        {
+            std::fill(out.row(r).begin(), out.row(r).end(), T{});
+        }
+
+        if (m * n * k <= small_product_size)
+        {
+            multiply_naive(lhs, rhs, out);
+        }
+        else
+        {
+            multiply_blocked(lhs, rhs, out);
+        }
+    }
+
+    template <class T>
+    auto operator()(const dynamic_matrix<T>& lhs, const dynamic_matrix<T>& rhs) const -> dynamic_matrix<T>
+    {
+        dynamic_matrix<T> result{ lhs.row_count(), rhs.col_count() };
+        (*this)(lhs.view(), rhs.view(), result.view());
+        return result;
+    }
+
+private:
+    // Below this many multiply-adds, packing costs more than it saves.
+    static constexpr std::size_t small_product_size = 32 * 32 * 32;
+
+    template <class T>
+    static void multiply_naive(matrix_view<const T> lhs, matrix_view<const T> rhs, matrix_view<T> out)
+    {
+        for (std::size_t r = 0; r < lhs.row_count(); ++r)
+        {
+            T* dst = out.row(r).data();
+
+            for (std::size_t i = 0; i < lhs.col_count(); ++i)
+            {
+                const T value = lhs(r, i);
+                const T* src = rhs.row(i).data();
+
+                for (std::size_t c = 0; c < rhs.col_count(); ++c)
+                {
+                    dst[c] += value * src[c];
+                }
+            }
+        }
+    }
+
+    template <class T>
+    static void multiply_blocked(matrix_view<const T> lhs, matrix_view<const T> rhs, matrix_view<T> out)
+    {
+        using blocking = product_blocking<T>;
+
+        constexpr std::size_t mr = blocking::mr;
+        constexpr std::size_t nr = blocking::nr;
+
+        const std::size_t m = lhs.row_count();
+        const std::size_t n = rhs.col_count();
+        const std::size_t k = lhs.col_count();
+
+        std::vector<T> packed_lhs(blocking::mc * blocking::kc);
+        std::vector<T> packed_rhs(blocking::kc * blocking::nc);
+
+        for (std::size_t jj = 0; jj < n; jj += blocking::nc)
+        {
+            const std::size_t nc = std::min(blocking::nc, n - jj);
+
+            for (std::size_t kk = 0; kk < k; kk += blocking::kc)
+            {
+                const std::size_t kc = std::min(blocking::kc, k - kk);
+
+                pack_rhs<nr>(rhs.block(kk, jj, kc, nc), packed_rhs.data());
+
+                for (std::size_t ii = 0; ii < m; ii += blocking::mc)
+                {
+                    const std::size_t mc = std::min(blocking::mc, m - ii);
+
+                    pack_lhs<mr>(lhs.block(ii, kk, mc, kc), packed_lhs.data());
+
+                    for (std::size_t j = 0; j < nc; j += nr)
+                    {
+                        for (std::size_t i = 0; i < mc; i += mr)
+                        {
+                            T acc[mr * nr];
+                            product_tile<mr, nr>(packed_lhs.data() + i * kc, packed_rhs.data() + j * kc, kc, acc);
+
+                            const std::size_t rows = std::min(mr, mc - i);
+                            const std::size_t cols = std::min(nr, nc - j);
+
+                            for (std::size_t r = 0; r < rows; ++r)
+                            {
+                                T* dst = &out(ii + i + r, jj + j);
+                                for (std::size_t c = 0; c < cols; ++c)
+                                {
+                                    dst[c] += acc[r * nr + c];
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Packs a block of the left-hand side into panels of mr rows, stored column by column; the last panel is
+    // padded with zeros.
+    template <std::size_t MR, class T>
+    static void pack_lhs(matrix_view<const T> block, T* out)
+    {
+        for (std::size_t i = 0; i < block.row_count(); i += MR)
+        {
+            const std::size_t rows = std::min(MR, block.row_count() - i);
+
+            for (std::size_t p = 0; p < block.col_count(); ++p)
+            {
+                for (std::size_t r = 0; r < MR; ++r)
+                {
+                    *out++ = r < rows ? block(i + r, p) : T{};
+                }
+            }
+        }
+    }
+
+    // Packs a block of the right-hand side into panels of nr columns, stored row by row; the last panel is
+    // padded with zeros.
+    template <std::size_t NR, class T>
+    static void pack_rhs(matrix_view<const T> block, T* out)
+    {
+        for (std::size_t j = 0; j < block.col_count(); j += NR)
+        {
+            const std::size_t cols = std::min(NR, block.col_count() - j);
+
+            for (std::size_t p = 0; p < block.row_count(); ++p)
+            {
+                const T* src = block.row(p).data() + j;
+
+                for (std::size_t c = 0; c < NR; ++c)
+                {
+                    *out++ = c < cols ? src[c] : T{};
+                }
+            }
+        }
+    }
+
+    template <std::size_t MR, std::size_t NR, class T>
+    static void product_tile(const T* a, const T* b, std::size_t kc, T* acc)
+    {
+#if FERRUGO_ALG_SIMD
+        if constexpr (simd::is_simd_type_v<T>)
+        {
+            simd::product_tile<T, MR, NR>(a, b, kc, acc);
+            return;
+        }
+#endif
+
+        std::fill(acc, acc + MR * NR, T{});
+
+        for (std::size_t p = 0; p < kc; ++p, a += MR, b += NR)
+        {
+            for (std::size_t r = 0; r < MR; ++r)
+            {
+                for (std::size_t c = 0; c < NR; ++c)
+                {
+                    acc[r * NR + c] += a[r] * b[c];
+                }
+            }
+        }
+    }
+};
+
+static constexpr inline auto multiply = multiply_fn{};
+
+}  // namespace detail
+
+using detail::multiply;
+
+template <class T, class U>
+bool operator==(const dynamic_matrix<T>& lhs, const dynamic_matrix<U>& rhs)
+{
+    return lhs.row_count() == rhs.row_count() && lhs.col_count() == rhs.col_count()
+           && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, class U>
+bool operator!=(const dynamic_matrix<T>& lhs, const dynamic_matrix<U>& rhs)
+{
+    return !(lhs == rhs);
+}
+
+template <class T>
+auto operator+=(dynamic_matrix<T>& lhs, const dynamic_matrix<T>& rhs) -> dynamic_matrix<T>&
+{
+    if (lhs.row_count() != rhs.row_count() || lhs.col_count() != rhs.col_count())
+    {
+        throw std::runtime_error{ "operator+=: size mismatch" };
+    }
+
+    for (std::size_t i = 0; i < lhs.size(); ++i)
+    {
+        lhs[i] += rhs[i];
+    }
+    return lhs;
+}
+
+template <class T>
+auto operator-=(dynamic_matrix<T>& lhs, const dynamic_matrix<T>& rhs) -> dynamic_matrix<T>&
+{
+    if (lhs.row_count() != rhs.row_count() || lhs.col_count() != rhs.col_count())
+    {
+        throw std::runtime_error{ "operator-=: size mismatch" };
+    }
+
+    for (std::size_t i = 0; i < lhs.size(); ++i)
+    {
+        lhs[i] -= rhs[i];
+    }
+    return lhs;
+}
+
+template <class T>
+auto operator*=(dynamic_matrix<T>& lhs, T rhs) -> dynamic_matrix<T>&
+{
+    for (auto& item : lhs)
+    {
+        item *= rhs;
+    }
+    return lhs;
+}
+
+template <class T>
+auto operator+(dynamic_matrix<T> lhs, const dynamic_matrix<T>& rhs) -> dynamic_matrix<T>
+{
+    return lhs += rhs;
+}
+
+template <class T>
+auto operator-(dynamic_matrix<T> lhs, const dynamic_matrix<T>& rhs) -> dynamic_matrix<T>
+{
+    return lhs -= rhs;
+}
+
+template <class T>
+auto operator*(dynamic_matrix<T> lhs, T rhs) -> dynamic_matrix<T>
+{
+    return lhs *= rhs;
+}
+
+template <class T>
+auto operator*(T lhs, dynamic_matrix<T> rhs) -> dynamic_matrix<T>
+{
+    return rhs *= lhs;
+}
+
+template <class T>
+auto operator*(const dynamic_matrix<T>& lhs, const dynamic_matrix<T>& rhs) -> dynamic_matrix<T>
+{
+    return multiply(lhs, rhs);
+}
+
+template <class T>
+std::ostream& operator<<(std::ostream& os, const dynamic_matrix<T>& item)
+{
+    os << "[";
+
+    for (std::size_t r = 0; r < item.row_count(); ++r)
+    {
+        os << "[";
+
+        for (std::size_t c = 0; c < item.col_count(); ++c)
+        {
+            if (c != 0)
+            {
+                os << " ";
+            }
+
+            os << item(r, c);
+        }
+
+        os << "]";
+    }
+
+    os << "]";
+
+    return os;
+}
+
+}  // namespace alg
+}  // namespace ferrugo
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <ferrugo/alg/matrix/matrix.base.hpp>
+#include <functional>
+
+namespace ferrugo
+{
+namespace alg
+{
+
+// Lazy element-wise matrix arithmetic.
+//
+//   matrix<float, 3, 3> m = lazy(a) + lazy(b) * 2.F - c;
+//
+// builds a tree of element accessors that is evaluated in a single pass when converted to a matrix
+// (or applied with += / -=), instead of materializing one temporary per operator as the eager operators do.
+// Leaf matrices are held by reference, so an expression must not outlive the matrices it was built from.
+template <class Expr, std::size_t R, std::size_t C>
+class matrix_expression
+{
+public:
+    using value_type = std::decay_t<std::invoke_result_t<const Expr&, std::size_t>>;
+
+    constexpr explicit matrix_expression(Expr expr) : m_expr(std::move(expr))
+    {
+    }
+
+    constexpr size_t row_count() const
+    {
+        return R;
+    }
+
+    constexpr size_t col_count() const
+    {
+        return C;
+    }
+
+    constexpr size_t size() const
+    {
+        return R * C;
+    }
+
+    constexpr decltype(auto) operator[](std::size_t index) const
+    {
+        return m_expr(index);
+    }
+
+    constexpr decltype(auto) operator()(std::size_t r, std::size_t c) const
+    {
+        return m_expr(r * C + c);
+    }
+
+    template <class T>
+    constexpr operator matrix<T, R, C>() const
+    {
+        matrix<T, R, C> result{};
+        for (std::size_t i = 0; i < R * C; ++i)
+        {
+            result[i] = static_cast<T>(m_expr(i));
+        }
+        return result;
+    }
+
+    constexpr auto eval() const -> matrix<value_type, R, C>
+    {
+        return *this;
+    }
+
+private:
+    Expr m_expr;
+};
+
+namespace detail
+{
+
+template <class T>
+struct matrix_traits
+{
+    static constexpr bool is_matrix = false;
+    static constexpr bool is_expression = false;
+    static constexpr std::size_t R = 0;
+    static constexpr std::size_t C = 0;
+};
+
+template <class T, std::size_t R_, std::size_t C_>
+struct matrix_traits<matrix<T, R_, C_>>
+{
+    static constexpr bool is_matrix = true;
+    static constexpr bool is_expression = false;
+    static constexpr std::size_t R = R_;
+    static constexpr std::size_t C = C_;
+};
+
+template <class E, std::size_t R_, std::size_t C_>
+struct matrix_traits<matrix_expression<E, R_, C_>>
+{
+    static constexpr bool is_matrix = false;
+    static constexpr bool is_expression = true;
+    static constexpr std::size_t R = R_;
+    static constexpr std::size_t C = C_;
+};
+
+template <class T>
+static constexpr inline bool is_matrix_like_v = matrix_traits<T>::is_matrix || matrix_traits<T>::is_expression;
+
+template <class L, class R>
+static constexpr inline bool is_lazy_operation_v = is_matrix_like_v<L> && is_matrix_like_v<R>
+                                                   && (matrix_traits<L>::is_expression || matrix_traits<R>::is_expression)
+                                                   && matrix_traits<L>::R == matrix_traits<R>::R
+                                                   && matrix_traits<L>::C == matrix_traits<R>::C;
+
+template <class T, std::size_t R, std::size_t C>
+constexpr auto leaf(const matrix<T, R, C>& item)
+{
+    return [&item](std::size_t index) -> const T& { return item[index]; };
+}
+
+template <class E, std::size_t R, std::size_t C>
+constexpr auto leaf(const matrix_expression<E, R, C>& item)
+{
+    return [item](std::size_t index) { return item[index]; };
+}
+
+template <std::size_t R, std::size_t C, class Expr>
+constexpr auto make_expression(Expr expr) -> matrix_expression<Expr, R, C>
+{
+    return matrix_expression<Expr, R, C>{ std::move(expr) };
+}
+
+template <class Op, class L, class R>
+constexpr auto make_binary(Op op, const L& lhs, const R& rhs)
+{
+    return make_expression<matrix_traits<L>::R, matrix_traits<L>::C>(
+        [=, l = leaf(lhs), r = leaf(rhs)](std::size_t index) { return op(l(index), r(index)); });
+}
+
+template <class Op, class L, class S>
+constexpr auto make_scalar_rhs(Op op, const L& lhs, S scalar)
+{
+    return make_expression<matrix_traits<L>::R, matrix_traits<L>::C>(
+        [=, l = leaf(lhs)](std::size_t index) { return op(l(index), scalar); });
+}
+
+struct lazy_fn
+{
+    template <class T, std::size_t R, std::size_t C>
+    constexpr auto operator()(const matrix<T, R, C>& item) const
+    {
+        return make_expression<R, C>(leaf(item));
+    }
+};
+
+}  // namespace detail
+
+static constexpr inline auto lazy = detail::lazy_fn{};
+
+template <class L, class R, std::enable_if_t<detail::is_lazy_operation_v<L, R>, int> = 0>
+constexpr auto operator+(const L& lhs, const R& rhs)
+{
+    return detail::make_binary(std::plus<>{}, lhs, rhs);
+}
+
+template <class L, class R, std::enable_if_t<detail::is_lazy_operation_v<L, R>, int> = 0>
+constexpr auto operator-(const L& lhs, const R& rhs)
+{
+    return detail::make_binary(std::minus<>{}, lhs, rhs);
+}
+
+template <class E, std::size_t R, std::size_t C>
+constexpr auto operator-(const matrix_expression<E, R, C>& item)
+{
+    return detail::make_expression<R, C>([l = detail::leaf(item)](std::size_t index) { return -l(index); });
+}
+
+template <class E, std::size_t R, std::size_t C>
+constexpr auto operator+(const matrix_expression<E, R, C>& item)
+{
+    return item;
+}
+
+template <class E, std::size_t R, std::size_t C, class S, std::enable_if_t<!detail::is_matrix_like_v<S>, int> = 0>
+constexpr auto operator*(const matrix_expression<E, R, C>& lhs, S rhs)
+{
+    return detail::make_scalar_rhs(std::multiplies<>{}, lhs, rhs);
+}
+
+template <class S, class E, std::size_t R, std::size_t C, std::enable_if_t<!detail::is_matrix_like_v<S>, int> = 0>
+constexpr auto operator*(S lhs, const matrix_expression<E, R, C>& rhs)
+{
+    return rhs * lhs;
+}
+
+template <class E, std::size_t R, std::size_t C, class S, std::enable_if_t<!detail::is_matrix_like_v<S>, int> = 0>
+constexpr auto operator/(const matrix_expression<E, R, C>& lhs, S rhs)
+{
+    return detail::make_scalar_rhs(std::divides<>{}, lhs, rhs);
+}
+
+template <class T, class E, std::size_t R, std::size_t C>
+constexpr auto operator+=(matrix<T, R, C>& lhs, const matrix_expression<E, R, C>& rhs) -> matrix<T, R, C>&
+{
+    for (std::size_t i = 0; i < R * C; ++i)
+    {
+        lhs[i] += rhs[i];
+    }
+    return lhs;
+}
+
+template <class T, class E, std::size_t R, std::size_t C>
+constexpr auto operator-=(matrix<T, R, C>& lhs, const matrix_expression<E, R, C>& rhs) -> matrix<T, R, C>&
+{
+    for (std::size_t i = 0; i < R * C; ++i)
+    {
+        lhs[i] -= rhs[i];
+    }
+    return lhs;
+}
+
+}  // namespace alg
+}  // namespace ferrugo
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <ferrugo/alg/matrix/matrix.affine.hpp>
 #include <ferrugo/alg/matrix/matrix.base.hpp>
+#include <ferrugo/alg/matrix/matrix.dynamic.hpp>
+#include <algorithm>
+#include <limits>
+#include <numeric>
 #include <optional>
 #include <stdexcept>
 
@@ -9,13 +14,41 @@ namespace ferrugo
 namespace alg
 {
 
+// LU factors with scaled partial pivoting: P * A = L * U.
+// L (unit diagonal, not stored) occupies the part below the diagonal of `lu`, U the diagonal and above.
+// Row i of P * A is row permutation[i] of A; `sign` is the parity of the permutation.
+// Candidate pivots are measured relative to the largest entry of their row of A, which makes the factorization
+// independent of the scale of the rows. The matrix counts as singular, and no factors are returned, when the best
+// candidate is at most D * epsilon of its row: elimination left only rounding errors of that row.
+template <class T, std::size_t D>
+struct lu_factors
+{
+    square_matrix<T, D> lu;
+    std::array<std::size_t, D> permutation;
+    int sign;
+};
+
+static_assert(std::is_trivially_copyable_v<lu_factors<double, 4>> && std::is_standard_layout_v<lu_factors<double, 4>>);
+
+// LU factors of a dynamic_matrix, with the same layout as lu_factors.
+template <class T>
+struct dynamic_lu_factors
+{
+    dynamic_matrix<T> lu;
+    std::vector<std::size_t> permutation;
+    int sign;
+};
+
 namespace detail
 {
 
+template <class T>
+using floating_t = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+
 struct minor_fn
 {
     template <class T, std::size_t R, std::size_t C>
-    auto operator()(const matrix<T, R, C>& item, std::size_t row, std::size_t col) const -> matrix<T, R - 1, C - 1>
+    constexpr auto operator()(const matrix<T, R, C>& item, std::size_t row, std::size_t col) const -> matrix<T, R - 1, C - 1>
     {
         static_assert(R > 1, "minor: invalid row.");
         static_assert(C > 1, "minor: invalid col.");
@@ -25,11 +58,11 @@ struct minor_fn
             throw std::runtime_error{ "minor: invalid row or column" };
         }
 
-        matrix<T, R - 1, C - 1> result{ raw };
+        matrix<T, R - 1, C - 1> result{};
 
-        for (std::size_t r = 0; r < R; ++r)
+        for (std::size_t r = 0; r + 1 < R; ++r)
         {
-            for (std::size_t c = 0; c < C; ++c)
+            for (std::size_t c = 0; c + 1 < C; ++c)
             {
                 result(r, c) = item(r + (r < row ? 0 : 1), c + (c < col ? 0 : 1));
             }
@@ -41,22 +74,185 @@ struct minor_fn
 
 static constexpr inline auto minor = minor_fn{};
 
+struct lu_decomposition_fn
+{
+    template <class T, std::size_t D>
+    constexpr auto operator()(const square_matrix<T, D>& item) const -> std::optional<lu_factors<floating_t<T>, D>>
+    {
+        using F = floating_t<T>;
+
+        lu_factors<F, D> result{ square_matrix<F, D>{ item }, {}, 1 };
+        auto& lu = result.lu;
+
+        for (std::size_t r = 0; r < D; ++r)
+        {
+            result.permutation[r] = r;
+        }
+
+        const auto magnitude = [](F v) { return v < F(0) ? -v : v; };
+
+        std::array<F, D> row_scale{};
+
+        for (std::size_t r = 0; r < D; ++r)
+        {
+            for (std::size_t c = 0; c < D; ++c)
+            {
+                row_scale[r] = std::max(row_scale[r], magnitude(lu(r, c)));
+            }
+        }
+
+        // |lu(r, k)| relative to the row of A it came from; 0 for rows of zeros.
+        const auto relative = [&](std::size_t r, std::size_t k)
+        {
+            const F scale = row_scale[result.permutation[r]];
+            return scale == F(0) ? F(0) : magnitude(lu(r, k)) / scale;
+        };
+
+        const F tolerance = static_cast<F>(D) * std::numeric_limits<F>::epsilon();
+
+        for (std::size_t k = 0; k < D; ++k)
+        {
+            std::size_t pivot = k;
+
+            for (std::size_t r = k + 1; r < D; ++r)
+            {
+                if (relative(r, k) > relative(pivot, k))
+                {
+                    pivot = r;
+                }
+            }
+
+            if (relative(pivot, k) <= tolerance)
+            {
+                return {};
+            }
+
+            if (pivot != k)
+            {
+                for (std::size_t c = 0; c < D; ++c)
+                {
+                    const F tmp = lu(pivot, c);
+                    lu(pivot, c) = lu(k, c);
+                    lu(k, c) = tmp;
+                }
+                const std::size_t tmp = result.permutation[pivot];
+                result.permutation[pivot] = result.permutation[k];
+                result.permutation[k] = tmp;
+                result.sign = -result.sign;
+            }
+
+            for (std::size_t r = k + 1; r < D; ++r)
+            {
+                const F factor = lu(r, k) /= lu(k, k);
+
+                for (std::size_t c = k + 1; c < D; ++c)
+                {
+                    lu(r, c) -= factor * lu(k, c);
+                }
+            }
+        }
+
+        return result;
+    }
+
+    template <class T>
+    auto operator()(const dynamic_matrix<T>& item) const -> std::optional<dynamic_lu_factors<floating_t<T>>>
+    {
+        using F = floating_t<T>;
+
+        if (item.row_count() != item.col_count())
+        {
+            throw std::runtime_error{ "lu_decomposition: matrix is not square" };
+        }
+
+        const std::size_t size = item.row_count();
+
+        dynamic_lu_factors<F> result{ dynamic_matrix<F>{ item.view() }, std::vector<std::size_t>(size), 1 };
+        auto& lu = result.lu;
+
+        std::iota(result.permutation.begin(), result.permutation.end(), std::size_t{ 0 });
+
+        const auto magnitude = [](F v) { return v < F(0) ? -v : v; };
+
+        std::vector<F> row_scale(size, F(0));
+
+        for (std::size_t r = 0; r < size; ++r)
+        {
+            for (const F value : lu.row(r))
+            {
+                row_scale[r] = std::max(row_scale[r], magnitude(value));
+            }
+        }
+
+        // |lu(r, k)| relative to the row of A it came from; 0 for rows of zeros.
+        const auto relative = [&](std::size_t r, std::size_t k)
+        {
+            const F scale = row_scale[result.permutation[r]];
+            return scale == F(0) ? F(0) : magnitude(lu(r, k)) / scale;
+        };
+
+        const F tolerance = static_cast<F>(size) * std::numeric_limits<F>::epsilon();
+
+        for (std::size_t k = 0; k < size; ++k)
+        {
+            std::size_t pivot = k;
+
+            for (std::size_t r = k + 1; r < size; ++r)
+            {
+                if (relative(r, k) > relative(pivot, k))
+                {
+                    pivot = r;
+                }
+            }
+
+            if (relative(pivot, k) <= tolerance)
+            {
+                return {};
+            }
+
+            if (pivot != k)
+            {
+                std::swap_ranges(lu.row(pivot).begin(), lu.row(pivot).end(), lu.row(k).begin());
+                std::swap(result.permutation[pivot], result.permutation[k]);
+                result.sign = -result.sign;
+            }
+
+            const F* pivot_row = lu.row(k).data();
+
+            for (std::size_t r = k + 1; r < size; ++r)
+            {
+                F* row = lu.row(r).data();
+                const F factor = row[k] /= pivot_row[k];
+
+                for (std::size_t c = k + 1; c < size; ++c)
+                {
+                    row[c] -= factor * pivot_row[c];
+                }
+            }
+        }
+
+        return result;
+    }
+};
+
+static constexpr inline auto lu_decomposition = lu_decomposition_fn{};
+
 struct determinant_fn
 {
     template <class T>
-    auto operator()(const square_matrix<T, 1>& item) const -> T
+    constexpr auto operator()(const square_matrix<T, 1>& item) const -> T
     {
         return get<0, 0>(item);
     }
 
     template <class T>
-    auto operator()(const square_matrix<T, 2>& item) const -> decltype(std::declval<T>() * std::declval<T>())
+    constexpr auto operator()(const square_matrix<T, 2>& item) const -> decltype(std::declval<T>() * std::declval<T>())
     {
         return get<0, 0>(item) * get<1, 1>(item) - get<0, 1>(item) * get<1, 0>(item);
     }
 
     template <class T>
-    auto operator()(const square_matrix<T, 3>& item) const
+    constexpr auto operator()(const square_matrix<T, 3>& item) const
         -> decltype(std::declval<T>() * std::declval<T>() * std::declval<T>())
     {
         // clang-format off
@@ -71,25 +267,428 @@ struct determinant_fn
     }
 
     template <class T, std::size_t D>
-    auto operator()(const square_matrix<T, D>& item) const
+    constexpr auto operator()(const square_matrix<T, D>& item) const
+    {
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            const auto factors = lu_decomposition(item);
+            return factors ? (*this)(*factors) : T{};
+        }
+        else
+        {
+            auto sum = T{};
+
+            for (std::size_t i = 0; i < D; ++i)
+            {
+                sum += (i % 2 == 0 ? 1 : -1) * item(0, i) * (*this)(minor(item, 0, i));
+            }
+
+            return sum;
+        }
+    }
+
+    template <class T, std::size_t D>
+    constexpr auto operator()(const lu_factors<T, D>& item) const -> T
+    {
+        auto result = T(item.sign);
+
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            result *= item.lu(d, d);
+        }
+
+        return result;
+    }
+
+    template <class T>
+    auto operator()(const dynamic_matrix<T>& item) const -> floating_t<T>
+    {
+        const auto factors = lu_decomposition(item);
+        return factors ? (*this)(*factors) : floating_t<T>{};
+    }
+
+    template <class T>
+    auto operator()(const dynamic_lu_factors<T>& item) const -> T
     {
-        auto sum = T{};
+        auto result = T(item.sign);
 
-        for (std::size_t i = 0; i < D; ++i)
+        for (std::size_t d = 0; d < item.lu.row_count(); ++d)
         {
-            sum += (i % 2 == 0 ? 1 : -1) * item(0, i) * (*this)(minor(item, 0, i));
+            result *= item.lu(d, d);
         }
 
-        return sum;
+        return result;
     }
 };
 
 static constexpr inline auto determinant = determinant_fn{};
 
+struct solve_fn
+{
+    // Solves A * x = b, where b and x are treated as column vectors.
+    template <class T, class U, std::size_t D>
+    constexpr auto operator()(const lu_factors<T, D>& factors, const vector<U, D>& b) const -> vector<T, D>
+    {
+        const auto& lu = factors.lu;
+
+        vector<T, D> result{};
+
+        for (std::size_t r = 0; r < D; ++r)
+        {
+            T sum = static_cast<T>(b[factors.permutation[r]]);
+
+            for (std::size_t c = 0; c < r; ++c)
+            {
+                sum -= lu(r, c) * result[c];
+            }
+
+            result[r] = sum;
+        }
+
+        for (std::size_t r = D; r-- > 0;)
+        {
+            T sum = result[r];
+
+            for (std::size_t c = r + 1; c < D; ++c)
+            {
+                sum -= lu(r, c) * result[c];
+            }
+
+            result[r] = sum / lu(r, r);
+        }
+
+        return result;
+    }
+
+    template <class T, class U, std::size_t D>
+    constexpr auto operator()(const square_matrix<T, D>& a, const vector<U, D>& b) const
+        -> std::optional<vector<floating_t<T>, D>>
+    {
+        const auto factors = lu_decomposition(a);
+
+        if (!factors)
+        {
+            return {};
+        }
+
+        return (*this)(*factors, b);
+    }
+};
+
+static constexpr inline auto solve = solve_fn{};
+
+// Affine transforms in the row-vector convention used by translation/rotation/scale:
+// the top-left block is the linear part, the last row holds the translation and the last column is (0, ..., 0, 1).
+struct is_affine_fn
+{
+    template <class T, std::size_t D>
+    constexpr auto operator()(const square_matrix<T, D>& value) const -> bool
+    {
+        for (std::size_t r = 0; r + 1 < D; ++r)
+        {
+            if (value(r, D - 1) != T(0))
+            {
+                return false;
+            }
+        }
+        return value(D - 1, D - 1) == T(1);
+    }
+};
+
+static constexpr inline auto is_affine = is_affine_fn{};
+
+struct affine_inverse_base
+{
+    template <class T>
+    static constexpr auto invert_linear(const square_matrix<T, 2>& m) -> std::optional<square_matrix<T, 2>>
+    {
+        const auto det = get<0, 0>(m) * get<1, 1>(m) - get<0, 1>(m) * get<1, 0>(m);
+
+        if (!det)
+        {
+            return {};
+        }
+
+        return square_matrix<T, 2>{ get<1, 1>(m) / det, -get<0, 1>(m) / det, -get<1, 0>(m) / det, get<0, 0>(m) / det };
+    }
+
+    template <class T>
+    static constexpr auto invert_linear(const square_matrix<T, 3>& m) -> std::optional<square_matrix<T, 3>>
+    {
+        const auto [a, b, c, d, e, f, g, h, i] = m.m_data;
+
+        const T c00 = e * i - f * h;
+        const T c01 = f * g - d * i;
+        const T c02 = d * h - e * g;
+
+        const auto det = a * c00 + b * c01 + c * c02;
+
+        if (!det)
+        {
+            return {};
+        }
+
+        const T inv = T(1) / det;
+
+        // clang-format off
+        return square_matrix<T, 3>{
+            c00 * inv, (c * h - b * i) * inv, (b * f - c * e) * inv,
+            c01 * inv, (a * i - c * g) * inv, (c * d - a * f) * inv,
+            c02 * inv, (b * g - a * h) * inv, (a * e - b * d) * inv
+        };
+        // clang-format on
+    }
+
+    template <class T, std::size_t D>
+    static constexpr auto linear_part(const square_matrix<T, D>& value) -> square_matrix<T, D - 1>
+    {
+        square_matrix<T, D - 1> result{};
+
+        for (std::size_t r = 0; r + 1 < D; ++r)
+        {
+            for (std::size_t c = 0; c + 1 < D; ++c)
+            {
+                result(r, c) = value(r, c);
+            }
+        }
+
+        return result;
+    }
+
+    // Builds [L 0; -t * L 1] from the inverted linear part L and the translation row t of the original transform.
+    template <class T, std::size_t D>
+    static constexpr auto compose(const square_matrix<T, D - 1>& linear, const square_matrix<T, D>& value)
+        -> square_matrix<T, D>
+    {
+        square_matrix<T, D> result{};
+
+        for (std::size_t c = 0; c + 1 < D; ++c)
+        {
+            T sum = T{};
+
+            for (std::size_t r = 0; r + 1 < D; ++r)
+            {
+                result(r, c) = linear(r, c);
+                sum -= value(D - 1, r) * linear(r, c);
+            }
+
+            result(c, D - 1) = T(0);
+            result(D - 1, c) = sum;
+        }
+
+        result(D - 1, D - 1) = T(1);
+
+        return result;
+    }
+
+    template <class T, std::size_t D>
+    static constexpr auto compose(const square_matrix<T, D>& linear, const affine_transform<T, D>& value)
+        -> affine_transform<T, D>
+    {
+        return affine_transform<T, D>{ linear, -(value.offset * linear) };
+    }
+};
+
+struct invert_affine_fn : private affine_inverse_base
+{
+    template <class T, std::size_t D>
+    constexpr auto operator()(const square_matrix<T, D>& value) const -> std::optional<square_matrix<T, D>>
+    {
+        static_assert(D == 3 || D == 4, "invert_affine: expected square_matrix_2d or square_matrix_3d.");
+
+        const auto linear = invert_linear(linear_part(value));
+
+        if (!linear)
+        {
+            return {};
+        }
+
+        return compose(*linear, value);
+    }
+
+    template <class T, std::size_t D>
+    constexpr auto operator()(const affine_transform<T, D>& value) const -> std::optional<affine_transform<T, D>>
+    {
+        static_assert(D == 2 || D == 3, "invert_affine: expected affine_transform_2d or affine_transform_3d.");
+
+        const auto linear = invert_linear(value.linear);
+
+        if (!linear)
+        {
+            return {};
+        }
+
+        return compose(*linear, value);
+    }
+};
+
+static constexpr inline auto invert_affine = invert_affine_fn{};
+
+// Inverts a rotation + translation transform; the linear part is assumed orthonormal and is simply transposed.
+struct invert_rigid_fn : private affine_inverse_base
+{
+    template <class T, std::size_t D>
+    constexpr auto operator()(const square_matrix<T, D>& value) const -> square_matrix<T, D>
+    {
+        static_assert(D == 3 || D == 4, "invert_rigid: expected square_matrix_2d or square_matrix_3d.");
+
+        square_matrix<T, D - 1> linear{};
+
+        for (std::size_t r = 0; r + 1 < D; ++r)
+        {
+            for (std::size_t c = 0; c + 1 < D; ++c)
+            {
+                linear(r, c) = value(c, r);
+            }
+        }
+
+        return compose(linear, value);
+    }
+
+    template <class T, std::size_t D>
+    constexpr auto operator()(const affine_transform<T, D>& value) const -> affine_transform<T, D>
+    {
+        square_matrix<T, D> linear{};
+
+        for (std::size_t r = 0; r < D; ++r)
+        {
+            for (std::size_t c = 0; c < D; ++c)
+            {
+                linear(r, c) = value.linear(c, r);
+            }
+        }
+
+        return compose(linear, value);
+    }
+};
+
+static constexpr inline auto invert_rigid = invert_rigid_fn{};
+
 struct invert_fn
 {
     template <class T, std::size_t D>
-    auto operator()(const square_matrix<T, D>& value) const -> std::optional<square_matrix<T, D>>
+    constexpr auto operator()(const square_matrix<T, D>& value) const -> std::optional<square_matrix<T, D>>
+    {
+        if constexpr (std::is_floating_point_v<T> && (D == 3 || D == 4))
+        {
+            if (is_affine(value))
+            {
+                return invert_affine(value);
+            }
+        }
+
+        if constexpr (std::is_floating_point_v<T> && (D > 3))
+        {
+            const auto factors = lu_decomposition(value);
+
+            if (!factors)
+            {
+                return {};
+            }
+
+            return (*this)(*factors);
+        }
+        else
+        {
+            return invert_cofactors(value);
+        }
+    }
+
+    template <class T, std::size_t D>
+    constexpr auto operator()(const affine_transform<T, D>& value) const -> std::optional<affine_transform<T, D>>
+    {
+        return invert_affine(value);
+    }
+
+    template <class T, std::size_t D>
+    constexpr auto operator()(const lu_factors<T, D>& factors) const -> square_matrix<T, D>
+    {
+        square_matrix<T, D> result{};
+
+        for (std::size_t c = 0; c < D; ++c)
+        {
+            vector<T, D> basis{};
+            basis[c] = T(1);
+
+            const auto column = solve(factors, basis);
+
+            for (std::size_t r = 0; r < D; ++r)
+            {
+                result(r, c) = column[r];
+            }
+        }
+
+        return result;
+    }
+
+    template <class T>
+    auto operator()(const dynamic_matrix<T>& value) const -> std::optional<dynamic_matrix<floating_t<T>>>
+    {
+        const auto factors = lu_decomposition(value);
+
+        if (!factors)
+        {
+            return {};
+        }
+
+        return (*this)(*factors);
+    }
+
+    // Solves L * U * X = P for all columns at once, sweeping whole rows so that the inner loops stay contiguous.
+    template <class T>
+    auto operator()(const dynamic_lu_factors<T>& factors) const -> dynamic_matrix<T>
+    {
+        const auto& lu = factors.lu;
+        const std::size_t size = lu.row_count();
+
+        dynamic_matrix<T> result{ size, size };
+
+        for (std::size_t r = 0; r < size; ++r)
+        {
+            T* row = result.row(r).data();
+            row[factors.permutation[r]] = T(1);
+
+            for (std::size_t i = 0; i < r; ++i)
+            {
+                const T factor = lu(r, i);
+                const T* other = result.row(i).data();
+
+                for (std::size_t c = 0; c < size; ++c)
+                {
+                    row[c] -= factor * other[c];
+                }
+            }
+        }
+
+        for (std::size_t r = size; r-- > 0;)
+        {
+            T* row = result.row(r).data();
+
+            for (std::size_t i = r + 1; i < size; ++i)
+            {
+                const T factor = lu(r, i);
+                const T* other = result.row(i).data();
+
+                for (std::size_t c = 0; c < size; ++c)
+                {
+                    row[c] -= factor * other[c];
+                }
+            }
+
+            const T pivot = lu(r, r);
+
+            for (std::size_t c = 0; c < size; ++c)
+            {
+                row[c] /= pivot;
+            }
+        }
+
+        return result;
+    }
+
+private:
+    template <class T, std::size_t D>
+    static constexpr auto invert_cofactors(const square_matrix<T, D>& value) -> std::optional<square_matrix<T, D>>
     {
         const auto det = determinant(value);
 
@@ -98,7 +697,7 @@ struct invert_fn
             return {};
         }
 
-        square_matrix<T, D> result{ raw };
+        square_matrix<T, D> result{};
 
         for (std::size_t r = 0; r < D; ++r)
         {
@@ -117,9 +716,9 @@ static constexpr inline auto invert = invert_fn{};
 struct transpose_fn
 {
     template <class T, std::size_t R, std::size_t C>
-    auto operator()(const matrix<T, R, C>& item) const -> matrix<T, C, R>
+    constexpr auto operator()(const matrix<T, R, C>& item) const -> matrix<T, C, R>
     {
-        matrix<T, C, R> result{ raw };
+        matrix<T, C, R> result{};
 
         for (size_t r = 0; r < R; ++r)
         {
@@ -131,6 +730,40 @@ struct transpose_fn
 
         return result;
     }
+
+    // Copies in square tiles so that both the reads and the writes of a tile stay within a few cache lines.
+    template <class T>
+    auto operator()(matrix_view<T> item) const -> dynamic_matrix<std::remove_cv_t<T>>
+    {
+        constexpr std::size_t tile = 16;
+
+        const std::size_t rows = item.row_count();
+        const std::size_t cols = item.col_count();
+
+        dynamic_matrix<std::remove_cv_t<T>> result{ cols, rows };
+
+        for (std::size_t rr = 0; rr < rows; rr += tile)
+        {
+            for (std::size_t cc = 0; cc < cols; cc += tile)
+            {
+                for (std::size_t r = rr; r < std::min(rr + tile, rows); ++r)
+                {
+                    for (std::size_t c = cc; c < std::min(cc + tile, cols); ++c)
+                    {
+                        result(c, r) = item(r, c);
+                    }
+                }
+            }
+        }
+
+        return result;
+    }
+
+    template <class T>
+    auto operator()(const dynamic_matrix<T>& item) const -> dynamic_matrix<T>
+    {
+        return (*this)(item.view());
+    }
 };
 
 static constexpr inline auto transpose = transpose_fn{};
@@ -139,7 +772,12 @@ static constexpr inline auto transpose = transpose_fn{};
 
 using detail::determinant;
 using detail::invert;
+using detail::invert_affine;
+using detail::invert_rigid;
+using detail::is_affine;
+using detail::lu_decomposition;
 using detail::minor;
+using detail::solve;
 using detail::transpose;
 
 }  // namespace alg
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <ferrugo/alg/matrix/matrix.base.hpp>
+#include <ferrugo/alg/matrix/matrix.simd.hpp>
 #include <functional>
 
 namespace ferrugo
@@ -9,97 +10,128 @@ namespace alg
 {
 
 template <class T, class U, std::size_t R, std::size_t C>
-bool operator==(const matrix<T, R, C>& lhs, const matrix<U, R, C>& rhs)
+constexpr bool operator==(const matrix<T, R, C>& lhs, const matrix<U, R, C>& rhs)
 {
-    return std::equal(std::begin(lhs), std::end(lhs), std::begin(rhs));
+    for (std::size_t i = 0; i < R * C; ++i)
+    {
+        if (!(lhs[i] == rhs[i]))
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
 template <class T, class U, std::size_t R, std::size_t C>
-bool operator!=(const matrix<T, R, C>& lhs, const matrix<U, R, C>& rhs)
+constexpr bool operator!=(const matrix<T, R, C>& lhs, const matrix<U, R, C>& rhs)
 {
     return !(lhs == rhs);
 }
 
 template <class T, std::size_t R, std::size_t C>
-auto operator+(const matrix<T, R, C>& item) -> matrix<T, R, C>
+constexpr auto operator+(const matrix<T, R, C>& item) -> matrix<T, R, C>
 {
     return item;
 }
 
 template <class T, std::size_t R, std::size_t C>
-auto operator-(const matrix<T, R, C>& item) -> matrix<T, R, C>
+constexpr auto operator-(const matrix<T, R, C>& item) -> matrix<T, R, C>
 {
-    matrix<T, R, C> result{ detail::raw };
-    std::transform(std::begin(item), std::end(item), std::begin(result), std::negate<>{});
+    matrix<T, R, C> result{};
+    for (std::size_t i = 0; i < R * C; ++i)
+    {
+        result[i] = -item[i];
+    }
     return result;
 }
 
 template <class T, class U, std::size_t R, std::size_t C, class = std::invoke_result_t<std::plus<>, T, U>>
-auto operator+=(matrix<T, R, C>& lhs, const matrix<U, R, C>& rhs) -> matrix<T, R, C>&
+constexpr auto operator+=(matrix<T, R, C>& lhs, const matrix<U, R, C>& rhs) -> matrix<T, R, C>&
 {
-    std::transform(std::begin(lhs), std::end(lhs), std::begin(rhs), std::begin(lhs), std::plus<>{});
+    for (std::size_t i = 0; i < R * C; ++i)
+    {
+        lhs[i] += rhs[i];
+    }
     return lhs;
 }
 
 template <class T, class U, std::size_t R, std::size_t C, class = std::invoke_result_t<std::minus<>, T, U>>
-auto operator-=(matrix<T, R, C>& lhs, const matrix<U, R, C>& rhs) -> matrix<T, R, C>&
+constexpr auto operator-=(matrix<T, R, C>& lhs, const matrix<U, R, C>& rhs) -> matrix<T, R, C>&
 {
-    std::transform(std::begin(lhs), std::end(lhs), std::begin(rhs), std::begin(lhs), std::minus<>{});
+    for (std::size_t i = 0; i < R * C; ++i)
+    {
+        lhs[i] -= rhs[i];
+    }
     return lhs;
 }
 
 template <class T, class U, std::size_t R, std::size_t C, class = std::invoke_result_t<std::multiplies<>, T, U>>
-auto operator*=(matrix<T, R, C>& lhs, U rhs) -> matrix<T, R, C>&
+constexpr auto operator*=(matrix<T, R, C>& lhs, U rhs) -> matrix<T, R, C>&
 {
-    std::transform(
-        std::begin(lhs), std::end(lhs), std::begin(lhs), std::bind(std::multiplies<>{}, std::placeholders::_1, rhs));
+    for (std::size_t i = 0; i < R * C; ++i)
+    {
+        lhs[i] *= rhs;
+    }
     return lhs;
 }
 
 template <class T, class U, std::size_t R, std::size_t C, class = std::invoke_result_t<std::divides<>, T, U>>
-auto operator/=(matrix<T, R, C>& lhs, U rhs) -> matrix<T, R, C>&
+constexpr auto operator/=(matrix<T, R, C>& lhs, U rhs) -> matrix<T, R, C>&
 {
-    std::transform(std::begin(lhs), std::end(lhs), std::begin(lhs), std::bind(std::divides<>{}, std::placeholders::_1, rhs));
+    for (std::size_t i = 0; i < R * C; ++i)
+    {
+        lhs[i] /= rhs;
+    }
     return lhs;
 }
 
 template <class T, class U, std::size_t R, std::size_t C, class Res = std::invoke_result_t<std::plus<>, T, U>>
-auto operator+(const matrix<T, R, C>& lhs, const matrix<U, R, C>& rhs) -> matrix<Res, R, C>
+constexpr auto operator+(const matrix<T, R, C>& lhs, const matrix<U, R, C>& rhs) -> matrix<Res, R, C>
 {
-    matrix<Res, R, C> result{ detail::raw };
-    std::transform(std::begin(lhs), std::end(lhs), std::begin(rhs), std::begin(result), std::plus<>{});
+    matrix<Res, R, C> result{};
+    for (std::size_t i = 0; i < R * C; ++i)
+    {
+        result[i] = lhs[i] + rhs[i];
+    }
     return result;
 }
 
 template <class T, class U, std::size_t R, std::size_t C, class Res = std::invoke_result_t<std::minus<>, T, U>>
-auto operator-(const matrix<T, R, C>& lhs, const matrix<U, R, C>& rhs) -> matrix<Res, R, C>
+constexpr auto operator-(const matrix<T, R, C>& lhs, const matrix<U, R, C>& rhs) -> matrix<Res, R, C>
 {
-    matrix<Res, R, C> result{ detail::raw };
-    std::transform(std::begin(lhs), std::end(lhs), std::begin(rhs), std::begin(result), std::minus<>{});
+    matrix<Res, R, C> result{};
+    for (std::size_t i = 0; i < R * C; ++i)
+    {
+        result[i] = lhs[i] - rhs[i];
+    }
     return result;
 }
 
 template <class T, class U, std::size_t R, std::size_t C, class Res = std::invoke_result_t<std::multiplies<>, T, U>>
-auto operator*(const matrix<T, R, C>& lhs, U rhs) -> matrix<Res, R, C>
+constexpr auto operator*(const matrix<T, R, C>& lhs, U rhs) -> matrix<Res, R, C>
 {
-    matrix<Res, R, C> result{ detail::raw };
-    std::transform(
-        std::begin(lhs), std::end(lhs), std::begin(result), std::bind(std::multiplies<>{}, std::placeholders::_1, rhs));
+    matrix<Res, R, C> result{};
+    for (std::size_t i = 0; i < R * C; ++i)
+    {
+        result[i] = lhs[i] * rhs;
+    }
     return result;
 }
 
 template <class T, class U, std::size_t R, std::size_t C, class Res = std::invoke_result_t<std::multiplies<>, T, U>>
-auto operator*(T lhs, const matrix<U, R, C>& rhs) -> matrix<Res, R, C>
+constexpr auto operator*(T lhs, const matrix<U, R, C>& rhs) -> matrix<Res, R, C>
 {
     return rhs * lhs;
 }
 
 template <class T, class U, std::size_t R, std::size_t C, class Res = std::invoke_result_t<std::divides<>, T, U>>
-auto operator/(const matrix<T, R, C>& lhs, U rhs) -> matrix<Res, R, C>
+constexpr auto operator/(const matrix<T, R, C>& lhs, U rhs) -> matrix<Res, R, C>
 {
-    matrix<Res, R, C> result{ detail::raw };
-    std::transform(
-        std::begin(lhs), std::end(lhs), std::begin(result), std::bind(std::divides<>{}, std::placeholders::_1, rhs));
+    matrix<Res, R, C> result{};
+    for (std::size_t i = 0; i < R * C; ++i)
+    {
+        result[i] = lhs[i] / rhs;
+    }
     return result;
 }
 
@@ -110,8 +142,18 @@ template <
     std::size_t D,
     std::size_t C,
     class Res = std::invoke_result_t<std::multiplies<>, T, U>>
-auto operator*(const matrix<T, R, D>& lhs, const matrix<U, D, C>& rhs) -> matrix<Res, R, C>
+constexpr auto operator*(const matrix<T, R, D>& lhs, const matrix<U, D, C>& rhs) -> matrix<Res, R, C>
 {
+#if FERRUGO_ALG_SIMD
+    if constexpr (detail::simd::has_product_v<T, U, R, D, C>)
+    {
+        if (!FERRUGO_ALG_IS_CONSTANT_EVALUATED())
+        {
+            return detail::simd::product(lhs, rhs);
+        }
+    }
+#endif
+
     matrix<Res, R, C> result;
 
     for (std::size_t r = 0; r < lhs.row_count(); ++r)
@@ -133,8 +175,18 @@ auto operator*(const matrix<T, R, D>& lhs, const matrix<U, D, C>& rhs) -> matrix
 }
 
 template <class T, class U, std::size_t D, class Res = std::invoke_result_t<std::multiplies<>, T, U>>
-auto operator*(const vector<T, D>& lhs, const square_matrix<U, D + 1>& rhs) -> vector<Res, D>
+constexpr auto operator*(const vector<T, D>& lhs, const square_matrix<U, D + 1>& rhs) -> vector<Res, D>
 {
+#if FERRUGO_ALG_SIMD
+    if constexpr (detail::simd::has_transform_v<T, U, D>)
+    {
+        if (!FERRUGO_ALG_IS_CONSTANT_EVALUATED())
+        {
+            return detail::simd::transform(lhs, rhs);
+        }
+    }
+#endif
+
     vector<Res, D> result;
 
     for (std::size_t d = 0; d < lhs.size(); ++d)
@@ -153,13 +205,13 @@ auto operator*(const vector<T, D>& lhs, const square_matrix<U, D + 1>& rhs) -> v
 }
 
 template <class T, class U, std::size_t D, class Res = std::invoke_result_t<std::multiplies<>, T, U>>
-auto operator*(const square_matrix<T, D + 1>& lhs, const vector<U, D>& rhs) -> vector<Res, D>
+constexpr auto operator*(const square_matrix<T, D + 1>& lhs, const vector<U, D>& rhs) -> vector<Res, D>
 {
     return rhs * lhs;
 }
 
 template <class T, class U, std::size_t D, class = std::invoke_result_t<std::multiplies<>, T, U>>
-auto operator*=(vector<T, D>& lhs, const square_matrix<U, D + 1>& rhs) -> vector<T, D>&
+constexpr auto operator*=(vector<T, D>& lhs, const square_matrix<U, D + 1>& rhs) -> vector<T, D>&
 {
     return lhs = lhs * rhs;
 }
@@ -0,0 +1,623 @@
+#pragma once
+
+#include <ferrugo/alg/matrix/matrix.base.hpp>
+
+// SSE/AVX kernels for the 3x3 and 4x4 float/double products and the homogeneous 3d point transform.
+// The 2d point transform is left to the compiler, which vectorizes the scalar loop at least as well.
+// Enabled when the target supports SSE2 and the compiler can tell constant evaluation apart (below); define
+// FERRUGO_ALG_NO_SIMD to force the generic scalar path.
+//
+// The kernels accumulate in the same order as the scalar loops, so the results are bit-identical to the
+// generic path unless FMA is available (__FMA__), in which case each element may differ by a few units
+// in the last place due to the skipped intermediate rounding.
+
+// The kernels are not usable in constant expressions; constexpr callers fall back to the scalar loops, which needs
+// __builtin_is_constant_evaluated (MSVC has it from 19.25 on). Compilers without it get no kernels.
+#if defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#define FERRUGO_ALG_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+
+#if !defined(FERRUGO_ALG_NO_SIMD) && defined(FERRUGO_ALG_IS_CONSTANT_EVALUATED) && (defined(__SSE2__) || defined(_M_X64))
+#define FERRUGO_ALG_SIMD 1
+#include <immintrin.h>
+#else
+#define FERRUGO_ALG_SIMD 0
+#endif
+
+namespace ferrugo
+{
+namespace alg
+{
+namespace detail
+{
+namespace simd
+{
+
+template <class T>
+static constexpr inline bool is_simd_type_v = FERRUGO_ALG_SIMD && (std::is_same_v<T, float> || std::is_same_v<T, double>);
+
+template <class T, class U, std::size_t R, std::size_t D, std::size_t C>
+static constexpr inline bool has_product_v
+    = is_simd_type_v<T> && std::is_same_v<T, U> && R == D && D == C && (D == 3 || D == 4);
+
+template <class T, class U, std::size_t D>
+static constexpr inline bool has_transform_v = is_simd_type_v<T> && std::is_same_v<T, U> && D == 3;
+
+#if FERRUGO_ALG_SIMD
+
+inline __m128 madd(__m128 a, __m128 b, __m128 c)
+{
+#ifdef __FMA__
+    return _mm_fmadd_ps(a, b, c);
+#else
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+}
+
+inline __m128d madd(__m128d a, __m128d b, __m128d c)
+{
+#ifdef __FMA__
+    return _mm_fmadd_pd(a, b, c);
+#else
+    return _mm_add_pd(_mm_mul_pd(a, b), c);
+#endif
+}
+
+#ifdef __AVX__
+inline __m256d madd(__m256d a, __m256d b, __m256d c)
+{
+#ifdef __FMA__
+    return _mm256_fmadd_pd(a, b, c);
+#else
+    return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+}
+#endif
+
+inline __m128 load2(const float* p)
+{
+    return _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64*>(p));
+}
+
+inline __m128 load3(const float* p)
+{
+    return _mm_movelh_ps(load2(p), _mm_load_ss(p + 2));
+}
+
+inline void store2(float* p, __m128 v)
+{
+    _mm_storel_pi(reinterpret_cast<__m64*>(p), v);
+}
+
+inline void store3(float* p, __m128 v)
+{
+    store2(p, v);
+    _mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+}
+
+// Rows of the right-hand side are combined with the broadcast elements of the left-hand side row:
+// out(r, :) = sum_i lhs(r, i) * rhs(i, :).
+
+inline void product_4x4(const float* lhs, const float* rhs, float* out)
+{
+    const __m128 b0 = _mm_loadu_ps(rhs + 0);
+    const __m128 b1 = _mm_loadu_ps(rhs + 4);
+    const __m128 b2 = _mm_loadu_ps(rhs + 8);
+    const __m128 b3 = _mm_loadu_ps(rhs + 12);
+
+    for (std::size_t r = 0; r < 4; ++r)
+    {
+        const float* a = lhs + 4 * r;
+        __m128 acc = _mm_mul_ps(_mm_set1_ps(a[0]), b0);
+        acc = madd(_mm_set1_ps(a[1]), b1, acc);
+        acc = madd(_mm_set1_ps(a[2]), b2, acc);
+        acc = madd(_mm_set1_ps(a[3]), b3, acc);
+        _mm_storeu_ps(out + 4 * r, acc);
+    }
+}
+
+inline void product_3x3(const float* lhs, const float* rhs, float* out)
+{
+    const __m128 b0 = load3(rhs + 0);
+    const __m128 b1 = load3(rhs + 3);
+    const __m128 b2 = load3(rhs + 6);
+
+    for (std::size_t r = 0; r < 3; ++r)
+    {
+        const float* a = lhs + 3 * r;
+        __m128 acc = _mm_mul_ps(_mm_set1_ps(a[0]), b0);
+        acc = madd(_mm_set1_ps(a[1]), b1, acc);
+        acc = madd(_mm_set1_ps(a[2]), b2, acc);
+        store3(out + 3 * r, acc);
+    }
+}
+
+inline void product_4x4(const double* lhs, const double* rhs, double* out)
+{
+#ifdef __AVX__
+    const __m256d b0 = _mm256_loadu_pd(rhs + 0);
+    const __m256d b1 = _mm256_loadu_pd(rhs + 4);
+    const __m256d b2 = _mm256_loadu_pd(rhs + 8);
+    const __m256d b3 = _mm256_loadu_pd(rhs + 12);
+
+    for (std::size_t r = 0; r < 4; ++r)
+    {
+        const double* a = lhs + 4 * r;
+        __m256d acc = _mm256_mul_pd(_mm256_set1_pd(a[0]), b0);
+        acc = madd(_mm256_set1_pd(a[1]), b1, acc);
+        acc = madd(_mm256_set1_pd(a[2]), b2, acc);
+        acc = madd(_mm256_set1_pd(a[3]), b3, acc);
+        _mm256_storeu_pd(out + 4 * r, acc);
+    }
+#else
+    for (std::size_t half = 0; half < 4; half += 2)
+    {
+        const __m128d b0 = _mm_loadu_pd(rhs + 0 + half);
+        const __m128d b1 = _mm_loadu_pd(rhs + 4 + half);
+        const __m128d b2 = _mm_loadu_pd(rhs + 8 + half);
+        const __m128d b3 = _mm_loadu_pd(rhs + 12 + half);
+
+        for (std::size_t r = 0; r < 4; ++r)
+        {
+            const double* a = lhs + 4 * r;
+            __m128d acc = _mm_mul_pd(_mm_set1_pd(a[0]), b0);
+            acc = madd(_mm_set1_pd(a[1]), b1, acc);
+            acc = madd(_mm_set1_pd(a[2]), b2, acc);
+            acc = madd(_mm_set1_pd(a[3]), b3, acc);
+            _mm_storeu_pd(out + 4 * r + half, acc);
+        }
+    }
+#endif
+}
+
+inline void product_3x3(const double* lhs, const double* rhs, double* out)
+{
+    const __m128d b0 = _mm_loadu_pd(rhs + 0);
+    const __m128d b1 = _mm_loadu_pd(rhs + 3);
+    const __m128d b2 = _mm_loadu_pd(rhs + 6);
+    const __m128d c0 = _mm_load_sd(rhs + 2);
+    const __m128d c1 = _mm_load_sd(rhs + 5);
+    const __m128d c2 = _mm_load_sd(rhs + 8);
+
+    for (std::size_t r = 0; r < 3; ++r)
+    {
+        const double* a = lhs + 3 * r;
+        const __m128d a0 = _mm_set1_pd(a[0]);
+        const __m128d a1 = _mm_set1_pd(a[1]);
+        const __m128d a2 = _mm_set1_pd(a[2]);
+        __m128d acc = _mm_mul_pd(a0, b0);
+        __m128d last = _mm_mul_sd(a0, c0);
+        acc = madd(a1, b1, acc);
+        last = madd(a1, c1, last);
+        acc = madd(a2, b2, acc);
+        last = madd(a2, c2, last);
+        _mm_storeu_pd(out + 3 * r, acc);
+        _mm_store_sd(out + 3 * r + 2, last);
+    }
+}
+
+// Homogeneous point transform: out = row(3) + sum_i point[i] * row(i), restricted to the first 3 lanes.
+
+inline void transform_3d(const float* point, const float* m, float* out)
+{
+    __m128 acc = _mm_loadu_ps(m + 12);
+    acc = madd(_mm_set1_ps(point[0]), _mm_loadu_ps(m + 0), acc);
+    acc = madd(_mm_set1_ps(point[1]), _mm_loadu_ps(m + 4), acc);
+    acc = madd(_mm_set1_ps(point[2]), _mm_loadu_ps(m + 8), acc);
+    store3(out, acc);
+}
+
+inline void transform_3d(const double* point, const double* m, double* out)
+{
+#ifdef __AVX__
+    __m256d acc = _mm256_loadu_pd(m + 12);
+    acc = madd(_mm256_set1_pd(point[0]), _mm256_loadu_pd(m + 0), acc);
+    acc = madd(_mm256_set1_pd(point[1]), _mm256_loadu_pd(m + 4), acc);
+    acc = madd(_mm256_set1_pd(point[2]), _mm256_loadu_pd(m + 8), acc);
+    _mm_storeu_pd(out, _mm256_castpd256_pd128(acc));
+    _mm_store_sd(out + 2, _mm256_extractf128_pd(acc, 1));
+#else
+    const __m128d x = _mm_set1_pd(point[0]);
+    const __m128d y = _mm_set1_pd(point[1]);
+    const __m128d z = _mm_set1_pd(point[2]);
+    __m128d acc = _mm_loadu_pd(m + 12);
+    __m128d last = _mm_load_sd(m + 14);
+    acc = madd(x, _mm_loadu_pd(m + 0), acc);
+    last = madd(x, _mm_load_sd(m + 2), last);
+    acc = madd(y, _mm_loadu_pd(m + 4), acc);
+    last = madd(y, _mm_load_sd(m + 6), last);
+    acc = madd(z, _mm_loadu_pd(m + 8), acc);
+    last = madd(z, _mm_load_sd(m + 10), last);
+    _mm_storeu_pd(out, acc);
+    _mm_store_sd(out + 2, last);
+#endif
+}
+
+// Affine transforms without the constant column: the 3x3 linear part (rows 3 elements apart) and the offset, which
+// together form the 4x3 matrix [linear; offset]. The composition multiplies that matrix by the linear part of the
+// right-hand side and adds the right-hand side offset to the last row.
+// The rows of the linear part are repacked so that they are written with full-width stores; narrow stores followed by
+// wide loads of the same transform would otherwise stall store-to-load forwarding.
+
+inline void affine_transform_3d(const float* point, const float* linear, const float* offset, float* out)
+{
+    __m128 acc = load3(offset);
+    acc = madd(_mm_set1_ps(point[0]), load3(linear + 0), acc);
+    acc = madd(_mm_set1_ps(point[1]), load3(linear + 3), acc);
+    acc = madd(_mm_set1_ps(point[2]), load3(linear + 6), acc);
+    store3(out, acc);
+}
+
+inline void affine_transform_3d(const double* point, const double* linear, const double* offset, double* out)
+{
+    const __m128d x = _mm_set1_pd(point[0]);
+    const __m128d y = _mm_set1_pd(point[1]);
+    const __m128d z = _mm_set1_pd(point[2]);
+    __m128d acc = _mm_loadu_pd(offset);
+    __m128d last = _mm_load_sd(offset + 2);
+    acc = madd(x, _mm_loadu_pd(linear + 0), acc);
+    last = madd(x, _mm_load_sd(linear + 2), last);
+    acc = madd(y, _mm_loadu_pd(linear + 3), acc);
+    last = madd(y, _mm_load_sd(linear + 5), last);
+    acc = madd(z, _mm_loadu_pd(linear + 6), acc);
+    last = madd(z, _mm_load_sd(linear + 8), last);
+    _mm_storeu_pd(out, acc);
+    _mm_store_sd(out + 2, last);
+}
+
+inline void affine_compose_3d(
+    const float* lhs_linear,
+    const float* lhs_offset,
+    const float* rhs_linear,
+    const float* rhs_offset,
+    float* out_linear,
+    float* out_offset)
+{
+    const __m128 b0 = load3(rhs_linear + 0);
+    const __m128 b1 = load3(rhs_linear + 3);
+    const __m128 b2 = load3(rhs_linear + 6);
+
+    __m128 rows[4];
+
+    for (std::size_t r = 0; r < 4; ++r)
+    {
+        const float* a = r == 3 ? lhs_offset : lhs_linear + 3 * r;
+        __m128 acc = r == 3 ? load3(rhs_offset) : _mm_setzero_ps();
+        acc = madd(_mm_set1_ps(a[0]), b0, acc);
+        acc = madd(_mm_set1_ps(a[1]), b1, acc);
+        acc = madd(_mm_set1_ps(a[2]), b2, acc);
+        rows[r] = acc;
+    }
+
+    const __m128 t0 = _mm_shuffle_ps(rows[0], rows[1], _MM_SHUFFLE(0, 0, 2, 2));
+    _mm_storeu_ps(out_linear + 0, _mm_shuffle_ps(rows[0], t0, _MM_SHUFFLE(2, 0, 1, 0)));
+    _mm_storeu_ps(out_linear + 4, _mm_shuffle_ps(rows[1], rows[2], _MM_SHUFFLE(1, 0, 2, 1)));
+    _mm_store_ss(out_linear + 8, _mm_movehl_ps(rows[2], rows[2]));
+    store3(out_offset, rows[3]);
+}
+
+inline void affine_compose_3d(
+    const double* lhs_linear,
+    const double* lhs_offset,
+    const double* rhs_linear,
+    const double* rhs_offset,
+    double* out_linear,
+    double* out_offset)
+{
+    const __m128d b0 = _mm_loadu_pd(rhs_linear + 0);
+    const __m128d b1 = _mm_loadu_pd(rhs_linear + 3);
+    const __m128d b2 = _mm_loadu_pd(rhs_linear + 6);
+    const __m128d c0 = _mm_load_sd(rhs_linear + 2);
+    const __m128d c1 = _mm_load_sd(rhs_linear + 5);
+    const __m128d c2 = _mm_load_sd(rhs_linear + 8);
+
+    __m128d pairs[4];
+    __m128d lasts[4];
+
+    for (std::size_t r = 0; r < 4; ++r)
+    {
+        const double* a = r == 3 ? lhs_offset : lhs_linear + 3 * r;
+        const __m128d x = _mm_set1_pd(a[0]);
+        const __m128d y = _mm_set1_pd(a[1]);
+        const __m128d z = _mm_set1_pd(a[2]);
+        __m128d acc = r == 3 ? _mm_loadu_pd(rhs_offset) : _mm_setzero_pd();
+        __m128d last = r == 3 ? _mm_load_sd(rhs_offset + 2) : _mm_setzero_pd();
+        acc = madd(x, b0, acc);
+        last = madd(x, c0, last);
+        acc = madd(y, b1, acc);
+        last = madd(y, c1, last);
+        acc = madd(z, b2, acc);
+        last = madd(z, c2, last);
+        pairs[r] = acc;
+        lasts[r] = last;
+    }
+
+    _mm_storeu_pd(out_linear + 0, pairs[0]);
+    _mm_storeu_pd(out_linear + 2, _mm_unpacklo_pd(lasts[0], pairs[1]));
+    _mm_storeu_pd(out_linear + 4, _mm_shuffle_pd(pairs[1], lasts[1], 1));
+    _mm_storeu_pd(out_linear + 6, pairs[2]);
+    _mm_store_sd(out_linear + 8, lasts[2]);
+    _mm_storeu_pd(out_offset, pairs[3]);
+    _mm_store_sd(out_offset + 2, lasts[3]);
+}
+
+// Point-in-triangle test for a register of 2d points (x, y interleaved). `edges` holds, for each edge, its start
+// point and its delta broadcast across the register; each edge function is evaluated as in orientation().
+// Returns one bit per point, set when all three edge functions are >= 0 or all are <= 0.
+
+inline auto triangle_contains(const __m128 (&edges)[3][4], const float* points) -> int
+{
+    const __m128 p0 = _mm_loadu_ps(points + 0);
+    const __m128 p1 = _mm_loadu_ps(points + 4);
+    const __m128 x = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m128 y = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(3, 1, 3, 1));
+    const __m128 zero = _mm_setzero_ps();
+
+    __m128 non_negative = _mm_cmpeq_ps(zero, zero);
+    __m128 non_positive = non_negative;
+
+    for (const auto& edge : edges)
+    {
+        const __m128 value = _mm_sub_ps(
+            _mm_mul_ps(edge[2], _mm_sub_ps(y, edge[1])),  //
+            _mm_mul_ps(edge[3], _mm_sub_ps(x, edge[0])));
+        non_negative = _mm_and_ps(non_negative, _mm_cmpge_ps(value, zero));
+        non_positive = _mm_and_ps(non_positive, _mm_cmple_ps(value, zero));
+    }
+
+    return _mm_movemask_ps(_mm_or_ps(non_negative, non_positive));
+}
+
+inline auto triangle_contains(const __m128d (&edges)[3][4], const double* points) -> int
+{
+    const __m128d p0 = _mm_loadu_pd(points + 0);
+    const __m128d p1 = _mm_loadu_pd(points + 2);
+    const __m128d x = _mm_unpacklo_pd(p0, p1);
+    const __m128d y = _mm_unpackhi_pd(p0, p1);
+    const __m128d zero = _mm_setzero_pd();
+
+    __m128d non_negative = _mm_cmpeq_pd(zero, zero);
+    __m128d non_positive = non_negative;
+
+    for (const auto& edge : edges)
+    {
+        const __m128d value = _mm_sub_pd(
+            _mm_mul_pd(edge[2], _mm_sub_pd(y, edge[1])),  //
+            _mm_mul_pd(edge[3], _mm_sub_pd(x, edge[0])));
+        non_negative = _mm_and_pd(non_negative, _mm_cmpge_pd(value, zero));
+        non_positive = _mm_and_pd(non_positive, _mm_cmple_pd(value, zero));
+    }
+
+    return _mm_movemask_pd(_mm_or_pd(non_negative, non_positive));
+}
+
+// Intersects one register of segments, stored as consecutive (x0, y0, x1, y1), with a query line given as broadcast
+// { x, y, dx, dy, lower x, lower y, upper x, upper y, lower parameter, upper parameter, epsilon }. Segments whose
+// bounding box misses the query bounds are rejected before solving; the solve follows
+// get_line_intersection_parameters operation by operation. Returns bit i set for each intersected segment i, with
+// params[i] its parameter along the query.
+inline auto segment_intersections(const __m128 (&query)[11], const float* segments, float* params) -> int
+{
+    __m128 x0 = _mm_loadu_ps(segments + 0);
+    __m128 y0 = _mm_loadu_ps(segments + 4);
+    __m128 x1 = _mm_loadu_ps(segments + 8);
+    __m128 y1 = _mm_loadu_ps(segments + 12);
+    _MM_TRANSPOSE4_PS(x0, y0, x1, y1);
+
+    const __m128 overlap = _mm_and_ps(
+        _mm_and_ps(_mm_cmple_ps(_mm_min_ps(x0, x1), query[6]), _mm_cmpge_ps(_mm_max_ps(x0, x1), query[4])),
+        _mm_and_ps(_mm_cmple_ps(_mm_min_ps(y0, y1), query[7]), _mm_cmpge_ps(_mm_max_ps(y0, y1), query[5])));
+
+    if (_mm_movemask_ps(overlap) == 0)
+    {
+        return 0;
+    }
+
+    const __m128 dx = _mm_sub_ps(x1, x0);
+    const __m128 dy = _mm_sub_ps(y1, y0);
+    const __m128 vx = _mm_sub_ps(x0, query[0]);
+    const __m128 vy = _mm_sub_ps(y0, query[1]);
+
+    const __m128 det = _mm_sub_ps(_mm_mul_ps(query[2], dy), _mm_mul_ps(query[3], dx));
+    const __m128 a = _mm_div_ps(_mm_sub_ps(_mm_mul_ps(vx, dy), _mm_mul_ps(vy, dx)), det);
+    const __m128 b = _mm_div_ps(_mm_sub_ps(_mm_mul_ps(vx, query[3]), _mm_mul_ps(vy, query[2])), det);
+
+    const __m128 abs_det = _mm_andnot_ps(_mm_set1_ps(-0.F), det);
+    const __m128 in_a = _mm_and_ps(_mm_cmpge_ps(a, query[8]), _mm_cmple_ps(a, query[9]));
+    const __m128 in_b = _mm_and_ps(_mm_cmpge_ps(b, _mm_setzero_ps()), _mm_cmple_ps(b, _mm_set1_ps(1.F)));
+
+    _mm_storeu_ps(params, a);
+
+    return _mm_movemask_ps(_mm_and_ps(_mm_and_ps(overlap, _mm_cmpge_ps(abs_det, query[10])), _mm_and_ps(in_a, in_b)));
+}
+
+inline auto segment_intersections(const __m128d (&query)[11], const double* segments, double* params) -> int
+{
+    const __m128d s0 = _mm_loadu_pd(segments + 0);
+    const __m128d s1 = _mm_loadu_pd(segments + 2);
+    const __m128d s2 = _mm_loadu_pd(segments + 4);
+    const __m128d s3 = _mm_loadu_pd(segments + 6);
+    const __m128d x0 = _mm_unpacklo_pd(s0, s2);
+    const __m128d y0 = _mm_unpackhi_pd(s0, s2);
+    const __m128d x1 = _mm_unpacklo_pd(s1, s3);
+    const __m128d y1 = _mm_unpackhi_pd(s1, s3);
+
+    const __m128d overlap = _mm_and_pd(
+        _mm_and_pd(_mm_cmple_pd(_mm_min_pd(x0, x1), query[6]), _mm_cmpge_pd(_mm_max_pd(x0, x1), query[4])),
+        _mm_and_pd(_mm_cmple_pd(_mm_min_pd(y0, y1), query[7]), _mm_cmpge_pd(_mm_max_pd(y0, y1), query[5])));
+
+    if (_mm_movemask_pd(overlap) == 0)
+    {
+        return 0;
+    }
+
+    const __m128d dx = _mm_sub_pd(x1, x0);
+    const __m128d dy = _mm_sub_pd(y1, y0);
+    const __m128d vx = _mm_sub_pd(x0, query[0]);
+    const __m128d vy = _mm_sub_pd(y0, query[1]);
+
+    const __m128d det = _mm_sub_pd(_mm_mul_pd(query[2], dy), _mm_mul_pd(query[3], dx));
+    const __m128d a = _mm_div_pd(_mm_sub_pd(_mm_mul_pd(vx, dy), _mm_mul_pd(vy, dx)), det);
+    const __m128d b = _mm_div_pd(_mm_sub_pd(_mm_mul_pd(vx, query[3]), _mm_mul_pd(vy, query[2])), det);
+
+    const __m128d abs_det = _mm_andnot_pd(_mm_set1_pd(-0.0), det);
+    const __m128d in_a = _mm_and_pd(_mm_cmpge_pd(a, query[8]), _mm_cmple_pd(a, query[9]));
+    const __m128d in_b = _mm_and_pd(_mm_cmpge_pd(b, _mm_setzero_pd()), _mm_cmple_pd(b, _mm_set1_pd(1.0)));
+
+    _mm_storeu_pd(params, a);
+
+    return _mm_movemask_pd(_mm_and_pd(_mm_and_pd(overlap, _mm_cmpge_pd(abs_det, query[10])), _mm_and_pd(in_a, in_b)));
+}
+
+inline __m128 load(const float* p)
+{
+    return _mm_loadu_ps(p);
+}
+
+inline __m128d load(const double* p)
+{
+    return _mm_loadu_pd(p);
+}
+
+inline void store(float* p, __m128 v)
+{
+    _mm_storeu_ps(p, v);
+}
+
+inline void store(double* p, __m128d v)
+{
+    _mm_storeu_pd(p, v);
+}
+
+inline __m128 broadcast(float v)
+{
+    return _mm_set1_ps(v);
+}
+
+inline __m128d broadcast(double v)
+{
+    return _mm_set1_pd(v);
+}
+
+// Transforms points stored as D separate coordinate lanes (structure of arrays) by a homogeneous (D+1)x(D+1)
+// matrix, one register of points at a time. All input lanes of a register are loaded before any output is
+// stored, so `out` may alias `in`. Returns the number of points processed; the caller handles the remainder.
+template <class T, std::size_t D>
+auto transform_lanes(
+    const std::array<const T*, D>& in, const std::array<T*, D>& out, std::size_t n, const square_matrix<T, D + 1>& m)
+    -> std::size_t
+{
+    using reg = decltype(broadcast(T{}));
+
+    constexpr std::size_t width = sizeof(reg) / sizeof(T);
+
+    reg coef[D + 1][D];
+    for (std::size_t r = 0; r <= D; ++r)
+    {
+        for (std::size_t c = 0; c < D; ++c)
+        {
+            coef[r][c] = broadcast(m(r, c));
+        }
+    }
+
+    std::size_t i = 0;
+
+    for (; i + width <= n; i += width)
+    {
+        reg p[D];
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            p[d] = load(in[d] + i);
+        }
+
+        for (std::size_t c = 0; c < D; ++c)
+        {
+            reg acc = coef[D][c];
+            for (std::size_t r = 0; r < D; ++r)
+            {
+                acc = madd(p[r], coef[r][c], acc);
+            }
+            store(out[c] + i, acc);
+        }
+    }
+
+    return i;
+}
+
+// Register tile of the blocked dynamic product: acc (MR x NR, row-major) = sum_p a[p * MR + r] * b[p * NR + c]
+// over packed panels of depth kc. The NR columns span several registers, which stay live across the whole panel.
+template <class T, std::size_t MR, std::size_t NR>
+void product_tile(const T* a, const T* b, std::size_t kc, T* acc)
+{
+    using reg = decltype(broadcast(T{}));
+
+    constexpr std::size_t width = sizeof(reg) / sizeof(T);
+    constexpr std::size_t regs = NR / width;
+
+    static_assert(NR % width == 0);
+
+    reg c[MR][regs];
+    for (std::size_t r = 0; r < MR; ++r)
+    {
+        for (std::size_t j = 0; j < regs; ++j)
+        {
+            c[r][j] = broadcast(T{});
+        }
+    }
+
+    for (std::size_t p = 0; p < kc; ++p, a += MR, b += NR)
+    {
+        reg row[regs];
+        for (std::size_t j = 0; j < regs; ++j)
+        {
+            row[j] = load(b + j * width);
+        }
+
+        for (std::size_t r = 0; r < MR; ++r)
+        {
+            const reg value = broadcast(a[r]);
+            for (std::size_t j = 0; j < regs; ++j)
+            {
+                c[r][j] = madd(value, row[j], c[r][j]);
+            }
+        }
+    }
+
+    for (std::size_t r = 0; r < MR; ++r)
+    {
+        for (std::size_t j = 0; j < regs; ++j)
+        {
+            store(acc + r * NR + j * width, c[r][j]);
+        }
+    }
+}
+
+template <class T, std::size_t D>
+auto product(const square_matrix<T, D>& lhs, const square_matrix<T, D>& rhs) -> square_matrix<T, D>
+{
+    square_matrix<T, D> result{ raw };
+    if constexpr (D == 4)
+    {
+        product_4x4(lhs.m_data.data(), rhs.m_data.data(), result.m_data.data());
+    }
+    else
+    {
+        product_3x3(lhs.m_data.data(), rhs.m_data.data(), result.m_data.data());
+    }
+    return result;
+}
+
+template <class T>
+auto transform(const vector_3d<T>& lhs, const square_matrix_3d<T>& rhs) -> vector_3d<T>
+{
+    vector_3d<T> result{ raw };
+    transform_3d(lhs.m_data.data(), rhs.m_data.data(), result.m_data.data());
+    return result;
+}
+
+#endif
+
+}  // namespace simd
+}  // namespace detail
+}  // namespace alg
+}  // namespace ferrugo
@@ -6,8 +6,14 @@
 #include <ferrugo/alg/math.hpp>
 #include <ferrugo/alg/polygon.hpp>
 #include <ferrugo/alg/region.hpp>
+#include <ferrugo/alg/span.hpp>
+#include <bitset>
+#include <cstdint>
+#include <limits>
 #include <numeric>
 #include <optional>
+#include <stdexcept>
+#include <vector>
 
 namespace ferrugo
 {
@@ -70,25 +76,6 @@ struct cross_fn
 
 static constexpr inline auto cross = cross_fn{};
 
-struct angle_fn
-{
-    template <class T>
-    auto operator()(const vector_2d<T>& lhs, const vector_2d<T>& rhs) const
-        -> decltype(atan2(cross(lhs, rhs), dot(lhs, rhs)))
-    {
-        return atan2(cross(lhs, rhs), dot(lhs, rhs));
-    }
-
-    template <class T>
-    auto operator()(const vector_3d<T>& lhs, const vector_3d<T>& rhs) const
-        -> decltype(acos(dot(lhs, rhs) / (length(lhs) * length(rhs))))
-    {
-        return acos(dot(lhs, rhs) / (length(lhs) * length(rhs)));
-    }
-};
-
-static constexpr inline auto angle = angle_fn{};
-
 struct norm_fn
 {
     template <class T, std::size_t D, class Res = std::invoke_result_t<std::multiplies<>, T, T>>
@@ -100,12 +87,13 @@ struct norm_fn
 
 static constexpr inline auto norm = norm_fn{};
 
+template <class Policy = precise_math>
 struct length_fn
 {
     template <class T, std::size_t D>
-    auto operator()(const vector<T, D>& item) const -> decltype(sqrt(norm(item)))
+    auto operator()(const vector<T, D>& item) const -> decltype(Policy::sqrt(norm(item)))
     {
-        return sqrt(norm(item));
+        return Policy::sqrt(norm(item));
     }
 
     template <class T, std::size_t D>
@@ -115,19 +103,41 @@ struct length_fn
     }
 };
 
-static constexpr inline auto length = length_fn{};
+static constexpr inline auto length = length_fn<>{};
+
+template <class Policy = precise_math>
+struct angle_fn
+{
+    template <class T>
+    auto operator()(const vector_2d<T>& lhs, const vector_2d<T>& rhs) const
+        -> decltype(Policy::atan2(cross(lhs, rhs), dot(lhs, rhs)))
+    {
+        return Policy::atan2(cross(lhs, rhs), dot(lhs, rhs));
+    }
 
+    template <class T>
+    auto operator()(const vector_3d<T>& lhs, const vector_3d<T>& rhs) const
+        -> decltype(Policy::acos(dot(lhs, rhs) / (length_fn<Policy>{}(lhs) * length_fn<Policy>{}(rhs))))
+    {
+        constexpr auto length = length_fn<Policy>{};
+        return Policy::acos(dot(lhs, rhs) / (length(lhs) * length(rhs)));
+    }
+};
+
+static constexpr inline auto angle = angle_fn<>{};
+
+template <class Policy = precise_math>
 struct unit_fn
 {
     template <
         class T,
         std::size_t D,
         class Sqr = std::invoke_result_t<std::multiplies<>, T, T>,
-        class Sqrt = decltype(sqrt(std::declval<Sqr>())),
+        class Sqrt = decltype(Policy::sqrt(std::declval<Sqr>())),
         class Res = std::invoke_result_t<std::divides<>, T, Sqrt>>
     auto operator()(const vector<T, D>& item) const -> vector<Res, D>
     {
-        const auto len = length(item);
+        const auto len = length_fn<Policy>{}(item);
         if (!len)
         {
             return item;
@@ -136,7 +146,7 @@ struct unit_fn
     }
 };
 
-static constexpr inline auto unit = unit_fn{};
+static constexpr inline auto unit = unit_fn<>{};
 
 struct distance_fn
 {
@@ -285,6 +295,454 @@ struct orientation_fn
 
 static constexpr inline auto orientation = orientation_fn{};
 
+// Number of 64-bit words in a bitmask with one bit per item.
+constexpr auto bitmask_words(std::size_t count) -> std::size_t
+{
+    return (count + 63) / 64;
+}
+
+template <class T>
+struct nondeduced
+{
+    using type = T;
+};
+
+template <class T>
+using nondeduced_t = typename nondeduced<T>::type;
+
+inline auto count_trailing_zeros(std::uint64_t word) -> std::size_t
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<std::size_t>(__builtin_ctzll(word));
+#else
+    std::size_t result = 0;
+    for (; (word & 1) == 0; word >>= 1)
+    {
+        ++result;
+    }
+    return result;
+#endif
+}
+
+// Appends first + i for each bit i set in `word`.
+inline void append_indices(std::uint64_t word, std::size_t first, std::vector<std::size_t>& out)
+{
+    for (; word != 0; word &= word - 1)
+    {
+        out.push_back(first + count_trailing_zeros(word));
+    }
+}
+
+// Edge functions of a 2d triangle, evaluated exactly as orientation(point, start, end), so that the batched tests
+// agree with contains(triangle, point).
+template <class T>
+class triangle_edges
+{
+public:
+    explicit triangle_edges(const triangle<T, 2>& item)
+    {
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            const auto& start = item[i];
+            const auto delta = item[(i + 1) % 3] - start;
+            m_edges[i] = { start[0], start[1], delta[0], delta[1] };
+        }
+    }
+
+    auto contains(const vector_2d<T>& point) const -> bool
+    {
+        bool non_negative = true;
+        bool non_positive = true;
+
+        for (const auto& [x, y, dx, dy] : m_edges)
+        {
+            const T value = dx * (point[1] - y) - dy * (point[0] - x);
+            non_negative &= value >= T{};
+            non_positive &= value <= T{};
+        }
+
+        return non_negative || non_positive;
+    }
+
+    // Sets bit i % 64 of mask[i / 64] for each contained points[i]; other bits are left untouched.
+    void contains(const vector_2d<T>* points, std::size_t count, std::uint64_t* mask) const
+    {
+        std::size_t i = 0;
+
+#if FERRUGO_ALG_SIMD
+        if constexpr (simd::is_simd_type_v<T>)
+        {
+            static_assert(sizeof(vector_2d<T>) == 2 * sizeof(T));
+
+            using reg = decltype(simd::broadcast(T{}));
+
+            constexpr std::size_t width = sizeof(reg) / sizeof(T);
+
+            reg edges[3][4];
+            for (std::size_t e = 0; e < 3; ++e)
+            {
+                for (std::size_t c = 0; c < 4; ++c)
+                {
+                    edges[e][c] = simd::broadcast(m_edges[e][c]);
+                }
+            }
+
+            const T* data = reinterpret_cast<const T*>(points);
+
+            for (; i + width <= count; i += width)
+            {
+                const auto bits = static_cast<std::uint64_t>(simd::triangle_contains(edges, data + 2 * i));
+                mask[i / 64] |= bits << (i % 64);
+            }
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            mask[i / 64] |= static_cast<std::uint64_t>(contains(points[i])) << (i % 64);
+        }
+    }
+
+private:
+    std::array<std::array<T, 4>, 3> m_edges;
+};
+
+struct bounds_fn
+{
+    template <class T>
+    auto operator()(const polygon<T>& item) const -> region_2d<T>
+    {
+        return compute(item.data(), item.size());
+    }
+
+    template <class T, std::size_t D, std::size_t N>
+    auto operator()(const polygon_base<T, D, N>& item) const -> region<T, D>
+    {
+        return compute(item.data(), N);
+    }
+
+private:
+    template <class T, std::size_t D>
+    static auto compute(const vector<T, D>* vertices, std::size_t count) -> region<T, D>
+    {
+        if (count == 0)
+        {
+            throw std::runtime_error{ "bounds: empty polygon" };
+        }
+
+        vector<T, D> lo = vertices[0];
+        vector<T, D> up = vertices[0];
+
+        for (std::size_t i = 1; i < count; ++i)
+        {
+            for (std::size_t d = 0; d < D; ++d)
+            {
+                lo[d] = std::min(lo[d], vertices[i][d]);
+                up[d] = std::max(up[d], vertices[i][d]);
+            }
+        }
+
+        region<T, D> result{};
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            result[d] = interval<T>{ lo[d], up[d] };
+        }
+        return result;
+    }
+};
+
+static constexpr inline auto bounds = bounds_fn{};
+
+struct signed_area_fn
+{
+    template <class T>
+    using result_type = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+
+    template <class T>
+    auto operator()(const polygon<T>& item) const -> result_type<T>
+    {
+        return compute(item.data(), item.size());
+    }
+
+    template <class T, std::size_t N>
+    auto operator()(const polygon_base<T, 2, N>& item) const -> result_type<T>
+    {
+        return compute(item.data(), N);
+    }
+
+private:
+    // Shoelace formula relative to the first vertex, which keeps the products small for polygons far from the origin.
+    template <class T>
+    static auto compute(const vector_2d<T>* vertices, std::size_t count) -> result_type<T>
+    {
+        using Res = result_type<T>;
+
+        if (count < 3)
+        {
+            return Res{};
+        }
+
+        const vector_2d<Res> origin = vertices[0];
+        Res sum{};
+
+        for (std::size_t i = 1; i + 1 < count; ++i)
+        {
+            sum += cross(vector_2d<Res>{ vertices[i] } - origin, vector_2d<Res>{ vertices[i + 1] } - origin);
+        }
+
+        return sum / 2;
+    }
+};
+
+static constexpr inline auto signed_area = signed_area_fn{};
+
+struct perimeter_fn
+{
+    template <class T>
+    auto operator()(const polygon<T>& item) const
+    {
+        return compute(item.data(), item.size());
+    }
+
+    template <class T, std::size_t D, std::size_t N>
+    auto operator()(const polygon_base<T, D, N>& item) const
+    {
+        return compute(item.data(), N);
+    }
+
+private:
+    template <class T, std::size_t D>
+    static auto compute(const vector<T, D>* vertices, std::size_t count) -> decltype(length(vertices[0]))
+    {
+        decltype(length(vertices[0])) result{};
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            result += length(vertices[(i + 1) % count] - vertices[i]);
+        }
+
+        return result;
+    }
+};
+
+static constexpr inline auto perimeter = perimeter_fn{};
+
+// Contribution of the edge from `start` to `end` to the winding number of `point` (Sunday's rule): +1 if the edge goes
+// upwards with the point on its left, -1 if it goes downwards with the point on its right. Each edge covers the
+// half-open y range [min y, max y), so a vertex is counted once and horizontal edges never count.
+template <class T, class U>
+auto winding_contribution(const vector_2d<U>& point, const vector_2d<T>& start, const vector_2d<T>& end) -> int
+{
+    if (start[1] <= point[1])
+    {
+        if (point[1] < end[1] && orientation(point, start, end) > 0)
+        {
+            return +1;
+        }
+    }
+    else if (end[1] <= point[1] && orientation(point, start, end) < 0)
+    {
+        return -1;
+    }
+    return 0;
+}
+
+// Polygon preprocessed for repeated containment queries. The non-horizontal edges are stored (start point and delta)
+// in a centered interval tree over their y ranges, so that a query visits O(log n) nodes and only the k edges crossing
+// the horizontal line through the point, instead of all n edges. Results are identical to winding_number(polygon, p).
+template <class T>
+class prepared_polygon
+{
+public:
+    explicit prepared_polygon(const polygon<T>& item) : m_bounds{}, m_size(item.size())
+    {
+        if (item.empty())
+        {
+            return;
+        }
+
+        m_bounds = alg::detail::bounds(item);
+
+        std::vector<edge> edges;
+        edges.reserve(item.size());
+
+        for (std::size_t i = 0; i < item.size(); ++i)
+        {
+            const auto& start = item[i];
+            const auto& end = item[(i + 1) % item.size()];
+
+            if (start[1] != end[1])
+            {
+                const auto delta = end - start;
+                edges.push_back(
+                    edge{ start[0], start[1], delta[0], delta[1], std::min(start[1], end[1]), std::max(start[1], end[1]) });
+            }
+        }
+
+        m_by_lower.reserve(edges.size());
+        m_by_upper.reserve(edges.size());
+        build(std::move(edges));
+    }
+
+    // Number of vertices of the original polygon.
+    auto size() const -> std::size_t
+    {
+        return m_size;
+    }
+
+    auto bounds() const -> const region_2d<T>&
+    {
+        return m_bounds;
+    }
+
+    template <class U>
+    auto winding_number(const vector_2d<U>& point) const -> int
+    {
+        if (m_nodes.empty() || point[0] > upper(m_bounds[0]))
+        {
+            return 0;
+        }
+
+        int result = 0;
+
+        for (std::size_t index = 0; index != npos;)
+        {
+            const node& current = m_nodes[index];
+            const std::size_t last = current.first + current.count;
+
+            if (point[1] < current.center)
+            {
+                for (std::size_t i = current.first; i < last && m_by_lower[i].lower <= point[1]; ++i)
+                {
+                    result += m_by_lower[i].contribution(point);
+                }
+                index = current.left;
+            }
+            else
+            {
+                for (std::size_t i = current.first; i < last && point[1] < m_by_upper[i].upper; ++i)
+                {
+                    result += m_by_upper[i].contribution(point);
+                }
+                index = current.right;
+            }
+        }
+
+        return result;
+    }
+
+private:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    struct edge
+    {
+        T x;
+        T y;
+        T dx;
+        T dy;
+        T lower;
+        T upper;
+
+        // Same as winding_contribution for a point within [lower, upper).
+        template <class U>
+        auto contribution(const vector_2d<U>& point) const -> int
+        {
+            const auto value = dx * (point[1] - y) - dy * (point[0] - x);
+            return dy > 0 ? int(value > 0) : -int(value < 0);
+        }
+    };
+
+    // Edges with lower <= center < upper, stored twice: ascending by lower and descending by upper.
+    struct node
+    {
+        T center;
+        std::size_t first;
+        std::size_t count;
+        std::size_t left;
+        std::size_t right;
+    };
+
+    auto build(std::vector<edge> edges) -> std::size_t
+    {
+        if (edges.empty())
+        {
+            return npos;
+        }
+
+        const auto median = edges.begin() + static_cast<std::ptrdiff_t>(edges.size() / 2);
+        std::nth_element(
+            edges.begin(), median, edges.end(), [](const edge& lhs, const edge& rhs) { return lhs.lower < rhs.lower; });
+        const T center = median->lower;
+
+        std::vector<edge> left;
+        std::vector<edge> right;
+        const std::size_t first = m_by_lower.size();
+
+        for (const edge& item : edges)
+        {
+            if (item.upper <= center)
+            {
+                left.push_back(item);
+            }
+            else if (center < item.lower)
+            {
+                right.push_back(item);
+            }
+            else
+            {
+                m_by_lower.push_back(item);
+                m_by_upper.push_back(item);
+            }
+        }
+
+        std::sort(
+            m_by_lower.begin() + static_cast<std::ptrdiff_t>(first),
+            m_by_lower.end(),
+            [](const edge& lhs, const edge& rhs) { return lhs.lower < rhs.lower; });
+        std::sort(
+            m_by_upper.begin() + static_cast<std::ptrdiff_t>(first),
+            m_by_upper.end(),
+            [](const edge& lhs, const edge& rhs) { return lhs.upper > rhs.upper; });
+
+        const std::size_t index = m_nodes.size();
+        m_nodes.push_back(node{ center, first, m_by_lower.size() - first, npos, npos });
+
+        const std::size_t left_index = build(std::move(left));
+        const std::size_t right_index = build(std::move(right));
+        m_nodes[index].left = left_index;
+        m_nodes[index].right = right_index;
+        return index;
+    }
+
+    region_2d<T> m_bounds;
+    std::size_t m_size;
+    std::vector<node> m_nodes;
+    std::vector<edge> m_by_lower;
+    std::vector<edge> m_by_upper;
+};
+
+struct winding_number_fn
+{
+    template <class T, class U>
+    auto operator()(const polygon<T>& item, const vector<U, 2>& point) const -> int
+    {
+        int result = 0;
+        for (std::size_t i = 0; i < item.size(); ++i)
+        {
+            result += winding_contribution(point, item[i], item[(i + 1) % item.size()]);
+        }
+        return result;
+    }
+
+    template <class T, class U>
+    auto operator()(const prepared_polygon<T>& item, const vector<U, 2>& point) const -> int
+    {
+        return item.winding_number(point);
+    }
+};
+
+static constexpr inline auto winding_number = winding_number_fn{};
+
 struct contains_fn
 {
     template <class T, class U>
@@ -314,6 +772,19 @@ struct contains_fn
         return true;
     }
 
+    template <class T, class U, std::size_t D>
+    auto operator()(const region<T, D>& item, const vector<U, D>& other) const -> bool
+    {
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            if (!(*this)(item[d], other[d]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
     template <class T, class U, std::size_t D>
     auto operator()(const circular_shape<T, D>& item, const vector<U, D>& other) const -> bool
     {
@@ -334,10 +805,114 @@ struct contains_fn
 
         return same_sign(result[0], result[1]) && same_sign(result[0], result[2]) && same_sign(result[1], result[2]);
     }
+
+    // Non-zero winding rule; points on an edge may be reported either way.
+    template <class T, class U>
+    auto operator()(const polygon<T>& item, const vector<U, 2>& other) const -> bool
+    {
+        return winding_number(item, other) != 0;
+    }
+
+    template <class T, class U>
+    auto operator()(const prepared_polygon<T>& item, const vector<U, 2>& other) const -> bool
+    {
+        return item.winding_number(other) != 0;
+    }
+
+    // Batched point-in-triangle tests. The bitmask forms set bit i % 64 of word i / 64 for each contained points[i]
+    // (see bitmask_words) and return the number of contained points.
+    template <class T>
+    auto operator()(const triangle<T, 2>& item, span<const vector_2d<nondeduced_t<T>>> points, span<std::uint64_t> mask)
+        const -> std::size_t
+    {
+        const std::size_t words = bitmask_words(points.size());
+
+        if (mask.size() < words)
+        {
+            throw std::runtime_error{ "contains: mask too small" };
+        }
+
+        std::fill(mask.begin(), mask.begin() + words, std::uint64_t{ 0 });
+        triangle_edges<T>{ item }.contains(points.data(), points.size(), mask.data());
+        return count_bits(mask.first(words));
+    }
+
+    // Row t of the mask (bitmask_words(points.size()) words starting at t * bitmask_words(points.size())) holds the
+    // points contained in items[t]. Points are processed in blocks that stay in L1 while all triangles are tested.
+    template <class T>
+    auto operator()(
+        span<const triangle<T, 2>> items, span<const vector_2d<nondeduced_t<T>>> points, span<std::uint64_t> mask) const
+        -> std::size_t
+    {
+        constexpr std::size_t block_size = 1024;
+
+        const std::size_t words = bitmask_words(points.size());
+
+        if (mask.size() < words * items.size())
+        {
+            throw std::runtime_error{ "contains: mask too small" };
+        }
+
+        std::fill(mask.begin(), mask.begin() + words * items.size(), std::uint64_t{ 0 });
+
+        std::vector<triangle_edges<T>> edges;
+        edges.reserve(items.size());
+        for (const auto& item : items)
+        {
+            edges.emplace_back(item);
+        }
+
+        for (std::size_t first = 0; first < points.size(); first += block_size)
+        {
+            const std::size_t count = std::min(block_size, points.size() - first);
+
+            for (std::size_t t = 0; t < edges.size(); ++t)
+            {
+                edges[t].contains(points.data() + first, count, mask.data() + t * words + first / 64);
+            }
+        }
+
+        return count_bits(mask.first(words * items.size()));
+    }
+
+private:
+    static auto count_bits(span<const std::uint64_t> words) -> std::size_t
+    {
+        std::size_t result = 0;
+        for (const auto word : words)
+        {
+            result += std::bitset<64>{ word }.count();
+        }
+        return result;
+    }
 };
 
 static constexpr inline auto contains = contains_fn{};
 
+struct contained_indices_fn
+{
+    // Appends the indices of the contained points to `indices`, in increasing order.
+    template <class T>
+    auto operator()(
+        const triangle<T, 2>& item, span<const vector_2d<nondeduced_t<T>>> points, std::vector<std::size_t>& indices) const
+        -> std::size_t
+    {
+        const triangle_edges<T> edges{ item };
+        const std::size_t initial_size = indices.size();
+
+        for (std::size_t first = 0; first < points.size(); first += 64)
+        {
+            std::uint64_t word = 0;
+            edges.contains(points.data() + first, std::min<std::size_t>(64, points.size() - first), &word);
+            append_indices(word, first, indices);
+        }
+
+        return indices.size() - initial_size;
+    }
+};
+
+static constexpr inline auto contained_indices = contained_indices_fn{};
+
 struct intersects_fn
 {
     template <class T>
@@ -459,7 +1034,7 @@ struct intersection_fn
 
         if (contains_param(Tag1{}, a) && contains_param(Tag2{}, b))
         {
-            return interpolate(a, lhs[0], lhs[1]);
+            return interpolate(a, lhs[1], lhs[0]);
         }
         return {};
     }
@@ -467,6 +1042,183 @@ struct intersection_fn
 
 static constexpr inline auto intersection = intersection_fn{};
 
+// Result of intersect_all: points[i] is the intersection with the segment at indices[i], in increasing index order.
+template <class T>
+struct intersection_hits
+{
+    std::vector<std::size_t> indices;
+    std::vector<vector_2d<T>> points;
+};
+
+template <class T>
+constexpr auto unbounded_lower() -> T
+{
+    if constexpr (std::numeric_limits<T>::has_infinity)
+    {
+        return -std::numeric_limits<T>::infinity();
+    }
+    else
+    {
+        return std::numeric_limits<T>::lowest();
+    }
+}
+
+template <class T>
+constexpr auto unbounded_upper() -> T
+{
+    if constexpr (std::numeric_limits<T>::has_infinity)
+    {
+        return std::numeric_limits<T>::infinity();
+    }
+    else
+    {
+        return std::numeric_limits<T>::max();
+    }
+}
+
+// Range of the parameters accepted by contains_param.
+template <class T>
+constexpr auto param_range(line_tag) -> std::array<T, 2>
+{
+    return { unbounded_lower<T>(), unbounded_upper<T>() };
+}
+
+template <class T>
+constexpr auto param_range(ray_tag) -> std::array<T, 2>
+{
+    return { T(0), unbounded_upper<T>() };
+}
+
+template <class T>
+constexpr auto param_range(segment_tag) -> std::array<T, 2>
+{
+    return { T(0), T(1) };
+}
+
+// Lower and upper corner of the box containing the points of a linear shape; rays and lines are unbounded along each
+// axis in which they extend.
+template <class Tag, class T>
+auto linear_bounds(const linear_shape<Tag, T, 2>& shape) -> std::array<vector_2d<T>, 2>
+{
+    std::array<vector_2d<T>, 2> result{ shape[0], shape[0] };
+
+    for (std::size_t d = 0; d < 2; ++d)
+    {
+        const T start = shape[0][d];
+        const T end = shape[1][d];
+
+        if constexpr (std::is_same_v<Tag, segment_tag>)
+        {
+            result[0][d] = std::min(start, end);
+            result[1][d] = std::max(start, end);
+        }
+        else
+        {
+            const bool line = std::is_same_v<Tag, line_tag>;
+            if (end < start || (line && start < end))
+            {
+                result[0][d] = unbounded_lower<T>();
+            }
+            if (start < end || (line && end < start))
+            {
+                result[1][d] = unbounded_upper<T>();
+            }
+        }
+    }
+
+    return result;
+}
+
+struct intersect_all_fn
+{
+    // Appends the segments intersected by `query` to `hits` and returns their number. Each hit agrees with
+    // intersection(query, segments[i], epsilon); segments whose bounding box misses the query are rejected without
+    // solving.
+    template <class Tag, class T, class E = T>
+    auto operator()(
+        const linear_shape<Tag, T, 2>& query,
+        span<const segment_2d<nondeduced_t<T>>> segments,
+        intersection_hits<T>& hits,
+        E epsilon = {}) const -> std::size_t
+    {
+        const std::size_t initial_size = hits.indices.size();
+        const auto bounds = linear_bounds(query);
+
+        const auto add_hit = [&](std::size_t index, T param)
+        {
+            hits.indices.push_back(index);
+            hits.points.push_back(interpolate(param, query[1], query[0]));
+        };
+
+        std::size_t i = 0;
+
+#if FERRUGO_ALG_SIMD
+        if constexpr (simd::is_simd_type_v<T>)
+        {
+            static_assert(sizeof(segment_2d<T>) == 4 * sizeof(T));
+
+            using reg = decltype(simd::broadcast(T{}));
+
+            constexpr std::size_t width = sizeof(reg) / sizeof(T);
+
+            const auto dir = query[1] - query[0];
+            const auto range = param_range<T>(Tag{});
+            const T values[11] = { query[0][0], query[0][1], dir[0],   dir[1],   bounds[0][0], bounds[0][1],
+                                   bounds[1][0], bounds[1][1], range[0], range[1], static_cast<T>(epsilon) };
+
+            reg lanes[11];
+            for (std::size_t j = 0; j < 11; ++j)
+            {
+                lanes[j] = simd::broadcast(values[j]);
+            }
+
+            const T* data = reinterpret_cast<const T*>(segments.data());
+            T params[width];
+
+            for (; i + width <= segments.size(); i += width)
+            {
+                for (int mask = simd::segment_intersections(lanes, data + 4 * i, params); mask != 0; mask &= mask - 1)
+                {
+                    const std::size_t lane = count_trailing_zeros(static_cast<std::uint64_t>(mask));
+                    add_hit(i + lane, params[lane]);
+                }
+            }
+        }
+#endif
+
+        for (; i < segments.size(); ++i)
+        {
+            const auto& item = segments[i];
+
+            if (std::max(item[0][0], item[1][0]) < bounds[0][0] || bounds[1][0] < std::min(item[0][0], item[1][0])
+                || std::max(item[0][1], item[1][1]) < bounds[0][1] || bounds[1][1] < std::min(item[0][1], item[1][1]))
+            {
+                continue;
+            }
+
+            const auto par = get_line_intersection_parameters(query[0], query[1], item[0], item[1], epsilon);
+
+            if (par && contains_param(Tag{}, std::get<0>(*par)) && contains_param(segment_tag{}, std::get<1>(*par)))
+            {
+                add_hit(i, std::get<0>(*par));
+            }
+        }
+
+        return hits.indices.size() - initial_size;
+    }
+
+    template <class Tag, class T, class E = T, class = std::enable_if_t<std::is_arithmetic_v<E>>>
+    auto operator()(const linear_shape<Tag, T, 2>& query, span<const segment_2d<nondeduced_t<T>>> segments, E epsilon = {})
+        const -> intersection_hits<T>
+    {
+        intersection_hits<T> result;
+        (*this)(query, segments, result, epsilon);
+        return result;
+    }
+};
+
+static constexpr inline auto intersect_all = intersect_all_fn{};
+
 struct projection_fn
 {
     template <class T, std::size_t D>
@@ -646,10 +1398,13 @@ static constexpr inline auto circumcircle = circumcircle_fn{};
 
 using detail::altitude;
 using detail::angle;
+using detail::bitmask_words;
+using detail::bounds;
 using detail::center;
 using detail::centroid;
 using detail::circumcenter;
 using detail::circumcircle;
+using detail::contained_indices;
 using detail::contains;
 using detail::cross;
 using detail::distance;
@@ -657,7 +1412,9 @@ using detail::dot;
 using detail::incenter;
 using detail::incircle;
 using detail::interpolate;
+using detail::intersect_all;
 using detail::intersection;
+using detail::intersection_hits;
 using detail::intersects;
 using detail::length;
 using detail::lower;
@@ -665,12 +1422,25 @@ using detail::max;
 using detail::min;
 using detail::norm;
 using detail::orthocenter;
+using detail::perimeter;
 using detail::perpendicular;
+using detail::prepared_polygon;
 using detail::projection;
 using detail::rejection;
+using detail::signed_area;
 using detail::size;
 using detail::unit;
 using detail::upper;
+using detail::winding_number;
+
+namespace fast
+{
+
+static constexpr inline auto angle = detail::angle_fn<fast_math>{};
+static constexpr inline auto length = detail::length_fn<fast_math>{};
+static constexpr inline auto unit = detail::unit_fn<fast_math>{};
+
+}  // namespace fast
 
 }  // namespace alg
 }  // namespace ferrugo
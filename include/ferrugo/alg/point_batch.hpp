@@ -0,0 +1,388 @@
+#pragma once
+
+#include <ferrugo/alg/matrix.hpp>
+#include <ferrugo/alg/span.hpp>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+namespace ferrugo
+{
+namespace alg
+{
+namespace detail
+{
+
+template <class T, std::size_t Alignment>
+struct aligned_allocator
+{
+    using value_type = T;
+
+    template <class U>
+    struct rebind
+    {
+        using other = aligned_allocator<U, Alignment>;
+    };
+
+    aligned_allocator() = default;
+
+    template <class U>
+    aligned_allocator(const aligned_allocator<U, Alignment>&)
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ Alignment }));
+    }
+
+    void deallocate(T* ptr, std::size_t)
+    {
+        ::operator delete(ptr, std::align_val_t{ Alignment });
+    }
+
+    friend bool operator==(const aligned_allocator&, const aligned_allocator&)
+    {
+        return true;
+    }
+
+    friend bool operator!=(const aligned_allocator&, const aligned_allocator&)
+    {
+        return false;
+    }
+};
+
+}  // namespace detail
+
+// Structure-of-arrays storage for points: one contiguous, 64-byte aligned lane per coordinate.
+template <class T, std::size_t D>
+class point_batch
+{
+public:
+    static constexpr std::size_t alignment = 64;
+
+    using lane_type = std::vector<T, detail::aligned_allocator<T, alignment>>;
+    using value_type = vector<T, D>;
+    using size_type = std::size_t;
+
+    point_batch() = default;
+
+    explicit point_batch(size_type size)
+    {
+        resize(size);
+    }
+
+    size_type size() const
+    {
+        return m_lanes[0].size();
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    void resize(size_type size)
+    {
+        for (auto& lane : m_lanes)
+        {
+            lane.resize(size);
+        }
+    }
+
+    void reserve(size_type size)
+    {
+        for (auto& lane : m_lanes)
+        {
+            lane.reserve(size);
+        }
+    }
+
+    void clear()
+    {
+        for (auto& lane : m_lanes)
+        {
+            lane.clear();
+        }
+    }
+
+    void push_back(const value_type& item)
+    {
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            m_lanes[d].push_back(item[d]);
+        }
+    }
+
+    value_type operator[](size_type index) const
+    {
+        value_type result{ detail::raw };
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            result[d] = m_lanes[d][index];
+        }
+        return result;
+    }
+
+    void set(size_type index, const value_type& item)
+    {
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            m_lanes[d][index] = item[d];
+        }
+    }
+
+    span<T> lane(std::size_t d)
+    {
+        return span<T>{ m_lanes[d].data(), size() };
+    }
+
+    span<const T> lane(std::size_t d) const
+    {
+        return span<const T>{ m_lanes[d].data(), size() };
+    }
+
+    span<T> x()
+    {
+        return lane(0);
+    }
+
+    span<const T> x() const
+    {
+        return lane(0);
+    }
+
+    template <std::size_t D_ = D, class = std::enable_if_t<(D_ >= 2)>>
+    span<T> y()
+    {
+        return lane(1);
+    }
+
+    template <std::size_t D_ = D, class = std::enable_if_t<(D_ >= 2)>>
+    span<const T> y() const
+    {
+        return lane(1);
+    }
+
+    template <std::size_t D_ = D, class = std::enable_if_t<(D_ >= 3)>>
+    span<T> z()
+    {
+        return lane(2);
+    }
+
+    template <std::size_t D_ = D, class = std::enable_if_t<(D_ >= 3)>>
+    span<const T> z() const
+    {
+        return lane(2);
+    }
+
+private:
+    std::array<lane_type, D> m_lanes;
+};
+
+template <class T>
+using point_batch_2d = point_batch<T, 2>;
+
+template <class T>
+using point_batch_3d = point_batch<T, 3>;
+
+namespace detail
+{
+
+struct to_batch_fn
+{
+    template <class T, std::size_t D>
+    auto operator()(span<const vector<T, D>> points) const -> point_batch<T, D>
+    {
+        point_batch<T, D> result{ points.size() };
+
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            T* lane = result.lane(d).data();
+
+            for (std::size_t i = 0; i < points.size(); ++i)
+            {
+                lane[i] = points[i][d];
+            }
+        }
+
+        return result;
+    }
+
+    template <class T, std::size_t D>
+    auto operator()(const std::vector<vector<T, D>>& points) const -> point_batch<T, D>
+    {
+        return (*this)(span<const vector<T, D>>{ points });
+    }
+};
+
+static constexpr inline auto to_batch = to_batch_fn{};
+
+struct to_points_fn
+{
+    template <class T, std::size_t D>
+    void operator()(const point_batch<T, D>& batch, span<vector<T, D>> out) const
+    {
+        if (out.size() != batch.size())
+        {
+            throw std::runtime_error{ "to_points: size mismatch" };
+        }
+
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            const T* lane = batch.lane(d).data();
+
+            for (std::size_t i = 0; i < batch.size(); ++i)
+            {
+                out[i][d] = lane[i];
+            }
+        }
+    }
+
+    template <class T, std::size_t D>
+    auto operator()(const point_batch<T, D>& batch) const -> std::vector<vector<T, D>>
+    {
+        std::vector<vector<T, D>> result(batch.size());
+        (*this)(batch, span<vector<T, D>>{ result });
+        return result;
+    }
+};
+
+static constexpr inline auto to_points = to_points_fn{};
+
+struct transform_points_fn
+{
+    // out = batch * m; `out` may be `batch` itself.
+    template <class T, class U, std::size_t D>
+    void operator()(const point_batch<T, D>& batch, const square_matrix<U, D + 1>& m, point_batch<T, D>& out) const
+    {
+        const std::size_t n = batch.size();
+        out.resize(n);
+
+        std::array<const T*, D> in_lanes;
+        std::array<T*, D> out_lanes;
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            in_lanes[d] = batch.lane(d).data();
+            out_lanes[d] = out.lane(d).data();
+        }
+
+        const square_matrix<T, D + 1> coef{ m };
+
+        std::size_t i = 0;
+
+#if FERRUGO_ALG_SIMD
+        if constexpr (simd::is_simd_type_v<T>)
+        {
+            i = simd::transform_lanes(in_lanes, out_lanes, n, coef);
+        }
+#endif
+
+        for (; i < n; ++i)
+        {
+            std::array<T, D> p;
+            for (std::size_t d = 0; d < D; ++d)
+            {
+                p[d] = in_lanes[d][i];
+            }
+
+            for (std::size_t c = 0; c < D; ++c)
+            {
+                T sum = coef(D, c);
+                for (std::size_t r = 0; r < D; ++r)
+                {
+                    sum += p[r] * coef(r, c);
+                }
+                out_lanes[c][i] = sum;
+            }
+        }
+    }
+
+    template <class T, class U, std::size_t D>
+    auto operator()(const point_batch<T, D>& batch, const square_matrix<U, D + 1>& m) const -> point_batch<T, D>
+    {
+        point_batch<T, D> result{};
+        (*this)(batch, m, result);
+        return result;
+    }
+};
+
+static constexpr inline auto transform_points = transform_points_fn{};
+
+struct translate_points_fn
+{
+    template <class T, class U, std::size_t D>
+    auto operator()(point_batch<T, D>& batch, const vector<U, D>& offset) const -> point_batch<T, D>&
+    {
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            T* lane = batch.lane(d).data();
+            const T value = static_cast<T>(offset[d]);
+
+            for (std::size_t i = 0; i < batch.size(); ++i)
+            {
+                lane[i] += value;
+            }
+        }
+        return batch;
+    }
+};
+
+static constexpr inline auto translate_points = translate_points_fn{};
+
+struct scale_points_fn
+{
+    template <class T, class U, std::size_t D>
+    auto operator()(point_batch<T, D>& batch, const vector<U, D>& factors) const -> point_batch<T, D>&
+    {
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            T* lane = batch.lane(d).data();
+            const T value = static_cast<T>(factors[d]);
+
+            for (std::size_t i = 0; i < batch.size(); ++i)
+            {
+                lane[i] *= value;
+            }
+        }
+        return batch;
+    }
+};
+
+static constexpr inline auto scale_points = scale_points_fn{};
+
+}  // namespace detail
+
+using detail::scale_points;
+using detail::to_batch;
+using detail::to_points;
+using detail::transform_points;
+using detail::translate_points;
+
+template <class T, class U, std::size_t D>
+auto operator+=(point_batch<T, D>& lhs, const vector<U, D>& rhs) -> point_batch<T, D>&
+{
+    return translate_points(lhs, rhs);
+}
+
+template <class T, class U, std::size_t D>
+auto operator-=(point_batch<T, D>& lhs, const vector<U, D>& rhs) -> point_batch<T, D>&
+{
+    return translate_points(lhs, -rhs);
+}
+
+template <class T, class U, std::size_t D>
+auto operator*=(point_batch<T, D>& lhs, const square_matrix<U, D + 1>& rhs) -> point_batch<T, D>&
+{
+    transform_points(lhs, rhs, lhs);
+    return lhs;
+}
+
+template <class T, class U, std::size_t D>
+auto operator*(const point_batch<T, D>& lhs, const square_matrix<U, D + 1>& rhs) -> point_batch<T, D>
+{
+    return transform_points(lhs, rhs);
+}
+
+}  // namespace alg
+}  // namespace ferrugo
@@ -40,6 +40,32 @@ using triangle_2d = triangle<T, 2>;
 template <class T>
 using quad_2d = quad<T, 2>;
 
+static_assert(std::is_trivially_copyable_v<triangle<double, 3>> && std::is_standard_layout_v<triangle<double, 3>>);
+
+// 2d polygon with a runtime number of vertices in contiguous storage. The edge from the last vertex back to the first
+// is implicit; vertices in counter-clockwise order give a positive signed area.
+template <class T>
+struct polygon : std::vector<vector_2d<T>>
+{
+    using base_t = std::vector<vector_2d<T>>;
+    using base_t::base_t;
+
+    friend std::ostream& operator<<(std::ostream& os, const polygon& item)
+    {
+        os << "(";
+        for (std::size_t n = 0; n < item.size(); ++n)
+        {
+            if (n != 0)
+            {
+                os << " ";
+            }
+            os << item[n];
+        }
+        os << ")";
+        return os;
+    }
+};
+
 template <class T, class U, std::size_t D, std::size_t N>
 auto operator+=(polygon_base<T, D, N>& lhs, const vector<U, D>& rhs) -> polygon_base<T, D, N>&
 {
@@ -94,5 +120,105 @@ auto operator*(const square_matrix<U, D + 1>& lhs, const polygon_base<T, D, N>&
     return rhs * lhs;
 }
 
+template <class T, class U, std::size_t D, std::size_t N>
+auto operator*=(polygon_base<T, D, N>& lhs, const affine_transform<U, D>& rhs) -> polygon_base<T, D, N>&
+{
+    std::transform(
+        std::begin(lhs), std::end(lhs), std::begin(lhs), std::bind(std::multiplies<>{}, std::placeholders::_1, rhs));
+    return lhs;
+}
+
+template <class T, class U, std::size_t D, std::size_t N, class Res = std::invoke_result_t<std::plus<>, T, U>>
+auto operator*(const polygon_base<T, D, N>& lhs, const affine_transform<U, D>& rhs) -> polygon_base<Res, D, N>
+{
+    polygon_base<Res, D, N> result{};
+    std::transform(
+        std::begin(lhs), std::end(lhs), std::begin(result), std::bind(std::multiplies<>{}, std::placeholders::_1, rhs));
+    return result;
+}
+
+template <class T, class U, std::size_t D, std::size_t N, class Res = std::invoke_result_t<std::plus<>, T, U>>
+auto operator*(const affine_transform<U, D>& lhs, const polygon_base<T, D, N>& rhs) -> polygon_base<Res, D, N>
+{
+    return rhs * lhs;
+}
+
+template <class T, class U>
+auto operator+=(polygon<T>& lhs, const vector<U, 2>& rhs) -> polygon<T>&
+{
+    std::transform(std::begin(lhs), std::end(lhs), std::begin(lhs), std::bind(std::plus<>{}, std::placeholders::_1, rhs));
+    return lhs;
+}
+
+template <class T, class U, class Res = std::invoke_result_t<std::plus<>, T, U>>
+auto operator+(const polygon<T>& lhs, const vector<U, 2>& rhs) -> polygon<Res>
+{
+    polygon<Res> result(lhs.size());
+    std::transform(std::begin(lhs), std::end(lhs), std::begin(result), std::bind(std::plus<>{}, std::placeholders::_1, rhs));
+    return result;
+}
+
+template <class T, class U>
+auto operator-=(polygon<T>& lhs, const vector<U, 2>& rhs) -> polygon<T>&
+{
+    std::transform(std::begin(lhs), std::end(lhs), std::begin(lhs), std::bind(std::minus<>{}, std::placeholders::_1, rhs));
+    return lhs;
+}
+
+template <class T, class U, class Res = std::invoke_result_t<std::minus<>, T, U>>
+auto operator-(const polygon<T>& lhs, const vector<U, 2>& rhs) -> polygon<Res>
+{
+    polygon<Res> result(lhs.size());
+    std::transform(
+        std::begin(lhs), std::end(lhs), std::begin(result), std::bind(std::minus<>{}, std::placeholders::_1, rhs));
+    return result;
+}
+
+template <class T, class U>
+auto operator*=(polygon<T>& lhs, const square_matrix<U, 3>& rhs) -> polygon<T>&
+{
+    std::transform(
+        std::begin(lhs), std::end(lhs), std::begin(lhs), std::bind(std::multiplies<>{}, std::placeholders::_1, rhs));
+    return lhs;
+}
+
+template <class T, class U, class Res = std::invoke_result_t<std::plus<>, T, U>>
+auto operator*(const polygon<T>& lhs, const square_matrix<U, 3>& rhs) -> polygon<Res>
+{
+    polygon<Res> result(lhs.size());
+    std::transform(
+        std::begin(lhs), std::end(lhs), std::begin(result), std::bind(std::multiplies<>{}, std::placeholders::_1, rhs));
+    return result;
+}
+
+template <class T, class U, class Res = std::invoke_result_t<std::plus<>, T, U>>
+auto operator*(const square_matrix<U, 3>& lhs, const polygon<T>& rhs) -> polygon<Res>
+{
+    return rhs * lhs;
+}
+
+template <class T, class U>
+auto operator*=(polygon<T>& lhs, const affine_transform<U, 2>& rhs) -> polygon<T>&
+{
+    std::transform(
+        std::begin(lhs), std::end(lhs), std::begin(lhs), std::bind(std::multiplies<>{}, std::placeholders::_1, rhs));
+    return lhs;
+}
+
+template <class T, class U, class Res = std::invoke_result_t<std::plus<>, T, U>>
+auto operator*(const polygon<T>& lhs, const affine_transform<U, 2>& rhs) -> polygon<Res>
+{
+    polygon<Res> result(lhs.size());
+    std::transform(
+        std::begin(lhs), std::end(lhs), std::begin(result), std::bind(std::multiplies<>{}, std::placeholders::_1, rhs));
+    return result;
+}
+
+template <class T, class U, class Res = std::invoke_result_t<std::plus<>, T, U>>
+auto operator*(const affine_transform<U, 2>& lhs, const polygon<T>& rhs) -> polygon<Res>
+{
+    return rhs * lhs;
+}
+
 }  // namespace alg
 }  // namespace ferrugo
\ No newline at end of file
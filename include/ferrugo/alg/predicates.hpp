@@ -0,0 +1,493 @@
+#pragma once
+
+#include <ferrugo/alg/linear_shapes.hpp>
+#include <ferrugo/alg/polygon.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+namespace ferrugo
+{
+namespace alg
+{
+namespace detail
+{
+
+// Adaptive geometric predicates after J. R. Shewchuk, "Adaptive Precision Floating-Point Arithmetic and Fast Robust
+// Geometric Predicates". Each predicate first evaluates its determinant in plain floating point together with a bound
+// on the rounding error; only if the result is smaller than the bound, so that its sign is uncertain, the determinant
+// is evaluated again exactly, as an expansion: a sum of non-overlapping floating point numbers. The results have the
+// correct sign for any input, as long as no intermediate result overflows or underflows, which requires IEEE
+// arithmetic rounding to nearest (no -ffast-math, no x87 extended precision).
+
+template <class T>
+struct predicate_bounds
+{
+    // Half the distance from 1 to the next representable number, the relative error of one rounding.
+    static constexpr T epsilon = std::numeric_limits<T>::epsilon() / 2;
+
+    static constexpr T orient2d = (T(3) + T(16) * epsilon) * epsilon;
+    static constexpr T orient3d = (T(7) + T(56) * epsilon) * epsilon;
+    static constexpr T incircle = (T(10) + T(96) * epsilon) * epsilon;
+};
+
+// x + y = a + b exactly, with x the rounded sum.
+template <class T>
+void two_sum(T a, T b, T& x, T& y)
+{
+    x = a + b;
+    const T b_virtual = x - a;
+    const T a_virtual = x - b_virtual;
+    y = (a - a_virtual) + (b - b_virtual);
+}
+
+// x + y = a + b exactly, for |a| >= |b|.
+template <class T>
+void fast_two_sum(T a, T b, T& x, T& y)
+{
+    x = a + b;
+    y = b - (x - a);
+}
+
+// x + y = a - b exactly.
+template <class T>
+void two_diff(T a, T b, T& x, T& y)
+{
+    x = a - b;
+    const T b_virtual = a - x;
+    const T a_virtual = x + b_virtual;
+    y = (a - a_virtual) + (b_virtual - b);
+}
+
+// x + y = a * b exactly.
+template <class T>
+void two_product(T a, T b, T& x, T& y)
+{
+    x = a * b;
+    y = std::fma(a, b, -x);
+}
+
+// Components in order of increasing magnitude, without zeros, except that 0 is the one-component expansion {0}.
+template <class T, std::size_t N>
+struct expansion
+{
+    std::array<T, N> items;
+    std::size_t size = 0;
+
+    void push(T value)
+    {
+        items[size++] = value;
+    }
+
+    // Ends an expansion whose components were pushed with zeros eliminated; q is the largest component.
+    void finish(T q)
+    {
+        if (q != T(0) || size == 0)
+        {
+            push(q);
+        }
+    }
+
+    // The sum of the components, rounded; the sign is exact.
+    auto estimate() const -> T
+    {
+        T result = T(0);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            result += items[i];
+        }
+        return result;
+    }
+};
+
+template <class T>
+auto expansion_difference(T a, T b) -> expansion<T, 2>
+{
+    expansion<T, 2> result;
+    T x;
+    T y;
+    two_diff(a, b, x, y);
+    if (y != T(0))
+    {
+        result.push(y);
+    }
+    result.finish(x);
+    return result;
+}
+
+// Shewchuk's fast_expansion_sum_zeroelim.
+template <class T, std::size_t N, std::size_t M>
+auto expansion_sum(const expansion<T, N>& e, const expansion<T, M>& f) -> expansion<T, N + M>
+{
+    expansion<T, N + M> result;
+
+    std::size_t ei = 0;
+    std::size_t fi = 0;
+    const auto next_e = [&]() { return ++ei < e.size ? e.items[ei] : T(0); };
+    const auto next_f = [&]() { return ++fi < f.size ? f.items[fi] : T(0); };
+
+    T e_now = e.items[0];
+    T f_now = f.items[0];
+    T q;
+    T q_new;
+    T h;
+
+    // Takes the component of smaller magnitude first.
+    const auto take_e = [&]() { return (f_now > e_now) == (f_now > -e_now); };
+
+    if (take_e())
+    {
+        q = e_now;
+        e_now = next_e();
+    }
+    else
+    {
+        q = f_now;
+        f_now = next_f();
+    }
+
+    if (ei < e.size && fi < f.size)
+    {
+        if (take_e())
+        {
+            fast_two_sum(e_now, q, q_new, h);
+            e_now = next_e();
+        }
+        else
+        {
+            fast_two_sum(f_now, q, q_new, h);
+            f_now = next_f();
+        }
+        q = q_new;
+        if (h != T(0))
+        {
+            result.push(h);
+        }
+
+        while (ei < e.size && fi < f.size)
+        {
+            if (take_e())
+            {
+                two_sum(q, e_now, q_new, h);
+                e_now = next_e();
+            }
+            else
+            {
+                two_sum(q, f_now, q_new, h);
+                f_now = next_f();
+            }
+            q = q_new;
+            if (h != T(0))
+            {
+                result.push(h);
+            }
+        }
+    }
+
+    for (; ei < e.size; e_now = next_e())
+    {
+        two_sum(q, e_now, q_new, h);
+        q = q_new;
+        if (h != T(0))
+        {
+            result.push(h);
+        }
+    }
+
+    for (; fi < f.size; f_now = next_f())
+    {
+        two_sum(q, f_now, q_new, h);
+        q = q_new;
+        if (h != T(0))
+        {
+            result.push(h);
+        }
+    }
+
+    result.finish(q);
+    return result;
+}
+
+template <class T, std::size_t N>
+auto expansion_negate(expansion<T, N> e) -> expansion<T, N>
+{
+    for (std::size_t i = 0; i < e.size; ++i)
+    {
+        e.items[i] = -e.items[i];
+    }
+    return e;
+}
+
+// Shewchuk's scale_expansion_zeroelim.
+template <class T, std::size_t N>
+auto expansion_scale(const expansion<T, N>& e, T b) -> expansion<T, 2 * N>
+{
+    expansion<T, 2 * N> result;
+
+    T q;
+    T h;
+    two_product(e.items[0], b, q, h);
+    if (h != T(0))
+    {
+        result.push(h);
+    }
+
+    for (std::size_t i = 1; i < e.size; ++i)
+    {
+        T product_hi;
+        T product_lo;
+        T sum;
+        two_product(e.items[i], b, product_hi, product_lo);
+        two_sum(q, product_lo, sum, h);
+        if (h != T(0))
+        {
+            result.push(h);
+        }
+        fast_two_sum(product_hi, sum, q, h);
+        if (h != T(0))
+        {
+            result.push(h);
+        }
+    }
+
+    result.finish(q);
+    return result;
+}
+
+template <class T, std::size_t N, std::size_t M>
+auto expansion_product(const expansion<T, N>& e, const expansion<T, M>& f) -> expansion<T, 2 * N * M>
+{
+    expansion<T, 2 * N * M> result;
+    const auto first = expansion_scale(e, f.items[0]);
+    std::copy(first.items.begin(), first.items.begin() + first.size, result.items.begin());
+    result.size = first.size;
+
+    for (std::size_t i = 1; i < f.size; ++i)
+    {
+        const auto sum = expansion_sum(result, expansion_scale(e, f.items[i]));
+        std::copy(sum.items.begin(), sum.items.begin() + sum.size, result.items.begin());
+        result.size = sum.size;
+    }
+
+    return result;
+}
+
+struct orient2d_fn
+{
+    // Positive if a, b, c are in counterclockwise order, negative if clockwise, zero if collinear; twice the signed
+    // area of the triangle, with the same sign as orientation(c, a, b).
+    template <class T>
+    auto operator()(const vector_2d<T>& a, const vector_2d<T>& b, const vector_2d<T>& c) const -> T
+    {
+        static_assert(std::is_floating_point_v<T>, "orient2d: floating point coordinates expected");
+
+        const T left = (a[0] - c[0]) * (b[1] - c[1]);
+        const T right = (a[1] - c[1]) * (b[0] - c[0]);
+        const T result = left - right;
+
+        // If the products differ in sign, the difference has the sign of the larger one.
+        T sum;
+        if (left > T(0))
+        {
+            if (right <= T(0))
+            {
+                return result;
+            }
+            sum = left + right;
+        }
+        else if (left < T(0))
+        {
+            if (right >= T(0))
+            {
+                return result;
+            }
+            sum = -left - right;
+        }
+        else
+        {
+            return result;
+        }
+
+        const T bound = predicate_bounds<T>::orient2d * sum;
+        if (result >= bound || -result >= bound)
+        {
+            return result;
+        }
+
+        return exact(a, b, c);
+    }
+
+    // Orientation of `point` relative to the directed line through shape[0] and shape[1]: positive on its left.
+    template <class Tag, class T>
+    auto operator()(const linear_shape<Tag, T, 2>& shape, const vector_2d<T>& point) const -> T
+    {
+        return (*this)(shape[0], shape[1], point);
+    }
+
+    template <class T>
+    static auto exact(const vector_2d<T>& a, const vector_2d<T>& b, const vector_2d<T>& c) -> T
+    {
+        const auto acx = expansion_difference(a[0], c[0]);
+        const auto acy = expansion_difference(a[1], c[1]);
+        const auto bcx = expansion_difference(b[0], c[0]);
+        const auto bcy = expansion_difference(b[1], c[1]);
+
+        return expansion_sum(expansion_product(acx, bcy), expansion_negate(expansion_product(acy, bcx))).estimate();
+    }
+};
+
+struct orient3d_fn
+{
+    // Positive if d lies below the plane through a, b, c, where a, b, c appear counterclockwise when seen from above;
+    // negative if d lies above it and zero if the points are coplanar. Six times the signed volume of the tetrahedron.
+    template <class T>
+    auto operator()(const vector_3d<T>& a, const vector_3d<T>& b, const vector_3d<T>& c, const vector_3d<T>& d) const
+        -> T
+    {
+        static_assert(std::is_floating_point_v<T>, "orient3d: floating point coordinates expected");
+
+        const T adx = a[0] - d[0];
+        const T bdx = b[0] - d[0];
+        const T cdx = c[0] - d[0];
+        const T ady = a[1] - d[1];
+        const T bdy = b[1] - d[1];
+        const T cdy = c[1] - d[1];
+        const T adz = a[2] - d[2];
+        const T bdz = b[2] - d[2];
+        const T cdz = c[2] - d[2];
+
+        const T bdxcdy = bdx * cdy;
+        const T cdxbdy = cdx * bdy;
+        const T cdxady = cdx * ady;
+        const T adxcdy = adx * cdy;
+        const T adxbdy = adx * bdy;
+        const T bdxady = bdx * ady;
+
+        const T result = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady);
+
+        const T permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * std::abs(adz)
+                            + (std::abs(cdxady) + std::abs(adxcdy)) * std::abs(bdz)
+                            + (std::abs(adxbdy) + std::abs(bdxady)) * std::abs(cdz);
+        const T bound = predicate_bounds<T>::orient3d * permanent;
+        if (result > bound || -result > bound)
+        {
+            return result;
+        }
+
+        return exact(a, b, c, d);
+    }
+
+    template <class T>
+    static auto exact(const vector_3d<T>& a, const vector_3d<T>& b, const vector_3d<T>& c, const vector_3d<T>& d)
+        -> T
+    {
+        const auto adx = expansion_difference(a[0], d[0]);
+        const auto bdx = expansion_difference(b[0], d[0]);
+        const auto cdx = expansion_difference(c[0], d[0]);
+        const auto ady = expansion_difference(a[1], d[1]);
+        const auto bdy = expansion_difference(b[1], d[1]);
+        const auto cdy = expansion_difference(c[1], d[1]);
+        const auto adz = expansion_difference(a[2], d[2]);
+        const auto bdz = expansion_difference(b[2], d[2]);
+        const auto cdz = expansion_difference(c[2], d[2]);
+
+        const auto minor = [](const auto& px, const auto& py, const auto& qx, const auto& qy)
+        { return expansion_sum(expansion_product(px, qy), expansion_negate(expansion_product(qx, py))); };
+
+        const auto a_term = expansion_product(minor(bdx, bdy, cdx, cdy), adz);
+        const auto b_term = expansion_product(minor(cdx, cdy, adx, ady), bdz);
+        const auto c_term = expansion_product(minor(adx, ady, bdx, bdy), cdz);
+
+        return expansion_sum(expansion_sum(a_term, b_term), c_term).estimate();
+    }
+};
+
+struct incircle_predicate_fn
+{
+    // Positive if d lies inside the circle through a, b, c, which must be in counterclockwise order (the sign is
+    // reversed otherwise), negative if it lies outside and zero if the four points are cocircular.
+    template <class T>
+    auto operator()(const vector_2d<T>& a, const vector_2d<T>& b, const vector_2d<T>& c, const vector_2d<T>& d) const
+        -> T
+    {
+        static_assert(std::is_floating_point_v<T>, "incircle: floating point coordinates expected");
+
+        const T adx = a[0] - d[0];
+        const T bdx = b[0] - d[0];
+        const T cdx = c[0] - d[0];
+        const T ady = a[1] - d[1];
+        const T bdy = b[1] - d[1];
+        const T cdy = c[1] - d[1];
+
+        const T bdxcdy = bdx * cdy;
+        const T cdxbdy = cdx * bdy;
+        const T cdxady = cdx * ady;
+        const T adxcdy = adx * cdy;
+        const T adxbdy = adx * bdy;
+        const T bdxady = bdx * ady;
+
+        const T a_lift = adx * adx + ady * ady;
+        const T b_lift = bdx * bdx + bdy * bdy;
+        const T c_lift = cdx * cdx + cdy * cdy;
+
+        const T result = a_lift * (bdxcdy - cdxbdy) + b_lift * (cdxady - adxcdy) + c_lift * (adxbdy - bdxady);
+
+        const T permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * a_lift
+                            + (std::abs(cdxady) + std::abs(adxcdy)) * b_lift
+                            + (std::abs(adxbdy) + std::abs(bdxady)) * c_lift;
+        const T bound = predicate_bounds<T>::incircle * permanent;
+        if (result > bound || -result > bound)
+        {
+            return result;
+        }
+
+        return exact(a, b, c, d);
+    }
+
+    template <class T>
+    auto operator()(const triangle_2d<T>& triangle, const vector_2d<T>& point) const -> T
+    {
+        return (*this)(triangle[0], triangle[1], triangle[2], point);
+    }
+
+    template <class T>
+    static auto exact(const vector_2d<T>& a, const vector_2d<T>& b, const vector_2d<T>& c, const vector_2d<T>& d)
+        -> T
+    {
+        const auto adx = expansion_difference(a[0], d[0]);
+        const auto bdx = expansion_difference(b[0], d[0]);
+        const auto cdx = expansion_difference(c[0], d[0]);
+        const auto ady = expansion_difference(a[1], d[1]);
+        const auto bdy = expansion_difference(b[1], d[1]);
+        const auto cdy = expansion_difference(c[1], d[1]);
+
+        const auto minor = [](const auto& px, const auto& py, const auto& qx, const auto& qy)
+        { return expansion_sum(expansion_product(px, qy), expansion_negate(expansion_product(qx, py))); };
+        const auto lift = [](const auto& x, const auto& y)
+        { return expansion_sum(expansion_product(x, x), expansion_product(y, y)); };
+
+        const auto a_term = expansion_product(minor(bdx, bdy, cdx, cdy), lift(adx, ady));
+        const auto b_term = expansion_product(minor(cdx, cdy, adx, ady), lift(bdx, bdy));
+        const auto c_term = expansion_product(minor(adx, ady, bdx, bdy), lift(cdx, cdy));
+
+        return expansion_sum(expansion_sum(a_term, b_term), c_term).estimate();
+    }
+};
+
+}  // namespace detail
+
+// Exact-sign predicates, in their own namespace since alg::incircle is the inscribed circle of a triangle.
+namespace predicates
+{
+
+static constexpr inline auto orient2d = detail::orient2d_fn{};
+static constexpr inline auto orient3d = detail::orient3d_fn{};
+static constexpr inline auto incircle = detail::incircle_predicate_fn{};
+
+}  // namespace predicates
+
+}  // namespace alg
+}  // namespace ferrugo
@@ -40,6 +40,8 @@ using rect = region_2d<T>;
 template <class T>
 using cuboid = region_3d<T>;
 
+static_assert(std::is_trivially_copyable_v<region_3d<float>> && std::is_standard_layout_v<region_3d<float>>);
+
 template <class T, class U, std::size_t D>
 bool operator==(const region<T, D>& lhs, const region<U, D>& rhs)
 {
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace ferrugo
+{
+namespace alg
+{
+
+// Non-owning view over a contiguous sequence; a minimal stand-in for std::span.
+template <class T>
+class span
+{
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = std::size_t;
+    using pointer = T*;
+    using reference = T&;
+    using iterator = T*;
+
+    constexpr span() : m_data(nullptr), m_size(0)
+    {
+    }
+
+    constexpr span(pointer data, size_type size) : m_data(data), m_size(size)
+    {
+    }
+
+    template <std::size_t N>
+    constexpr span(T (&array)[N]) : m_data(array), m_size(N)
+    {
+    }
+
+    template <class U, class = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr span(const span<U>& other) : m_data(other.data()), m_size(other.size())
+    {
+    }
+
+    template <
+        class Container,
+        class Element = std::remove_pointer_t<decltype(std::data(std::declval<Container&>()))>,
+        class = std::enable_if_t<std::is_convertible_v<Element (*)[], T (*)[]>>,
+        class = decltype(std::size(std::declval<Container&>()))>
+    constexpr span(Container& container) : m_data(std::data(container)), m_size(std::size(container))
+    {
+    }
+
+    constexpr pointer data() const
+    {
+        return m_data;
+    }
+
+    constexpr size_type size() const
+    {
+        return m_size;
+    }
+
+    constexpr size_type size_bytes() const
+    {
+        return m_size * sizeof(T);
+    }
+
+    constexpr bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    constexpr reference operator[](size_type index) const
+    {
+        return m_data[index];
+    }
+
+    constexpr iterator begin() const
+    {
+        return m_data;
+    }
+
+    constexpr iterator end() const
+    {
+        return m_data + m_size;
+    }
+
+    constexpr span subspan(size_type offset, size_type count) const
+    {
+        return span{ m_data + offset, count };
+    }
+
+    constexpr span first(size_type count) const
+    {
+        return subspan(0, count);
+    }
+
+private:
+    pointer m_data;
+    size_type m_size;
+};
+
+template <class Container>
+span(Container&) -> span<std::remove_pointer_t<decltype(std::data(std::declval<Container&>()))>>;
+
+}  // namespace alg
+}  // namespace ferrugo
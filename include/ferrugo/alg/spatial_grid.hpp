@@ -0,0 +1,358 @@
+#pragma once
+
+#include <ferrugo/alg/circular_shapes.hpp>
+#include <ferrugo/alg/operations.hpp>
+#include <ferrugo/alg/span.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ferrugo
+{
+namespace alg
+{
+
+// Uniform grid over points or circles of similar size, rebuilt from scratch whenever the items move.
+// build() sorts the items by cell with a counting sort: the cells are ranges of one array of positions (no per-cell
+// containers), so a rebuild reuses the previous allocations. The grid covers the bounds of the items; if that would
+// take more than a few cells per item, the cell indices wrap around (the grid becomes a spatial hash), which keeps the
+// memory proportional to the number of items. Distances are compared squared, using norm and sqr.
+template <class T, std::size_t D>
+class spatial_grid
+{
+public:
+    static_assert(std::is_floating_point_v<T>, "spatial_grid: floating point coordinates expected");
+
+    explicit spatial_grid(T cell_size) : m_cell_size(cell_size), m_inverse_cell_size(T(1) / cell_size)
+    {
+        if (!(cell_size > T(0)))
+        {
+            throw std::runtime_error{ "spatial_grid: cell size must be positive" };
+        }
+    }
+
+    auto cell_size() const -> T
+    {
+        return m_cell_size;
+    }
+
+    auto size() const -> std::size_t
+    {
+        return m_items.size();
+    }
+
+    auto empty() const -> bool
+    {
+        return m_items.empty();
+    }
+
+    void build(span<const vector<T, D>> points)
+    {
+        m_max_radius = T(0);
+        build_cells(
+            points.size(), [&](std::size_t i) -> const vector<T, D>& { return points[i]; }, [](std::size_t) { return T(0); });
+    }
+
+    void build(span<const circular_shape<T, D>> circles)
+    {
+        m_max_radius = T(0);
+        for (const auto& item : circles)
+        {
+            m_max_radius = std::max(m_max_radius, item.radius);
+        }
+
+        build_cells(
+            circles.size(),
+            [&](std::size_t i) -> const vector<T, D>& { return circles[i].center; },
+            [&](std::size_t i) { return circles[i].radius; });
+    }
+
+    // Calls func(index) for each point within `radius` of `center` or, after building from circles, for each circle
+    // that intersects the ball of `radius` around `center`.
+    template <class Func>
+    void query(const vector<T, D>& center, T radius, Func&& func) const
+    {
+        for_each_candidate(
+            center,
+            radius + m_max_radius,
+            0,
+            [&](std::size_t j)
+            {
+                const auto& item = m_items[j];
+                if (norm(item.position - center) <= sqr(radius + item.radius))
+                {
+                    func(std::size_t{ item.index });
+                }
+            });
+    }
+
+    auto query(const vector<T, D>& center, T radius) const -> std::vector<std::size_t>
+    {
+        std::vector<std::size_t> result;
+        query(center, radius, [&](std::size_t index) { result.push_back(index); });
+        return result;
+    }
+
+    // Calls func(a, b) with a < b once for each pair of points within `distance` of each other or, after building from
+    // circles, for each pair of circles whose gap is at most `distance` (0 for the overlapping pairs).
+    template <class Func>
+    void query_pairs(T distance, Func&& func) const
+    {
+        // Items are visited in cell order, so consecutive queries read the same few cells.
+        for (std::size_t i = 0; i < m_items.size(); ++i)
+        {
+            const auto& position = m_items[i].position;
+            const T radius = m_items[i].radius;
+
+            // Only items after i, the pairs with earlier items were reported when visiting those.
+            for_each_candidate(
+                position,
+                radius + m_max_radius + distance,
+                i + 1,
+                [&](std::size_t j)
+                {
+                    const auto& item = m_items[j];
+                    if (norm(item.position - position) <= sqr(radius + item.radius + distance))
+                    {
+                        const std::size_t a = m_items[i].index;
+                        const std::size_t b = item.index;
+                        func(std::min(a, b), std::max(a, b));
+                    }
+                });
+        }
+    }
+
+    auto query_pairs(T distance) const -> std::vector<std::pair<std::size_t, std::size_t>>
+    {
+        std::vector<std::pair<std::size_t, std::size_t>> result;
+        query_pairs(distance, [&](std::size_t a, std::size_t b) { result.emplace_back(a, b); });
+        return result;
+    }
+
+private:
+    // At most this many cells per item (plus a constant), before the cell indices wrap around.
+    static constexpr std::size_t cells_per_item = 2;
+
+    // An item in cell order: its position, its radius (0 for points) and its index in the built range. Kept in one
+    // array, so that the counting sort scatters each item with one write and the queries read one array.
+    struct entry
+    {
+        vector<T, D> position;
+        T radius;
+        std::uint32_t index;
+    };
+
+    auto cell_coordinate(T value, std::size_t d) const -> std::int64_t
+    {
+        // Clamped, so that far away queries do not overflow. Rounded down by truncating and correcting negative values,
+        // std::floor is a library call unless the target has SSE4.1.
+        const T limit = T(std::int64_t(1) << 61);
+        const T scaled = std::clamp((value - m_origin[d]) * m_inverse_cell_size, -limit, limit);
+        const auto truncated = static_cast<std::int64_t>(scaled);
+        return truncated - static_cast<std::int64_t>(scaled < static_cast<T>(truncated));
+    }
+
+    // Cell coordinates of items are in [0, m_extent[d]), they only need wrapping when the axis was shortened.
+    auto wrap(std::int64_t coordinate, std::size_t d) const -> std::size_t
+    {
+        const auto result = static_cast<std::size_t>(coordinate);
+        return result < m_dims[d] ? result : result % m_dims[d];
+    }
+
+    auto cell_of(const vector<T, D>& position) const -> std::size_t
+    {
+        std::size_t result = 0;
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            result += wrap(cell_coordinate(position[d], d), d) * m_strides[d];
+        }
+        return result;
+    }
+
+    template <class Position, class Radius>
+    void build_cells(std::size_t count, Position&& position_of, Radius&& radius_of)
+    {
+        if (count >= std::numeric_limits<std::uint32_t>::max())
+        {
+            throw std::runtime_error{ "spatial_grid: too many items" };
+        }
+
+        m_items.resize(count);
+
+        vector<T, D> lo{};
+        vector<T, D> up{};
+        if (count != 0)
+        {
+            lo = position_of(0);
+            up = position_of(0);
+        }
+        for (std::size_t i = 1; i < count; ++i)
+        {
+            const auto& p = position_of(i);
+            for (std::size_t d = 0; d < D; ++d)
+            {
+                lo[d] = std::min(lo[d], p[d]);
+                up[d] = std::max(up[d], p[d]);
+            }
+        }
+
+        m_origin = lo;
+
+        // Cells needed to cover the bounds, then halve the longest axes until the total fits the budget.
+        const std::size_t budget = cells_per_item * count + 64;
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            const T extent = std::min((up[d] - lo[d]) * m_inverse_cell_size, T(std::int64_t(1) << 60));
+            m_extent[d] = static_cast<std::int64_t>(extent) + 1;
+            m_dims[d] = std::min(static_cast<std::size_t>(m_extent[d]), budget);
+        }
+
+        // The product of the axes saturates at budget + 1: with up to `budget` cells per axis it can overflow.
+        const auto cell_count = [&]()
+        {
+            std::size_t result = 1;
+            for (std::size_t d = 0; d < D; ++d)
+            {
+                result = result > budget / m_dims[d] ? budget + 1 : result * m_dims[d];
+            }
+            return result;
+        };
+
+        std::size_t total = cell_count();
+        while (total > budget)
+        {
+            const auto longest = static_cast<std::size_t>(std::max_element(m_dims.begin(), m_dims.end()) - m_dims.begin());
+            m_dims[longest] = (m_dims[longest] + 1) / 2;
+            total = cell_count();
+        }
+
+        std::size_t stride = 1;
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            m_strides[d] = stride;
+            stride *= m_dims[d];
+        }
+
+        // Counting sort: m_starts[c] becomes the first sorted position of cell c.
+        m_cells.resize(count);
+        m_starts.assign(total + 1, 0);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            m_cells[i] = static_cast<std::uint32_t>(cell_of(position_of(i)));
+            ++m_starts[m_cells[i] + 1];
+        }
+
+        for (std::size_t c = 0; c < total; ++c)
+        {
+            m_starts[c + 1] += m_starts[c];
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const std::uint32_t target = m_starts[m_cells[i]]++;
+            m_items[target] = entry{ position_of(i), radius_of(i), static_cast<std::uint32_t>(i) };
+        }
+
+        // The scatter advanced every start to the start of the next cell.
+        for (std::size_t c = total; c > 0; --c)
+        {
+            m_starts[c] = m_starts[c - 1];
+        }
+        m_starts[0] = 0;
+    }
+
+    // Calls func(j) for each sorted item j >= first_item in the cells overlapping the box of `reach` around `center`;
+    // each cell is visited once even if the indices wrap around. The cells of a row along the first axis are adjacent,
+    // so a row is one range of items (two if it wraps around).
+    template <class Func>
+    void for_each_candidate(const vector<T, D>& center, T reach, std::size_t first_item, Func&& func) const
+    {
+        if (m_items.empty())
+        {
+            return;
+        }
+
+        std::array<std::int64_t, D> first;
+        std::array<std::size_t, D> count;
+
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            // Items only exist within the bounds, cells [0, m_extent[d]).
+            const std::int64_t lo = std::max<std::int64_t>(cell_coordinate(center[d] - reach, d), 0);
+            const std::int64_t up = std::min<std::int64_t>(cell_coordinate(center[d] + reach, d), m_extent[d] - 1);
+
+            if (lo > up)
+            {
+                return;
+            }
+
+            const auto span = static_cast<std::size_t>(up - lo + 1);
+            first[d] = span >= m_dims[d] ? 0 : lo;
+            count[d] = std::min(span, m_dims[d]);
+        }
+
+        const std::size_t row_first = wrap(first[0], 0);
+        const std::size_t row_last = row_first + count[0];
+        const std::size_t row_end = std::min(row_last, m_dims[0]);
+
+        const auto visit = [&](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t j = std::max<std::size_t>(m_starts[begin], first_item); j < m_starts[end]; ++j)
+            {
+                func(j);
+            }
+        };
+
+        std::array<std::size_t, D> offset{};
+        while (true)
+        {
+            std::size_t row = 0;
+            for (std::size_t d = 1; d < D; ++d)
+            {
+                row += wrap(first[d] + static_cast<std::int64_t>(offset[d]), d) * m_strides[d];
+            }
+
+            visit(row + row_first, row + row_end);
+            if (row_last > row_end)
+            {
+                visit(row, row + row_last - row_end);
+            }
+
+            std::size_t d = 1;
+            for (; d < D && ++offset[d] == count[d]; ++d)
+            {
+                offset[d] = 0;
+            }
+            if (d == D)
+            {
+                break;
+            }
+        }
+    }
+
+    T m_cell_size;
+    T m_inverse_cell_size;
+    T m_max_radius = T(0);
+    vector<T, D> m_origin{};
+    std::array<std::int64_t, D> m_extent{};
+    std::array<std::size_t, D> m_dims{};
+    std::array<std::size_t, D> m_strides{};
+    std::vector<std::uint32_t> m_starts;
+    std::vector<std::uint32_t> m_cells;
+    std::vector<entry> m_items;
+};
+
+template <class T>
+using spatial_grid_2d = spatial_grid<T, 2>;
+
+template <class T>
+using spatial_grid_3d = spatial_grid<T, 3>;
+
+}  // namespace alg
+}  // namespace ferrugo
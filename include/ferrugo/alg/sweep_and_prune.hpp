@@ -0,0 +1,206 @@
+#pragma once
+
+#include <ferrugo/alg/operations.hpp>
+#include <ferrugo/alg/span.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ferrugo
+{
+namespace alg
+{
+
+// Sweep-and-prune broad phase for a set of regions that is updated every frame.
+// The intervals of the regions along one axis are kept sorted by their lower bounds. Between frames the items move
+// little, so insertion sort restores the order in close to linear time; the sweep then only tests the items whose
+// intervals overlap along that axis. The axis is the one along which the centers are spread the most.
+template <class T, std::size_t D>
+class sweep_and_prune
+{
+public:
+    using real_type = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+
+    // What the last update did, for tuning.
+    struct statistics
+    {
+        std::size_t axis = 0;
+        bool sorted = false;    // the order was rebuilt with a full sort instead of insertion sort
+        std::size_t swaps = 0;  // moves made by insertion sort
+        std::size_t tests = 0;  // pairs overlapping along the axis, tested with intersects
+        std::size_t pairs = 0;  // pairs reported
+    };
+
+    sweep_and_prune() = default;
+
+    auto stats() const -> const statistics&
+    {
+        return m_stats;
+    }
+
+    // Calls func(a, b) with a < b once for each pair of intersecting items. The items are expected to be the same as in
+    // the previous update, in the same order, with new positions; if their number changes, the order is rebuilt.
+    template <class Func>
+    void update(span<const region<T, D>> items, Func&& func)
+    {
+        if (items.size() >= std::numeric_limits<std::uint32_t>::max())
+        {
+            throw std::runtime_error{ "sweep_and_prune: too many items" };
+        }
+
+        m_stats = statistics{};
+        m_stats.axis = choose_axis(items);
+
+        if (items.size() != m_keys.size() || m_stats.axis != m_axis)
+        {
+            m_axis = m_stats.axis;
+            m_keys.resize(items.size());
+            for (std::size_t i = 0; i < items.size(); ++i)
+            {
+                m_keys[i].index = static_cast<std::uint32_t>(i);
+            }
+            refresh(items);
+            full_sort();
+        }
+        else
+        {
+            refresh(items);
+            insertion_sort();
+        }
+
+        sweep(items, func);
+    }
+
+    auto update(span<const region<T, D>> items) -> std::vector<std::pair<std::size_t, std::size_t>>
+    {
+        std::vector<std::pair<std::size_t, std::size_t>> result;
+        update(items, [&](std::size_t a, std::size_t b) { result.emplace_back(a, b); });
+        return result;
+    }
+
+private:
+    struct key
+    {
+        T lo;
+        T up;
+        std::uint32_t index;
+    };
+
+    // A different axis is only taken if the spread along it is larger by this factor, so that an axis change, which
+    // costs a full sort, does not happen back and forth.
+    static constexpr real_type axis_hysteresis = real_type(1.25);
+
+    // Insertion sort gives up and sorts from scratch after this many swaps per item.
+    static constexpr std::size_t max_swaps_per_item = 32;
+
+    auto choose_axis(span<const region<T, D>> items) const -> std::size_t
+    {
+        if (items.empty())
+        {
+            return m_axis;
+        }
+
+        // Variance of the centers, times the number of items.
+        real_type spread[D];
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            real_type sum = real_type(0);
+            real_type sum_of_squares = real_type(0);
+            for (const auto& item : items)
+            {
+                const real_type center = real_type(lower(item[d])) + real_type(upper(item[d]));
+                sum += center;
+                sum_of_squares += center * center;
+            }
+            spread[d] = sum_of_squares - sum * sum / real_type(items.size());
+        }
+
+        std::size_t result = m_axis;
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            if (spread[d] > axis_hysteresis * spread[result])
+            {
+                result = d;
+            }
+        }
+        return result;
+    }
+
+    void refresh(span<const region<T, D>> items)
+    {
+        for (auto& item : m_keys)
+        {
+            item.lo = lower(items[item.index][m_axis]);
+            item.up = upper(items[item.index][m_axis]);
+        }
+    }
+
+    void full_sort()
+    {
+        std::sort(m_keys.begin(), m_keys.end(), [](const key& lhs, const key& rhs) { return lhs.lo < rhs.lo; });
+        m_stats.sorted = true;
+    }
+
+    void insertion_sort()
+    {
+        const std::size_t max_swaps = max_swaps_per_item * m_keys.size();
+
+        for (std::size_t i = 1; i < m_keys.size(); ++i)
+        {
+            const key current = m_keys[i];
+            std::size_t j = i;
+            for (; j > 0 && current.lo < m_keys[j - 1].lo; --j)
+            {
+                m_keys[j] = m_keys[j - 1];
+            }
+            m_keys[j] = current;
+            m_stats.swaps += i - j;
+
+            if (m_stats.swaps > max_swaps)
+            {
+                full_sort();
+                return;
+            }
+        }
+    }
+
+    template <class Func>
+    void sweep(span<const region<T, D>> items, Func& func)
+    {
+        for (std::size_t i = 0; i < m_keys.size(); ++i)
+        {
+            const key& current = m_keys[i];
+
+            // intersects is inclusive, so are the bounds along the axis.
+            for (std::size_t j = i + 1; j < m_keys.size() && m_keys[j].lo <= current.up; ++j)
+            {
+                ++m_stats.tests;
+
+                const std::size_t a = current.index;
+                const std::size_t b = m_keys[j].index;
+                if (intersects(items[a], items[b]))
+                {
+                    ++m_stats.pairs;
+                    func(std::min(a, b), std::max(a, b));
+                }
+            }
+        }
+    }
+
+    std::size_t m_axis = 0;
+    std::vector<key> m_keys;
+    statistics m_stats;
+};
+
+template <class T>
+using sweep_and_prune_2d = sweep_and_prune<T, 2>;
+
+template <class T>
+using sweep_and_prune_3d = sweep_and_prune<T, 3>;
+
+}  // namespace alg
+}  // namespace ferrugo
@@ -0,0 +1,142 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+#include <ferrugo/alg/aabb_tree.hpp>
+#include <cmath>
+#include <map>
+#include <random>
+
+using namespace ferrugo;
+
+namespace
+{
+
+auto make_box(float x, float y, float size) -> alg::region_2d<float>
+{
+    return alg::region_2d<float>{ alg::interval<float>{ x, x + size }, alg::interval<float>{ y, y + size } };
+}
+
+void check_tree(const alg::aabb_tree_2d<float>& tree, const std::map<std::size_t, alg::region_2d<float>>& items)
+{
+    REQUIRE(tree.size() == items.size());
+
+    if (!items.empty())
+    {
+        REQUIRE(tree.height() <= 2 * static_cast<std::size_t>(std::log2(items.size())) + 2);
+    }
+
+    for (const auto& [handle, item] : items)
+    {
+        REQUIRE(tree.bounds(handle) == item);
+        REQUIRE(alg::contains(tree.fat_bounds(handle), item));
+    }
+
+    std::vector<std::pair<std::size_t, std::size_t>> expected;
+    for (auto a = items.begin(); a != items.end(); ++a)
+    {
+        for (auto b = std::next(a); b != items.end(); ++b)
+        {
+            if (alg::intersects(a->second, b->second))
+            {
+                expected.emplace_back(a->first, b->first);
+            }
+        }
+    }
+
+    auto pairs = tree.query_pairs();
+    std::sort(pairs.begin(), pairs.end());
+    REQUIRE(pairs == expected);
+
+    const auto range = make_box(20.F, 30.F, 25.F);
+    auto actual = tree.query(range);
+    std::sort(actual.begin(), actual.end());
+
+    std::vector<std::size_t> expected_handles;
+    for (const auto& [handle, item] : items)
+    {
+        if (alg::intersects(item, range))
+        {
+            expected_handles.push_back(handle);
+        }
+    }
+    REQUIRE(actual == expected_handles);
+}
+
+}  // namespace
+
+TEST_CASE("aabb_tree - insert, move and remove", "[aabb_tree]")
+{
+    std::mt19937 engine{ 3 };
+    std::uniform_real_distribution<float> position{ 0.F, 100.F };
+    std::uniform_real_distribution<float> step{ -1.F, 1.F };
+
+    alg::aabb_tree_2d<float> tree{ 0.5F };
+    std::map<std::size_t, alg::region_2d<float>> items;
+
+    for (int i = 0; i < 400; ++i)
+    {
+        const auto item = make_box(position(engine), position(engine), 2.F);
+        items.emplace(tree.insert(item), item);
+    }
+    check_tree(tree, items);
+
+    std::size_t reinserted = 0;
+    for (int tick = 0; tick < 5; ++tick)
+    {
+        for (auto& [handle, item] : items)
+        {
+            const auto delta = alg::vec(step(engine), step(engine)) * 0.3F;
+            item = item + delta;
+            reinserted += tree.move(handle, item, delta);
+        }
+        check_tree(tree, items);
+    }
+    REQUIRE(reinserted > 0);
+    REQUIRE(reinserted < 5 * items.size());
+
+    for (auto it = items.begin(); it != items.end();)
+    {
+        if (it->first % 3 == 0)
+        {
+            tree.remove(it->first);
+            it = items.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    check_tree(tree, items);
+
+    // Freed nodes are reused before the pool grows.
+    const auto removed = items.begin()->first;
+    tree.remove(removed);
+    items.erase(removed);
+    const auto item = make_box(50.F, 50.F, 3.F);
+    const auto handle = tree.insert(item);
+    REQUIRE(handle == removed);
+    items.emplace(handle, item);
+    check_tree(tree, items);
+
+    REQUIRE_THROWS_AS(tree.remove(removed + 1000000), std::runtime_error);
+}
+
+TEST_CASE("aabb_tree - degenerate insertion orders stay balanced", "[aabb_tree]")
+{
+    alg::aabb_tree_2d<float> tree{};
+    std::map<std::size_t, alg::region_2d<float>> items;
+
+    for (int i = 0; i < 1024; ++i)
+    {
+        const auto item = make_box(static_cast<float>(i), 0.F, 1.5F);
+        items.emplace(tree.insert(item), item);
+    }
+    check_tree(tree, items);
+
+    for (auto& [handle, item] : items)
+    {
+        tree.remove(handle);
+    }
+    REQUIRE(tree.empty());
+    REQUIRE(tree.height() == 0);
+    REQUIRE(tree.query(make_box(0.F, 0.F, 10.F)).empty());
+}
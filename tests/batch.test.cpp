@@ -0,0 +1,84 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+#include <cstdint>
+#include <ferrugo/alg/point_batch.hpp>
+
+using namespace ferrugo;
+
+namespace
+{
+
+template <class T, std::size_t D>
+auto make_points(std::size_t count) -> std::vector<alg::vector<T, D>>
+{
+    std::vector<alg::vector<T, D>> result(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            result[i][d] = static_cast<T>(i * (d + 1)) * T(0.25) - T(3);
+        }
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST_CASE("point_batch - conversion", "[point_batch]")
+{
+    const auto points = make_points<float, 3>(11);
+    const auto batch = alg::to_batch(points);
+
+    REQUIRE(batch.size() == 11);
+    REQUIRE(batch[4] == points[4]);
+    REQUIRE(batch.z()[7] == points[7].z());
+    REQUIRE(reinterpret_cast<std::uintptr_t>(batch.x().data()) % alg::point_batch_3d<float>::alignment == 0);
+    REQUIRE(alg::to_points(batch) == points);
+
+    std::vector<alg::vector_3d<float>> out(10);
+    REQUIRE_THROWS_AS(alg::to_points(batch, alg::span<alg::vector_3d<float>>{ out }), std::runtime_error);
+}
+
+TEST_CASE("point_batch - transform matches per-point transform", "[point_batch]")
+{
+    const auto points = make_points<float, 2>(13);
+    const auto m = alg::scale(2.F, 3.F) * alg::rotation(0.5F) * alg::translation(1.F, -2.F);
+
+    const auto result = alg::to_points(alg::to_batch(points) * m);
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        const auto expected = points[i] * m;
+        REQUIRE_THAT(result[i].x(), Catch::Matchers::WithinAbs(expected.x(), 1e-4));
+        REQUIRE_THAT(result[i].y(), Catch::Matchers::WithinAbs(expected.y(), 1e-4));
+    }
+}
+
+TEST_CASE("point_batch - in-place transform", "[point_batch]")
+{
+    const auto points = make_points<double, 3>(9);
+    const auto m = alg::scale(2.0, 1.0, 0.5) * alg::translation(1.0, 2.0, 3.0);
+
+    auto batch = alg::to_batch(points);
+    batch *= m;
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        REQUIRE(batch[i] == points[i] * m);
+    }
+}
+
+TEST_CASE("point_batch - translate and scale", "[point_batch]")
+{
+    alg::point_batch_2d<int> batch;
+    batch.push_back({ 1, 2 });
+    batch.push_back({ -3, 4 });
+
+    batch += alg::vector_2d<int>{ 10, 20 };
+    REQUIRE(batch[0] == alg::vector_2d<int>{ 11, 22 });
+    REQUIRE(batch[1] == alg::vector_2d<int>{ 7, 24 });
+
+    alg::scale_points(batch, alg::vector_2d<int>{ 2, -1 });
+    REQUIRE(batch[0] == alg::vector_2d<int>{ 22, -22 });
+
+    batch -= alg::vector_2d<int>{ 2, 2 };
+    REQUIRE(batch[1] == alg::vector_2d<int>{ 12, -26 });
+}
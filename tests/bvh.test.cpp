@@ -0,0 +1,141 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+#include <ferrugo/alg/bvh.hpp>
+#include <random>
+
+using namespace ferrugo;
+
+namespace
+{
+
+template <class T, std::size_t D>
+auto random_regions(std::size_t count, T extent, T max_size, std::uint32_t seed) -> std::vector<alg::region<T, D>>
+{
+    std::mt19937 engine{ seed };
+    std::uniform_real_distribution<double> position{ 0.0, double(extent) };
+    std::uniform_real_distribution<double> size{ 0.0, double(max_size) };
+
+    std::vector<alg::region<T, D>> result(count);
+    for (auto& item : result)
+    {
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            const T lo = static_cast<T>(position(engine));
+            item[d] = alg::interval<T>{ lo, static_cast<T>(lo + static_cast<T>(size(engine))) };
+        }
+    }
+    return result;
+}
+
+template <class T, std::size_t D>
+void check_queries(const alg::bvh<T, D>& tree, const std::vector<alg::region<T, D>>& items, T extent)
+{
+    REQUIRE(tree.size() == items.size());
+
+    const auto queries = random_regions<T, D>(50, extent, extent / 4, 7);
+    for (const auto& query : queries)
+    {
+        auto actual = tree.query(query);
+        std::sort(actual.begin(), actual.end());
+
+        std::vector<std::size_t> expected;
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            if (alg::intersects(items[i], query))
+            {
+                expected.push_back(i);
+            }
+        }
+        REQUIRE(actual == expected);
+
+        const auto point = alg::center(query);
+        actual = tree.query(point);
+        std::sort(actual.begin(), actual.end());
+
+        expected.clear();
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            if (alg::contains(items[i], point))
+            {
+                expected.push_back(i);
+            }
+        }
+        REQUIRE(actual == expected);
+    }
+}
+
+}  // namespace
+
+TEST_CASE("bvh - region and point queries match a linear scan", "[bvh]")
+{
+    const auto items_2d = random_regions<float, 2>(3000, 100.F, 5.F, 1);
+    check_queries(alg::bvh_2d<float>{ items_2d }, items_2d, 100.F);
+
+    const auto items_3d = random_regions<double, 3>(2000, 50.0, 4.0, 2);
+    check_queries(alg::bvh_3d<double>{ items_3d }, items_3d, 50.0);
+
+    const auto items_int = random_regions<int, 2>(1000, 200, 12, 3);
+    check_queries(alg::bvh_2d<int>{ items_int }, items_int, 200);
+}
+
+TEST_CASE("bvh - parallel build", "[bvh]")
+{
+    const auto items = random_regions<float, 3>(40000, 100.F, 2.F, 4);
+    const auto serial = alg::bvh_3d<float>{ items };
+    const auto parallel = alg::bvh_3d<float>{ items, 4 };
+
+    REQUIRE(parallel.nodes().size() == serial.nodes().size());
+    check_queries(parallel, items, 100.F);
+
+    for (const auto& node : parallel.nodes())
+    {
+        REQUIRE(node.count <= alg::bvh_3d<float>::max_leaf_size);
+    }
+}
+
+TEST_CASE("bvh - ray queries", "[bvh]")
+{
+    const auto items = random_regions<double, 2>(2000, 100.0, 3.0, 5);
+    const auto tree = alg::bvh_2d<double>{ items };
+
+    const auto ray = alg::ray_2d<double>{ alg::vec(-10.0, 3.0), alg::vec(0.0, 4.0) };
+
+    std::vector<std::size_t> actual;
+    tree.query(
+        ray,
+        [&](std::size_t index, double t)
+        {
+            actual.push_back(index);
+            const auto entry = ray[0] + (ray[1] - ray[0]) * t;
+            REQUIRE(alg::intersects(
+                items[index],
+                alg::region_2d<double>{ alg::interval<double>{ entry[0] - 1e-9, entry[0] + 1e-9 },
+                                        alg::interval<double>{ entry[1] - 1e-9, entry[1] + 1e-9 } }));
+        });
+    std::sort(actual.begin(), actual.end());
+    REQUIRE(!actual.empty());
+    REQUIRE(actual == [&]()
+            {
+                auto result = tree.query(ray);
+                std::sort(result.begin(), result.end());
+                return result;
+            }());
+
+    // Linear scan: the ray is y = 4 + x / 10 for x >= -10, which is increasing, so it meets a box if its y range over
+    // the box's x range overlaps the box's y range.
+    std::vector<std::size_t> expected;
+    for (std::size_t i = 0; i < items.size(); ++i)
+    {
+        const double x0 = std::max(alg::lower(items[i][0]), -10.0);
+        const double x1 = alg::upper(items[i][0]);
+        if (x0 <= x1 && 4.0 + x0 / 10.0 <= alg::upper(items[i][1]) && alg::lower(items[i][1]) <= 4.0 + x1 / 10.0)
+        {
+            expected.push_back(i);
+        }
+    }
+    REQUIRE(actual == expected);
+
+    const auto empty = alg::bvh_2d<double>{};
+    REQUIRE(empty.query(ray).empty());
+    REQUIRE(empty.query(alg::vec(0.0, 0.0)).empty());
+}
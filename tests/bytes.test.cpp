@@ -0,0 +1,57 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+#include <ferrugo/alg/bytes.hpp>
+#include <ferrugo/alg/circular_shapes.hpp>
+#include <ferrugo/alg/linear_shapes.hpp>
+#include <ferrugo/alg/polygon.hpp>
+#include <ferrugo/alg/region.hpp>
+
+using namespace ferrugo;
+
+TEST_CASE("value types are trivially copyable", "[bytes]")
+{
+    STATIC_REQUIRE(std::is_trivially_copyable_v<alg::vector_2d<float>>);
+    STATIC_REQUIRE(std::is_trivially_copyable_v<alg::square_matrix_3d<double>>);
+    STATIC_REQUIRE(std::is_trivially_copyable_v<alg::interval<int>>);
+    STATIC_REQUIRE(std::is_trivially_copyable_v<alg::region_2d<float>>);
+    STATIC_REQUIRE(std::is_trivially_copyable_v<alg::triangle_2d<float>>);
+    STATIC_REQUIRE(std::is_trivially_copyable_v<alg::segment<double, 3>>);
+    STATIC_REQUIRE(std::is_trivially_copyable_v<alg::circle<float>>);
+    STATIC_REQUIRE(std::is_standard_layout_v<alg::ray<float, 2>>);
+    STATIC_REQUIRE(std::is_standard_layout_v<alg::quad_2d<int>>);
+    STATIC_REQUIRE(sizeof(alg::vector_2d<float>) == 2 * sizeof(float));
+}
+
+TEST_CASE("write_bytes / read_bytes round trip", "[bytes]")
+{
+    const std::vector<alg::triangle_2d<float>> triangles{
+        alg::triangle_2d<float>{ alg::vec(0.F, 0.F), alg::vec(1.F, 0.F), alg::vec(0.F, 1.F) },
+        alg::triangle_2d<float>{ alg::vec(-2.F, 3.F), alg::vec(4.F, 5.F), alg::vec(6.F, -7.F) },
+    };
+
+    const auto bytes = alg::write_bytes(triangles);
+    REQUIRE(bytes.size() == 2 * 6 * sizeof(float));
+
+    std::vector<alg::triangle_2d<float>> restored(2);
+    REQUIRE(alg::read_bytes(bytes, restored) == bytes.size());
+    REQUIRE(restored[0][1] == triangles[0][1]);
+    REQUIRE(restored[1][2] == triangles[1][2]);
+
+    std::vector<alg::triangle_2d<float>> too_many(3);
+    REQUIRE_THROWS_AS(alg::read_bytes(bytes, too_many), std::runtime_error);
+}
+
+TEST_CASE("write_bytes into a caller buffer", "[bytes]")
+{
+    const std::vector<alg::circle<double>> circles{ { alg::vec(1.0, 2.0), 3.0 }, { alg::vec(4.0, 5.0), 6.0 } };
+    std::vector<std::byte> buffer(2 * sizeof(alg::circle<double>) + 8);
+
+    REQUIRE(alg::write_bytes(circles, buffer) == 2 * sizeof(alg::circle<double>));
+    REQUIRE_THROWS_AS(alg::write_bytes(circles, alg::span<std::byte>{ buffer }.first(8)), std::runtime_error);
+
+    alg::circle<double> last;
+    const auto tail = alg::span<const std::byte>{ buffer }.subspan(sizeof(last), sizeof(last));
+    alg::read_bytes(tail, alg::span<alg::circle<double>>{ &last, 1 });
+    REQUIRE(last.center == alg::vec(4.0, 5.0));
+    REQUIRE(last.radius == 6.0);
+}
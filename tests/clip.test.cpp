@@ -0,0 +1,131 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+#include <ferrugo/alg/clip.hpp>
+#include <random>
+
+using namespace ferrugo;
+
+namespace
+{
+
+template <class T>
+auto make_rect(T x0, T y0, T x1, T y1) -> alg::rect<T>
+{
+    return alg::rect<T>{ alg::interval<T>{ x0, x1 }, alg::interval<T>{ y0, y1 } };
+}
+
+template <class T>
+auto area(const alg::vector_2d<T>* vertices, std::size_t size) -> double
+{
+    return alg::signed_area(alg::polygon<double>(vertices, vertices + size));
+}
+
+template <class T>
+auto area(const std::vector<alg::vector_2d<T>>& vertices) -> double
+{
+    return area(vertices.data(), vertices.size());
+}
+
+template <class T, std::size_t N>
+auto clipped(const alg::polygon_base<T, 2, N>& item, const alg::rect<T>& rect) -> std::vector<alg::vector_2d<T>>
+{
+    std::vector<alg::vector_2d<T>> result(alg::clip_capacity(N));
+    result.resize(alg::clip(item, rect, result));
+    return result;
+}
+
+}  // namespace
+
+TEST_CASE("clip - trivial accept and reject", "[clip]")
+{
+    const auto rect = make_rect(0.0, 0.0, 10.0, 10.0);
+    const alg::triangle_2d<double> inside = { alg::vec(1.0, 1.0), alg::vec(9.0, 1.0), alg::vec(10.0, 10.0) };
+    const alg::triangle_2d<double> outside = { alg::vec(11.0, 1.0), alg::vec(19.0, 1.0), alg::vec(15.0, 5.0) };
+    const alg::triangle_2d<double> touching = { alg::vec(10.0, 1.0), alg::vec(19.0, 1.0), alg::vec(15.0, 5.0) };
+
+    REQUIRE(clipped(inside, rect) == std::vector<alg::vector_2d<double>>(inside.begin(), inside.end()));
+    REQUIRE(clipped(outside, rect).empty());
+    REQUIRE(clipped(touching, rect).empty());
+
+    std::vector<alg::vector_2d<double>> small(3);
+    REQUIRE_THROWS_AS(alg::clip(inside, rect, small), std::runtime_error);
+}
+
+TEST_CASE("clip - triangle and quad", "[clip]")
+{
+    const auto rect = make_rect(1.0, 1.0, 3.0, 3.0);
+
+    // The triangle cuts off the corner (3, 3) of the rectangle.
+    const alg::triangle_2d<double> triangle = { alg::vec(0.0, 0.0), alg::vec(5.0, 0.0), alg::vec(0.0, 5.0) };
+    const auto result = clipped(triangle, rect);
+    REQUIRE(result.size() == 5);
+    REQUIRE_THAT(area(result), Catch::Matchers::WithinAbs(4.0 - 0.5, 1e-12));
+
+    // A diamond around the rectangle leaves an octagon.
+    const alg::quad_2d<double> quad = {
+        alg::vec(2.0, 0.5), alg::vec(3.5, 2.0), alg::vec(2.0, 3.5), alg::vec(0.5, 2.0),
+    };
+    const auto octagon = clipped(quad, rect);
+    REQUIRE(octagon.size() == 8);
+    REQUIRE_THAT(area(octagon), Catch::Matchers::WithinAbs(4.0 - 4 * 0.5 * 0.5 * 0.5, 1e-12));
+    for (const auto& vertex : octagon)
+    {
+        REQUIRE(alg::contains(make_rect(1.0, 1.0, 3.0 + 1e-12, 3.0 + 1e-12), vertex));
+    }
+}
+
+TEST_CASE("clip - pieces of a rectangle add up", "[clip]")
+{
+    std::mt19937 generator{ 23 };
+    std::uniform_real_distribution<double> position{ -20.0, 20.0 };
+
+    const auto rect = make_rect(-8.0, -6.0, 8.0, 6.0);
+    const alg::rect<double> pieces[4] = {
+        make_rect(-8.0, -6.0, 0.0, 0.0),
+        make_rect(0.0, -6.0, 8.0, 0.0),
+        make_rect(-8.0, 0.0, 0.0, 6.0),
+        make_rect(0.0, 0.0, 8.0, 6.0),
+    };
+
+    for (std::size_t n = 0; n < 500; ++n)
+    {
+        alg::triangle_2d<double> triangle;
+        for (auto& vertex : triangle)
+        {
+            vertex = alg::vec(position(generator), position(generator));
+        }
+        if (alg::signed_area(triangle) < 0.0)
+        {
+            std::swap(triangle[1], triangle[2]);
+        }
+
+        const auto whole = clipped(triangle, rect);
+        double sum = 0.0;
+        for (const auto& piece : pieces)
+        {
+            sum += area(clipped(triangle, piece));
+        }
+        REQUIRE_THAT(area(whole), Catch::Matchers::WithinAbs(sum, 1e-9));
+        REQUIRE(area(whole) <= alg::signed_area(triangle) + 1e-9);
+    }
+}
+
+TEST_CASE("clip_all - batch", "[clip]")
+{
+    const auto rect = make_rect(0.F, 0.F, 10.F, 10.F);
+    const std::vector<alg::triangle_2d<float>> triangles = {
+        { alg::vec(1.F, 1.F), alg::vec(2.F, 1.F), alg::vec(1.F, 2.F) },
+        { alg::vec(20.F, 1.F), alg::vec(22.F, 1.F), alg::vec(20.F, 2.F) },
+        { alg::vec(5.F, 5.F), alg::vec(15.F, 5.F), alg::vec(5.F, 15.F) },
+    };
+
+    auto result = alg::clip_all(triangles, rect);
+    REQUIRE(result.indices == std::vector<std::size_t>{ 0, 2 });
+    REQUIRE(result.offsets == std::vector<std::size_t>{ 0, 3 });
+    REQUIRE(result.vertices.size() == 3 + 4);
+    REQUIRE_THAT(area(result.vertices.data() + 3, 4), Catch::Matchers::WithinAbs(25.0, 1e-5));
+
+    REQUIRE(alg::clip_all(triangles, rect, result) == 2);
+    REQUIRE(result.indices.size() == 4);
+    REQUIRE(result.offsets[2] == 7);
+}
@@ -0,0 +1,150 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+#include <ferrugo/alg/convex_hull.hpp>
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace ferrugo;
+
+namespace
+{
+
+template <class T>
+auto random_points(std::size_t count, std::uint32_t seed) -> std::vector<alg::vector_2d<T>>
+{
+    std::mt19937 generator{ seed };
+    std::uniform_real_distribution<T> position{ T(-50), T(50) };
+
+    std::vector<alg::vector_2d<T>> result(count);
+    for (auto& item : result)
+    {
+        item = alg::vec(position(generator), position(generator));
+    }
+    return result;
+}
+
+// The hull is convex and counterclockwise, without collinear vertices, its vertices are input points and no input
+// point lies outside of it.
+template <class T>
+void check_hull(const std::vector<alg::vector_2d<T>>& points, const alg::polygon<T>& hull)
+{
+    for (const auto& vertex : hull)
+    {
+        REQUIRE(std::find(points.begin(), points.end(), vertex) != points.end());
+    }
+
+    if (hull.size() < 3)
+    {
+        return;
+    }
+
+    for (std::size_t i = 0; i < hull.size(); ++i)
+    {
+        const auto& a = hull[i];
+        const auto& b = hull[(i + 1) % hull.size()];
+        const auto& c = hull[(i + 2) % hull.size()];
+        REQUIRE(alg::predicates::orient2d(a, b, c) > T(0));
+
+        for (const auto& point : points)
+        {
+            REQUIRE(alg::predicates::orient2d(a, b, point) >= T(0));
+        }
+    }
+}
+
+}  // namespace
+
+TEST_CASE("convex_hull - random points", "[convex_hull]")
+{
+    for (std::size_t count : { 3, 10, 100, 1000 })
+    {
+        const auto points = random_points<double>(count, 5);
+        const auto hull = alg::convex_hull(points);
+        REQUIRE(hull.size() >= 3);
+        check_hull(points, hull);
+    }
+
+    const auto points = random_points<float>(1000, 6);
+    check_hull(points, alg::convex_hull(points));
+}
+
+TEST_CASE("convex_hull - counterclockwise order from the smallest vertex", "[convex_hull]")
+{
+    const std::vector<alg::vector_2d<double>> points = {
+        alg::vec(2.0, 2.0), alg::vec(0.0, 4.0), alg::vec(1.0, 1.0), alg::vec(4.0, 4.0),
+        alg::vec(4.0, 0.0), alg::vec(0.0, 0.0), alg::vec(2.0, 0.0), alg::vec(4.0, 2.0),
+    };
+
+    const auto hull = alg::convex_hull(points);
+    const alg::polygon<double> expected = {
+        alg::vec(0.0, 0.0), alg::vec(4.0, 0.0), alg::vec(4.0, 4.0), alg::vec(0.0, 4.0),
+    };
+    REQUIRE(hull == expected);
+}
+
+TEST_CASE("convex_hull - points on a circle are all vertices", "[convex_hull]")
+{
+    std::vector<alg::vector_2d<double>> points;
+    for (std::size_t i = 0; i < 360; ++i)
+    {
+        const double angle = 2.0 * M_PI * double(i) / 360.0;
+        points.push_back(alg::vec(10.0 * std::cos(angle), 10.0 * std::sin(angle)));
+    }
+    points.push_back(alg::vec(0.0, 0.0));
+
+    const auto hull = alg::convex_hull(points);
+    REQUIRE(hull.size() == 360);
+    check_hull(points, hull);
+}
+
+TEST_CASE("convex_hull - degenerate inputs", "[convex_hull]")
+{
+    using points_t = std::vector<alg::vector_2d<double>>;
+
+    REQUIRE(alg::convex_hull(points_t{}).empty());
+    REQUIRE(
+        alg::convex_hull(points_t{ alg::vec(1.0, 2.0), alg::vec(1.0, 2.0) })
+        == alg::polygon<double>{ alg::vec(1.0, 2.0) });
+
+    const points_t collinear = { alg::vec(3.0, 3.0), alg::vec(1.0, 1.0), alg::vec(2.0, 2.0), alg::vec(0.0, 0.0) };
+    REQUIRE(alg::convex_hull(collinear) == alg::polygon<double>{ alg::vec(0.0, 0.0), alg::vec(3.0, 3.0) });
+
+    // Points near the line y = x, whose turns the plain cross product gets wrong.
+    points_t nearly_collinear;
+    const double unit = std::ldexp(1.0, -53);
+    for (int i = 0; i < 32; ++i)
+    {
+        for (int j = 0; j < 32; ++j)
+        {
+            nearly_collinear.push_back(alg::vec(0.5 + i * unit, 0.5 + j * unit));
+        }
+    }
+    nearly_collinear.push_back(alg::vec(12.0, 12.0));
+    nearly_collinear.push_back(alg::vec(24.0, 24.0));
+    check_hull(nearly_collinear, alg::convex_hull(nearly_collinear));
+}
+
+TEST_CASE("convex_hull - integer points with collinear boundary points", "[convex_hull]")
+{
+    std::vector<alg::vector_2d<int>> points;
+    for (int x = 0; x <= 10; ++x)
+    {
+        for (int y = 0; y <= 10 - x; ++y)
+        {
+            points.push_back(alg::vec(x, y));
+        }
+    }
+
+    REQUIRE(alg::convex_hull(points) == alg::polygon<int>{ alg::vec(0, 0), alg::vec(10, 0), alg::vec(0, 10) });
+}
+
+TEST_CASE("convex_hull - threads give the same hull", "[convex_hull]")
+{
+    const auto points = random_points<double>(200000, 7);
+    const auto hull = alg::convex_hull(points);
+
+    REQUIRE(alg::convex_hull(points, 4) == hull);
+    REQUIRE(alg::convex_hull(points, 3) == hull);
+    check_hull(points, hull);
+}
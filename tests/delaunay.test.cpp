@@ -0,0 +1,165 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+#include <ferrugo/alg/convex_hull.hpp>
+#include <ferrugo/alg/delaunay.hpp>
+#include <algorithm>
+#include <random>
+
+using namespace ferrugo;
+
+namespace
+{
+
+template <class T>
+auto random_points(std::size_t count, std::uint32_t seed) -> std::vector<alg::vector_2d<T>>
+{
+    std::mt19937 generator{ seed };
+    std::uniform_real_distribution<T> position{ T(-50), T(50) };
+
+    std::vector<alg::vector_2d<T>> result(count);
+    for (auto& item : result)
+    {
+        item = alg::vec(position(generator), position(generator));
+    }
+    return result;
+}
+
+template <class T>
+auto signed_area(const alg::vector_2d<T>& a, const alg::vector_2d<T>& b, const alg::vector_2d<T>& c) -> double
+{
+    return 0.5 * alg::cross(alg::vector_2d<double>{ b - a }, alg::vector_2d<double>{ c - a });
+}
+
+// The triangles are counterclockwise and locally Delaunay, the neighbors are symmetric, every distinct point is a
+// vertex and the triangles cover the convex hull.
+template <class T>
+void check_triangulation(const std::vector<alg::vector_2d<T>>& points, const alg::delaunay_triangulation<T>& mesh)
+{
+    using index_type = typename alg::delaunay_triangulation<T>::index_type;
+    const auto no_neighbor = alg::delaunay_triangulation<T>::no_neighbor;
+
+    const auto& triangles = mesh.triangles();
+    const auto& neighbors = mesh.neighbors();
+    REQUIRE(neighbors.size() == triangles.size());
+
+    std::vector<bool> used(points.size(), false);
+    double area = 0.0;
+
+    for (std::size_t i = 0; i < triangles.size(); ++i)
+    {
+        const auto& item = triangles[i];
+        const auto& a = points[item[0]];
+        const auto& b = points[item[1]];
+        const auto& c = points[item[2]];
+        REQUIRE(alg::predicates::orient2d(a, b, c) > T(0));
+        area += signed_area(a, b, c);
+
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+            used[item[j]] = true;
+
+            const index_type other = neighbors[i][j];
+            if (other == no_neighbor)
+            {
+                continue;
+            }
+
+            const auto& back = neighbors[other];
+            const auto k = std::size_t(std::find(back.begin(), back.end(), index_type(i)) - back.begin());
+            REQUIRE(k < 3);
+
+            // The shared edge, in opposite directions, and the vertex opposite to it.
+            REQUIRE(triangles[other][(k + 1) % 3] == item[(j + 2) % 3]);
+            REQUIRE(triangles[other][(k + 2) % 3] == item[(j + 1) % 3]);
+            REQUIRE(alg::predicates::incircle(a, b, c, points[triangles[other][k]]) <= T(0));
+        }
+    }
+
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        const bool repeated = std::find(points.begin(), points.begin() + i, points[i]) != points.begin() + i;
+        REQUIRE((used[i] || repeated));
+    }
+
+    const auto hull = alg::convex_hull(points);
+    double hull_area = 0.0;
+    for (std::size_t i = 1; i + 1 < hull.size(); ++i)
+    {
+        hull_area += signed_area(hull[0], hull[i], hull[i + 1]);
+    }
+    REQUIRE_THAT(area, Catch::Matchers::WithinAbs(hull_area, 1e-6 * hull_area));
+}
+
+}  // namespace
+
+TEST_CASE("delaunay_triangulation - random points", "[delaunay]")
+{
+    for (std::size_t count : { 3, 4, 10, 100, 5000 })
+    {
+        const auto points = random_points<double>(count, 11);
+        const alg::delaunay_triangulation<double> mesh{ points };
+        check_triangulation(points, mesh);
+
+        const auto hull = alg::convex_hull(points);
+        REQUIRE(mesh.size() == 2 * count - 2 - hull.size());
+    }
+
+    const auto points = random_points<float>(2000, 12);
+    check_triangulation(points, alg::delaunay_triangulation<float>{ points });
+}
+
+TEST_CASE("delaunay_triangulation - cocircular and collinear points on a grid", "[delaunay]")
+{
+    std::vector<alg::vector_2d<double>> points;
+    for (int x = 0; x < 30; ++x)
+    {
+        for (int y = 0; y < 20; ++y)
+        {
+            points.push_back(alg::vec(0.25 * x, 0.5 * y));
+        }
+    }
+
+    const alg::delaunay_triangulation<double> mesh{ points };
+    check_triangulation(points, mesh);
+    REQUIRE(mesh.size() == 2 * 29 * 19);
+}
+
+TEST_CASE("delaunay_triangulation - degenerate inputs", "[delaunay]")
+{
+    using points_t = std::vector<alg::vector_2d<double>>;
+
+    const points_t none = {};
+    const points_t repeated = { alg::vec(1.0, 1.0), alg::vec(1.0, 1.0) };
+    const points_t collinear = { alg::vec(0.0, 0.0), alg::vec(2.0, 2.0), alg::vec(1.0, 1.0), alg::vec(3.0, 3.0) };
+    REQUIRE(alg::delaunay_triangulation<double>{ none }.empty());
+    REQUIRE(alg::delaunay_triangulation<double>{ repeated }.empty());
+    REQUIRE(alg::delaunay_triangulation<double>{ collinear }.empty());
+
+    // Collinear points first, then repeated points and points on the hull edges.
+    points_t points = { alg::vec(0.0, 0.0), alg::vec(1.0, 0.0), alg::vec(2.0, 0.0), alg::vec(3.0, 0.0),
+                        alg::vec(1.0, 2.0), alg::vec(2.0, 0.0), alg::vec(0.5, 1.0), alg::vec(1.0, 2.0) };
+    const alg::delaunay_triangulation<double> mesh{ points };
+    check_triangulation(points, mesh);
+    REQUIRE(mesh.size() == 4);
+}
+
+TEST_CASE("delaunay_triangulation - triangles", "[delaunay]")
+{
+    const std::vector<alg::vector_2d<double>> points = {
+        alg::vec(0.0, 0.0), alg::vec(4.0, 0.0), alg::vec(4.0, 3.0), alg::vec(0.0, 3.0), alg::vec(1.0, 1.0)
+    };
+
+    const alg::delaunay_triangulation<double> mesh{ points };
+    const auto triangles = mesh.to_triangles();
+    REQUIRE(triangles.size() == 4);
+
+    for (std::size_t i = 0; i < triangles.size(); ++i)
+    {
+        REQUIRE(triangles[i] == mesh.triangle(i));
+        REQUIRE(triangles[i][0] == points[mesh.triangles()[i][0]]);
+        for (const auto& point : points)
+        {
+            REQUIRE(alg::predicates::incircle(triangles[i], point) <= 0.0);
+        }
+    }
+}
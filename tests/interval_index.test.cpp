@@ -0,0 +1,121 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+#include <ferrugo/alg/interval_index.hpp>
+#include <random>
+
+using namespace ferrugo;
+
+namespace
+{
+
+template <class T>
+auto overlaps(const alg::interval<T>& lhs, const alg::interval<T>& rhs) -> bool
+{
+    return alg::lower(lhs) < alg::upper(rhs) && alg::lower(rhs) < alg::upper(lhs) && alg::lower(lhs) < alg::upper(lhs)
+           && alg::lower(rhs) < alg::upper(rhs);
+}
+
+template <class T>
+auto sorted(std::vector<std::size_t> values) -> std::vector<std::size_t>
+{
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+template <class T>
+void check_queries(const alg::interval_index<T>& index, const std::vector<alg::interval<T>>& items, T value, T length)
+{
+    std::vector<std::size_t> expected;
+    for (std::size_t i = 0; i < items.size(); ++i)
+    {
+        if (alg::contains(items[i], value))
+        {
+            expected.push_back(i);
+        }
+    }
+    REQUIRE(sorted<T>(index.stabbing(value)) == expected);
+    REQUIRE(index.count(value) == expected.size());
+
+    const auto range = alg::interval<T>{ value, value + length };
+    expected.clear();
+    for (std::size_t i = 0; i < items.size(); ++i)
+    {
+        if (overlaps(items[i], range))
+        {
+            expected.push_back(i);
+        }
+    }
+    REQUIRE(sorted<T>(index.overlapping(range)) == expected);
+    REQUIRE(index.count(range) == expected.size());
+}
+
+}  // namespace
+
+TEST_CASE("interval_index - random intervals", "[interval_index]")
+{
+    std::mt19937 generator{ 5 };
+    std::uniform_int_distribution<int> position{ 0, 1000 };
+    std::uniform_int_distribution<int> length{ -5, 60 };
+
+    std::vector<alg::interval<int>> items;
+    for (std::size_t i = 0; i < 3000; ++i)
+    {
+        const int lo = position(generator);
+        items.push_back(alg::interval<int>{ lo, lo + length(generator) });
+    }
+
+    const alg::interval_index<int> index{ items };
+
+    std::size_t empty_count = 0;
+    for (const auto& item : items)
+    {
+        empty_count += alg::upper(item) <= alg::lower(item);
+    }
+    REQUIRE(index.size() == items.size() - empty_count);
+
+    for (int value = -10; value <= 1080; value += 3)
+    {
+        check_queries(index, items, value, 0);
+        check_queries(index, items, value, 1);
+        check_queries(index, items, value, 25);
+    }
+
+    // Reported in order of the lower bounds.
+    const auto result = index.stabbing(500);
+    REQUIRE(std::is_sorted(
+        result.begin(),
+        result.end(),
+        [&](std::size_t lhs, std::size_t rhs) { return alg::lower(items[lhs]) < alg::lower(items[rhs]); }));
+}
+
+TEST_CASE("interval_index - half-open bounds", "[interval_index]")
+{
+    const std::vector<alg::interval<double>> items{
+        alg::interval<double>{ 0.0, 1.0 },
+        alg::interval<double>{ 1.0, 2.0 },
+        alg::interval<double>{ 1.5, 1.5 },
+        alg::interval<double>{ 0.5, 3.0 },
+    };
+
+    const alg::interval_index<double> index{ items };
+    REQUIRE(index.size() == 3);
+
+    REQUIRE(sorted<double>(index.stabbing(0.0)) == std::vector<std::size_t>{ 0 });
+    REQUIRE(sorted<double>(index.stabbing(1.0)) == std::vector<std::size_t>{ 1, 3 });
+    REQUIRE(sorted<double>(index.stabbing(1.5)) == std::vector<std::size_t>{ 1, 3 });
+    REQUIRE(index.stabbing(3.0).empty());
+    REQUIRE(index.count(1.0) == 2);
+    REQUIRE(index.count(3.0) == 0);
+
+    REQUIRE(sorted<double>(index.overlapping(alg::interval<double>{ 2.0, 2.5 })) == std::vector<std::size_t>{ 3 });
+    REQUIRE(sorted<double>(index.overlapping(alg::interval<double>{ -1.0, 0.0 })).empty());
+    REQUIRE(sorted<double>(index.overlapping(alg::interval<double>{ 0.9, 1.0 })) == std::vector<std::size_t>{ 0, 3 });
+    REQUIRE(index.overlapping(alg::interval<double>{ 1.0, 1.0 }).empty());
+    REQUIRE(index.count(alg::interval<double>{ 0.9, 1.0 }) == 2);
+    REQUIRE(index.count(alg::interval<double>{ 1.0, 1.0 }) == 0);
+
+    const alg::interval_index<double> empty{};
+    REQUIRE(empty.empty());
+    REQUIRE(empty.stabbing(1.0).empty());
+    REQUIRE(empty.count(1.0) == 0);
+}
@@ -0,0 +1,140 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+#include <ferrugo/alg/kd_tree.hpp>
+#include <algorithm>
+#include <random>
+
+using namespace ferrugo;
+
+namespace
+{
+
+template <class T, std::size_t D>
+auto random_points(std::size_t count, std::uint32_t seed) -> std::vector<alg::vector<T, D>>
+{
+    std::mt19937 generator{ seed };
+    std::uniform_real_distribution<T> position{ T(-50), T(50) };
+
+    std::vector<alg::vector<T, D>> result(count);
+    for (auto& item : result)
+    {
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            item[d] = position(generator);
+        }
+    }
+    return result;
+}
+
+// Distances from `point` to all points, sorted, as found by a linear scan.
+template <class T, std::size_t D>
+auto sorted_distances(const std::vector<alg::vector<T, D>>& points, const alg::vector<T, D>& point) -> std::vector<T>
+{
+    std::vector<T> result;
+    for (const auto& item : points)
+    {
+        result.push_back(std::sqrt(alg::norm(item - point)));
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+template <class T, std::size_t D>
+void check_neighbor(const std::vector<alg::vector<T, D>>& points,
+                    const alg::vector<T, D>& point,
+                    const typename alg::kd_tree<T, D>::neighbor& actual,
+                    T expected_distance)
+{
+    REQUIRE(actual.index < points.size());
+    REQUIRE(actual.distance == expected_distance);
+    REQUIRE(std::sqrt(alg::norm(points[actual.index] - point)) == expected_distance);
+}
+
+template <class T, std::size_t D>
+void check_kd_tree(std::size_t count)
+{
+    const auto points = random_points<T, D>(count, 3);
+    const auto queries = random_points<T, D>(50, 4);
+    const alg::kd_tree<T, D> tree{ points };
+
+    REQUIRE(tree.size() == count);
+
+    for (const auto& query : queries)
+    {
+        const auto expected = sorted_distances(points, query);
+
+        check_neighbor(points, query, tree.nearest(query), expected[0]);
+
+        const auto nearest = tree.k_nearest(query, 5);
+        REQUIRE(nearest.size() == std::min<std::size_t>(5, count));
+        for (std::size_t i = 0; i < nearest.size(); ++i)
+        {
+            check_neighbor(points, query, nearest[i], expected[i]);
+        }
+
+        const T radius = T(12);
+        auto within = tree.within_radius(query, radius);
+        std::sort(
+            within.begin(), within.end(), [](const auto& lhs, const auto& rhs) { return lhs.distance < rhs.distance; });
+        const auto expected_count = static_cast<std::size_t>(
+            std::upper_bound(expected.begin(), expected.end(), radius) - expected.begin());
+        REQUIRE(within.size() == expected_count);
+        for (std::size_t i = 0; i < within.size(); ++i)
+        {
+            check_neighbor(points, query, within[i], expected[i]);
+        }
+    }
+
+    // Points of the set are their own nearest neighbors.
+    for (std::size_t i = 0; i < count; i += 17)
+    {
+        const auto result = tree.nearest(points[i]);
+        REQUIRE(result.distance == T(0));
+        REQUIRE(points[result.index] == points[i]);
+    }
+
+    for (const std::size_t threads : { 1, 4 })
+    {
+        const auto nearest = tree.nearest_all(queries, threads);
+        REQUIRE(nearest.size() == queries.size());
+
+        const auto k_nearest = tree.k_nearest_all(queries, 3, threads);
+        REQUIRE(k_nearest.size() == queries.size() * std::min<std::size_t>(3, count));
+
+        for (std::size_t q = 0; q < queries.size(); ++q)
+        {
+            const auto expected = tree.k_nearest(queries[q], 3);
+            REQUIRE(nearest[q].index == expected[0].index);
+            for (std::size_t i = 0; i < expected.size(); ++i)
+            {
+                REQUIRE(k_nearest[q * expected.size() + i].index == expected[i].index);
+            }
+        }
+    }
+}
+
+}  // namespace
+
+TEST_CASE("kd_tree", "[kd_tree]")
+{
+    check_kd_tree<float, 2>(1000);
+    check_kd_tree<double, 2>(3);
+    check_kd_tree<double, 3>(2000);
+
+    const alg::kd_tree_2d<float> tree{};
+    REQUIRE(tree.empty());
+    REQUIRE(tree.k_nearest(alg::vec(1.F, 2.F), 3).empty());
+    REQUIRE(tree.within_radius(alg::vec(1.F, 2.F), 3.F).empty());
+    REQUIRE_THROWS_AS(tree.nearest(alg::vec(1.F, 2.F)), std::runtime_error);
+}
+
+TEST_CASE("kd_tree - duplicate points", "[kd_tree]")
+{
+    const std::vector<alg::vector_2d<float>> points(100, alg::vec(1.F, 1.F));
+    const alg::kd_tree_2d<float> tree{ points };
+
+    REQUIRE(tree.k_nearest(alg::vec(2.F, 1.F), 10).size() == 10);
+    REQUIRE(tree.within_radius(alg::vec(2.F, 1.F), 1.F).size() == 100);
+    REQUIRE(tree.within_radius(alg::vec(2.F, 1.F), 0.5F).empty());
+    REQUIRE(tree.nearest(alg::vec(0.F, 1.F)).distance == 1.F);
+}
@@ -0,0 +1,184 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+#include <ferrugo/alg/lattice.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace ferrugo;
+
+namespace
+{
+
+template <class Range>
+auto collect(const Range& range) -> std::vector<std::decay_t<decltype(*range.begin())>>
+{
+    std::vector<std::decay_t<decltype(*range.begin())>> result;
+    for (const auto& item : range)
+    {
+        result.push_back(item);
+    }
+    return result;
+}
+
+auto make_region(int x0, int y0, int x1, int y1) -> alg::region_2d<int>
+{
+    return alg::region_2d<int>{ alg::interval<int>{ x0, x1 }, alg::interval<int>{ y0, y1 } };
+}
+
+auto less(const alg::vector_2d<int>& lhs, const alg::vector_2d<int>& rhs) -> bool
+{
+    return std::make_pair(lhs[1], lhs[0]) < std::make_pair(rhs[1], rhs[0]);
+}
+
+}  // namespace
+
+TEST_CASE("cells - row-major order", "[lattice]")
+{
+    const auto region = make_region(-2, 3, 1, 5);
+
+    std::vector<alg::vector_2d<int>> expected;
+    for (int y = 3; y < 5; ++y)
+    {
+        for (int x = -2; x < 1; ++x)
+        {
+            expected.push_back(alg::vec(x, y));
+        }
+    }
+
+    const auto range = alg::cells(region);
+    REQUIRE(range.size() == 6);
+    REQUIRE(collect(range) == expected);
+    for (const auto& cell : range)
+    {
+        REQUIRE(alg::contains(region, cell));
+    }
+
+    REQUIRE(collect(alg::cells(make_region(0, 0, 0, 5))).empty());
+    REQUIRE(collect(alg::cells(make_region(0, 0, 5, 0))).empty());
+    REQUIRE(alg::cells(make_region(3, 0, 1, 5)).empty());
+}
+
+TEST_CASE("cells - three dimensions", "[lattice]")
+{
+    const alg::region_3d<int> region = {
+        alg::interval<int>{ 0, 2 },
+        alg::interval<int>{ 1, 4 },
+        alg::interval<int>{ -1, 1 },
+    };
+
+    const auto cells = collect(alg::cells(region));
+    REQUIRE(cells.size() == 12);
+    REQUIRE(cells.front() == alg::vector_3d<int>{ 0, 1, -1 });
+    REQUIRE(cells[1] == alg::vector_3d<int>{ 1, 1, -1 });
+    REQUIRE(cells[2] == alg::vector_3d<int>{ 0, 2, -1 });
+    REQUIRE(cells.back() == alg::vector_3d<int>{ 1, 3, 0 });
+
+    auto morton = collect(alg::cells(region, alg::morton_tag{}));
+    REQUIRE(morton.size() == 12);
+    REQUIRE(morton[1] == alg::vector_3d<int>{ 1, 1, -1 });
+    REQUIRE(morton[2] == alg::vector_3d<int>{ 0, 2, -1 });
+    REQUIRE(morton[4] == alg::vector_3d<int>{ 0, 1, 0 });
+}
+
+TEST_CASE("rows - row-major order", "[lattice]")
+{
+    const alg::region_3d<int> region = {
+        alg::interval<int>{ -2, 1 },
+        alg::interval<int>{ 1, 3 },
+        alg::interval<int>{ 0, 2 },
+    };
+
+    const auto range = alg::rows(region);
+    REQUIRE(range.size() == 4);
+
+    std::vector<alg::vector_3d<int>> cells;
+    for (const auto& row : range)
+    {
+        REQUIRE(row.first[0] == -2);
+        REQUIRE(row.upper == 1);
+        REQUIRE(row.size() == 3);
+        for (int x = row.first[0]; x < row.upper; ++x)
+        {
+            cells.push_back(alg::vector_3d<int>{ x, row.first[1], row.first[2] });
+        }
+    }
+    REQUIRE(cells == collect(alg::cells(region)));
+
+    REQUIRE(collect(alg::rows(make_region(0, 0, 0, 5))).empty());
+    REQUIRE(collect(alg::rows(make_region(0, 0, 5, 0))).empty());
+    REQUIRE(alg::rows(make_region(3, 0, 1, 5)).empty());
+    REQUIRE(alg::rows(make_region(0, 0, 1, 5)).size() == 5);
+}
+
+TEST_CASE("cells - Morton order", "[lattice]")
+{
+    const auto square = collect(alg::cells(make_region(10, 20, 14, 24), alg::morton_tag{}));
+    const std::vector<alg::vector_2d<int>> expected = {
+        alg::vec(10, 20), alg::vec(11, 20), alg::vec(10, 21), alg::vec(11, 21),
+        alg::vec(12, 20), alg::vec(13, 20), alg::vec(12, 21), alg::vec(13, 21),
+        alg::vec(10, 22), alg::vec(11, 22), alg::vec(10, 23), alg::vec(11, 23),
+        alg::vec(12, 22), alg::vec(13, 22), alg::vec(12, 23), alg::vec(13, 23),
+    };
+    REQUIRE(square == expected);
+
+    // Regions of any shape give each cell once, in increasing Morton code.
+    for (const auto& region : { make_region(-3, 5, 4, 6), make_region(0, 0, 1, 37), make_region(-7, -9, 30, 12) })
+    {
+        const auto range = alg::cells(region, alg::morton_tag{});
+        auto cells = collect(range);
+        REQUIRE(cells.size() == range.size());
+
+        const auto code = [&](const alg::vector_2d<int>& cell)
+        {
+            std::uint64_t result = 0;
+            for (std::size_t bit = 0; bit < 16; ++bit)
+            {
+                result |= std::uint64_t((cell[0] - region[0][0]) >> bit & 1) << (2 * bit);
+                result |= std::uint64_t((cell[1] - region[1][0]) >> bit & 1) << (2 * bit + 1);
+            }
+            return result;
+        };
+        for (std::size_t i = 1; i < cells.size(); ++i)
+        {
+            REQUIRE(code(cells[i - 1]) < code(cells[i]));
+        }
+
+        std::sort(cells.begin(), cells.end(), less);
+        REQUIRE(cells == collect(alg::cells(region)));
+    }
+
+    REQUIRE(collect(alg::cells(make_region(0, 0, 0, 5), alg::morton_tag{})).empty());
+}
+
+TEST_CASE("raster - Bresenham segments in all directions", "[lattice]")
+{
+    for (int x = -6; x <= 6; ++x)
+    {
+        for (int y = -6; y <= 6; ++y)
+        {
+            const alg::segment_2d<int> segment{ alg::vec(2, -1), alg::vec(2 + x, -1 + y) };
+            const auto range = alg::raster(segment);
+            const auto cells = collect(range);
+
+            REQUIRE(cells.size() == std::size_t(std::max(std::abs(x), std::abs(y)) + 1));
+            REQUIRE(range.size() == cells.size());
+            REQUIRE(cells.front() == segment[0]);
+            REQUIRE(cells.back() == segment[1]);
+
+            for (std::size_t i = 0; i < cells.size(); ++i)
+            {
+                if (i != 0)
+                {
+                    const auto step = cells[i] - cells[i - 1];
+                    REQUIRE(std::max(std::abs(step[0]), std::abs(step[1])) == 1);
+                }
+
+                // Within half a cell of the line along the minor axis.
+                const auto offset = cells[i] - segment[0];
+                const double distance = std::abs(double(offset[0]) * y - double(offset[1]) * x);
+                REQUIRE(distance <= 0.5 * std::max(std::abs(x), std::abs(y)));
+            }
+        }
+    }
+}
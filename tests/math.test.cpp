@@ -0,0 +1,219 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+#include <ferrugo/alg/operations.hpp>
+#include <limits>
+#include <random>
+
+using namespace ferrugo;
+
+namespace
+{
+
+// Error of `value` in units in the last place of the correctly rounded `exact`, computed in long double, which has
+// enough extra bits for float and double.
+template <class T>
+auto ulp_error(T value, long double exact) -> double
+{
+    const T rounded = std::abs(static_cast<T>(exact));
+    const T ulp = std::nextafter(rounded, std::numeric_limits<T>::infinity()) - rounded;
+    return static_cast<double>(std::abs(static_cast<long double>(value) - exact) / ulp);
+}
+
+template <class T>
+auto random_values(std::size_t count, T lo, T up, std::uint32_t seed) -> std::vector<T>
+{
+    std::mt19937 generator{ seed };
+    std::uniform_real_distribution<T> distribution{ lo, up };
+    std::vector<T> result(count);
+    for (auto& value : result)
+    {
+        value = distribution(generator);
+    }
+    return result;
+}
+
+template <class T>
+void check_sincos(T range, double max_ulp, double max_abs)
+{
+    for (const T x : random_values<T>(100000, -range, range, 3))
+    {
+        const auto [s, c] = alg::fast::sincos(x);
+        REQUIRE(ulp_error(s, std::sin(static_cast<long double>(x))) <= max_ulp);
+        REQUIRE(ulp_error(c, std::cos(static_cast<long double>(x))) <= max_ulp);
+        REQUIRE(std::abs(s - std::sin(static_cast<long double>(x))) <= max_abs);
+        REQUIRE(std::abs(c - std::cos(static_cast<long double>(x))) <= max_abs);
+        REQUIRE(alg::fast::sin(x) == s);
+        REQUIRE(alg::fast::cos(x) == c);
+    }
+}
+
+template <class T>
+void check_atan2(double max_ulp)
+{
+    const auto y = random_values<T>(100000, T(-100), T(100), 4);
+    const auto x = random_values<T>(100000, T(-100), T(100), 5);
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        const auto exact = std::atan2(static_cast<long double>(y[i]), static_cast<long double>(x[i]));
+        REQUIRE(ulp_error(alg::fast::atan2(y[i], x[i]), exact) <= max_ulp);
+    }
+
+    const T values[] = { T(0), -T(0), T(1), T(-1), T(3), T(-0.5) };
+    for (const T a : values)
+    {
+        for (const T b : values)
+        {
+            const T expected = std::atan2(a, b);
+            const T actual = alg::fast::atan2(a, b);
+            REQUIRE(ulp_error(actual, expected) <= max_ulp);
+            REQUIRE(std::signbit(actual) == std::signbit(expected));
+        }
+    }
+    REQUIRE(std::isnan(alg::fast::atan2(std::numeric_limits<T>::quiet_NaN(), T(1))));
+    REQUIRE(std::isnan(alg::fast::atan2(T(1), std::numeric_limits<T>::quiet_NaN())));
+}
+
+template <class T>
+void check_batches()
+{
+    // Sizes around the register widths exercise both the SIMD kernels and the scalar remainder.
+    for (std::size_t size : { 0, 1, 3, 4, 5, 8, 13, 37 })
+    {
+        const auto x = random_values<T>(size, T(-10), T(10), 6);
+        const auto y = random_values<T>(size, T(-10), T(10), 7);
+
+        std::vector<T> s;
+        std::vector<T> c;
+        std::vector<T> sines;
+        std::vector<T> cosines;
+        std::vector<T> angles;
+        std::vector<T> roots;
+        alg::fast::sincos(x, s, c);
+        alg::fast::sin(x, sines);
+        alg::fast::cos(x, cosines);
+        alg::fast::atan2(y, x, angles);
+        alg::fast::sqrt(y, roots);
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            const auto expected = alg::fast::sincos(x[i]);
+            REQUIRE(s[i] == expected.first);
+            REQUIRE(c[i] == expected.second);
+            REQUIRE(sines[i] == expected.first);
+            REQUIRE(cosines[i] == expected.second);
+            REQUIRE(angles[i] == alg::fast::atan2(y[i], x[i]));
+            REQUIRE((std::isnan(roots[i]) ? y[i] < T(0) : roots[i] == std::sqrt(y[i])));
+        }
+
+        auto in_place = x;
+        alg::fast::sin(alg::span<const T>{ in_place }, alg::span<T>{ in_place });
+        REQUIRE(in_place == sines);
+    }
+
+    const std::vector<T> x(5);
+    std::vector<T> out(4);
+    REQUIRE_THROWS_AS(alg::fast::sin(alg::span<const T>{ x }, alg::span<T>{ out }), std::runtime_error);
+    REQUIRE_THROWS_AS(
+        alg::fast::atan2(alg::span<const T>{ x }, alg::span<const T>{ out }, alg::span<T>{ out }), std::runtime_error);
+}
+
+}  // namespace
+
+TEST_CASE("fast math - sin and cos", "[math]")
+{
+    // Within pi/4 there is no reduction; beyond it the error is only bounded absolutely, since sin or cos approach zero
+    // near the multiples of pi/2, where the reduction cancels.
+    const double any_ulp = std::numeric_limits<double>::infinity();
+    check_sincos<float>(0.78539816F, 1.0, 1e-7);
+    check_sincos<float>(1e4F, any_ulp, 1e-7);
+    check_sincos<double>(0.785398163397448, 1.0, 2e-16);
+    check_sincos<double>(1e9, any_ulp, 2e-16);
+
+    const double near_zeros[] = { 1.5707963267948966, 3.141592653589793, 4.71238898038469, 15332967.060853221 };
+    for (const double x : near_zeros)
+    {
+        const auto [s, c] = alg::fast::sincos(x);
+        REQUIRE(std::abs(s - std::sin(static_cast<long double>(x))) <= 2e-16);
+        REQUIRE(std::abs(c - std::cos(static_cast<long double>(x))) <= 2e-16);
+    }
+
+    REQUIRE(alg::fast::sin(-0.F) == 0.F);
+    REQUIRE(alg::fast::cos(0.0) == 1.0);
+    REQUIRE(std::isnan(alg::fast::sin(std::numeric_limits<float>::quiet_NaN())));
+    REQUIRE(std::isnan(alg::fast::cos(std::numeric_limits<double>::infinity())));
+}
+
+TEST_CASE("fast math - atan2", "[math]")
+{
+    check_atan2<float>(3.0);
+    check_atan2<double>(2.0);
+}
+
+TEST_CASE("fast math - sqrt and acos", "[math]")
+{
+    for (const double x : random_values<double>(1000, 0.0, 1e6, 8))
+    {
+        REQUIRE(alg::fast::sqrt(x) == std::sqrt(x));
+        REQUIRE(alg::fast::sqrt(static_cast<float>(x)) == std::sqrt(static_cast<float>(x)));
+    }
+    REQUIRE(std::isnan(alg::fast::sqrt(-1.F)));
+
+    for (const double x : random_values<double>(1000, -1.0, 1.0, 9))
+    {
+        REQUIRE_THAT(alg::fast::acos(x), Catch::Matchers::WithinAbs(std::acos(x), 1e-15));
+    }
+    REQUIRE(alg::fast::acos(1.0) == 0.0);
+    REQUIRE(std::isnan(alg::fast::acos(1.5F)));
+}
+
+TEST_CASE("fast math - batches match the scalar functions", "[math]")
+{
+    check_batches<float>();
+    check_batches<double>();
+}
+
+TEST_CASE("math policies - rotation, angle, length and unit", "[math]")
+{
+    const auto [s, c] = alg::sincos(0.7);
+    REQUIRE(s == std::sin(0.7));
+    REQUIRE(c == std::cos(0.7));
+
+    for (const float a : random_values<float>(100, -10.F, 10.F, 10))
+    {
+        const auto precise = alg::rotation(a);
+        const auto fast = alg::fast::rotation(a);
+        for (std::size_t r = 0; r < 3; ++r)
+        {
+            for (std::size_t col = 0; col < 3; ++col)
+            {
+                REQUIRE_THAT(fast(r, col), Catch::Matchers::WithinAbs(precise(r, col), 2e-7));
+            }
+        }
+    }
+
+    const auto u = alg::vec(3.0, 4.0);
+    const auto v = alg::vec(-2.0, 1.0);
+    REQUIRE_THAT(alg::fast::angle(u, v), Catch::Matchers::WithinAbs(alg::angle(u, v), 1e-15));
+    REQUIRE_THAT(alg::fast::angle(v, u), Catch::Matchers::WithinAbs(alg::angle(v, u), 1e-15));
+    REQUIRE(alg::fast::length(u) == 5.0);
+    REQUIRE(alg::fast::length(alg::segment_2d<double>{ u, v }) == alg::length(alg::segment_2d<double>{ u, v }));
+    REQUIRE(alg::fast::unit(u) == alg::vec(0.6, 0.8));
+
+    const auto p = alg::vec(1.F, 2.F, 2.F);
+    const auto q = alg::vec(0.F, -1.F, 4.F);
+    REQUIRE_THAT(alg::fast::angle(p, q), Catch::Matchers::WithinAbs(alg::angle(p, q), 1e-6));
+    REQUIRE(alg::fast::length(p) == 3.F);
+
+    // Integer vectors are measured in double, as by the precise policy.
+    const auto i = alg::vec(3, 4);
+    const auto j = alg::vec(-2, 1);
+    REQUIRE(alg::fast::length(i) == 5.0);
+    REQUIRE(alg::fast::length(i) == alg::length(i));
+    REQUIRE(alg::fast::unit(i) == alg::vec(0.6, 0.8));
+    REQUIRE(alg::fast::unit(i) == alg::unit(i));
+    REQUIRE_THAT(alg::fast::angle(i, j), Catch::Matchers::WithinAbs(alg::angle(i, j), 1e-15));
+    const auto angle = alg::fast::angle(alg::vec(1, 2, 2), alg::vec(0, -1, 4));
+    REQUIRE_THAT(angle, Catch::Matchers::WithinAbs(alg::angle(p, q), 1e-6));
+    REQUIRE(alg::fast::sqrt(16) == 4.0);
+    REQUIRE(alg::fast::sin(0) == 0.0);
+}
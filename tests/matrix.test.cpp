@@ -1,6 +1,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_all.hpp>
+#include <ferrugo/alg/circular_shapes.hpp>
 #include <ferrugo/alg/interval.hpp>
+#include <ferrugo/alg/linear_shapes.hpp>
 #include <ferrugo/alg/matrix.hpp>
 #include <ferrugo/alg/polygon.hpp>
 #include <ferrugo/alg/region.hpp>
@@ -28,3 +30,427 @@ TEST_CASE("matrix - comparison", "[matrix]")
     // std::cout << alg::invert(alg::square_matrix_3d<int>{}).value() << std::endl;
     // std::cout << alg::rotation(0.2F) << std::endl;
 }
+
+TEST_CASE("matrix - 3x3 and 4x4 products match the generic path", "[matrix]")
+{
+    const auto a = alg::square_matrix<int, 4>{ 1, -2, 3, 4, 5, 6, -7, 8, 9, 10, 11, -12, 13, -14, 15, 16 };
+    const auto b = alg::square_matrix<int, 4>{ 2, 0, -1, 3, 1, 4, 2, -2, 0, 5, 1, 1, -3, 2, 2, 6 };
+    const auto a3 = alg::square_matrix<int, 3>{ 1, -2, 3, 4, 5, 6, -7, 8, 9 };
+    const auto b3 = alg::square_matrix<int, 3>{ 2, 0, -1, 3, 1, 4, 2, -2, 0 };
+
+    REQUIRE(alg::square_matrix<float, 4>{ a } * alg::square_matrix<float, 4>{ b } == a * b);
+    REQUIRE(alg::square_matrix<double, 4>{ a } * alg::square_matrix<double, 4>{ b } == a * b);
+    REQUIRE(alg::square_matrix<float, 3>{ a3 } * alg::square_matrix<float, 3>{ b3 } == a3 * b3);
+    REQUIRE(alg::square_matrix<double, 3>{ a3 } * alg::square_matrix<double, 3>{ b3 } == a3 * b3);
+
+    REQUIRE(alg::vector_3d<float>{ 1.F, -2.F, 3.F } * alg::square_matrix<float, 4>{ a } == alg::vec(1, -2, 3) * a);
+    REQUIRE(alg::vector_3d<double>{ 1.0, -2.0, 3.0 } * alg::square_matrix<double, 4>{ a } == alg::vec(1, -2, 3) * a);
+    REQUIRE(alg::vector_2d<float>{ 4.F, -1.F } * alg::square_matrix<float, 3>{ a3 } == alg::vec(4, -1) * a3);
+    REQUIRE(alg::vector_2d<double>{ 4.0, -1.0 } * alg::square_matrix<double, 3>{ a3 } == alg::vec(4, -1) * a3);
+}
+
+TEST_CASE("matrix - lu decomposition", "[matrix]")
+{
+    using Catch::Matchers::WithinAbs;
+
+    const auto m = alg::square_matrix<double, 4>{ 2, 1, 1, 0, 4, 3, 3, 1, 8, 7, 9, 5, 6, 7, 9, 8 };
+
+    const auto factors = alg::lu_decomposition(m);
+    REQUIRE(factors.has_value());
+    REQUIRE_THAT(alg::determinant(*factors), WithinAbs(8.0, 1e-9));
+    REQUIRE_THAT(alg::determinant(m), WithinAbs(8.0, 1e-9));
+    REQUIRE(alg::determinant(alg::square_matrix<int, 4>{ 2, 1, 1, 0, 4, 3, 3, 1, 8, 7, 9, 5, 6, 7, 9, 8 }) == 8);
+
+    const auto x = alg::solve(*factors, alg::vector<double, 4>{ 4, 11, 29, 30 });
+    for (std::size_t d = 0; d < 4; ++d)
+    {
+        REQUIRE_THAT(x[d], WithinAbs(1.0, 1e-9));
+    }
+
+    const auto inverse = alg::invert(m);
+    REQUIRE(inverse.has_value());
+    const auto product = m * *inverse;
+    for (std::size_t r = 0; r < 4; ++r)
+    {
+        for (std::size_t c = 0; c < 4; ++c)
+        {
+            REQUIRE_THAT(product(r, c), WithinAbs(r == c ? 1.0 : 0.0, 1e-9));
+        }
+    }
+
+    const auto singular = alg::square_matrix<double, 4>{ 1, 2, 3, 4, 2, 4, 6, 8, 0, 1, 0, 1, 1, 0, 1, 0 };
+    REQUIRE_FALSE(alg::lu_decomposition(singular).has_value());
+    REQUIRE_FALSE(alg::invert(singular).has_value());
+    REQUIRE_FALSE(alg::solve(singular, alg::vector<double, 4>{ 1, 2, 3, 4 }).has_value());
+    REQUIRE(alg::determinant(singular) == 0.0);
+}
+
+TEST_CASE("matrix - lu decomposition of numerically singular and badly scaled matrices", "[matrix]")
+{
+    using Catch::Matchers::WithinRel;
+
+    // Entries r * 5 + c + 1 give rank 2; elimination leaves pivots of the order of rounding errors, not exact zeros.
+    alg::square_matrix<double, 5> m{};
+    alg::dynamic_matrix<double> dynamic{ 5, 5 };
+    for (std::size_t r = 0; r < 5; ++r)
+    {
+        for (std::size_t c = 0; c < 5; ++c)
+        {
+            m(r, c) = static_cast<double>(r * 5 + c + 1);
+            dynamic(r, c) = m(r, c);
+        }
+    }
+
+    REQUIRE_FALSE(alg::lu_decomposition(m).has_value());
+    REQUIRE_FALSE(alg::invert(m).has_value());
+    REQUIRE(alg::determinant(m) == 0.0);
+    REQUIRE_FALSE(alg::lu_decomposition(dynamic).has_value());
+
+    // The tolerance is relative to the rows: small entries, or entries spanning a wide range, are not singular.
+    const auto small = alg::square_matrix<float, 3>{ 1e-30F, 0, 0, 0, 2e-30F, 0, 1e-30F, 0, 3e-30F };
+    REQUIRE(alg::lu_decomposition(small).has_value());
+
+    const auto diagonal = alg::square_matrix<double, 4>{ 1e6, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1e-10 };
+    REQUIRE_THAT(alg::determinant(diagonal), WithinRel(1e-4, 1e-12));
+    const auto inverse = alg::invert(diagonal);
+    REQUIRE(inverse.has_value());
+    REQUIRE_THAT((*inverse)(0, 0), WithinRel(1e-6, 1e-12));
+    REQUIRE_THAT((*inverse)(3, 3), WithinRel(1e10, 1e-12));
+    const auto x = alg::solve(diagonal, alg::vector<double, 4>{ 1, 2, 3, 4 });
+    REQUIRE(x.has_value());
+    REQUIRE_THAT((*x)[3], WithinRel(4e10, 1e-12));
+
+    alg::dynamic_matrix<double> dynamic_diagonal{ 4, 4 };
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+        dynamic_diagonal(i / 4, i % 4) = diagonal[i];
+    }
+    REQUIRE(alg::lu_decomposition(dynamic_diagonal).has_value());
+
+    const auto affine = alg::scale(1e-4F, 1e-4F, 1e-4F) * alg::translation(1000.F, 1000.F, 1000.F);
+    REQUIRE_THAT(alg::determinant(affine), WithinRel(1e-12F, 1e-5F));
+    REQUIRE(alg::lu_decomposition(affine).has_value());
+}
+
+TEST_CASE("matrix - affine inverse", "[matrix]")
+{
+    using Catch::Matchers::WithinAbs;
+
+    const auto require_identity = [](const auto& m)
+    {
+        for (std::size_t r = 0; r < m.row_count(); ++r)
+        {
+            for (std::size_t c = 0; c < m.col_count(); ++c)
+            {
+                REQUIRE_THAT(m(r, c), WithinAbs(r == c ? 1.0 : 0.0, 1e-5));
+            }
+        }
+    };
+
+    const auto m2 = alg::scale(2.F, 0.5F) * alg::rotation(0.3F) * alg::translation(4.F, -1.F);
+    REQUIRE(alg::is_affine(m2));
+    require_identity(m2 * *alg::invert_affine(m2));
+    require_identity(m2 * *alg::invert(m2));
+
+    const auto rigid = alg::rotation(1.1) * alg::translation(-3.0, 7.0);
+    require_identity(rigid * alg::invert_rigid(rigid));
+
+    const auto m3 = alg::scale(2.0, 3.0, 0.25) * alg::translation(1.0, 2.0, 3.0);
+    REQUIRE(alg::is_affine(m3));
+    require_identity(m3 * *alg::invert_affine(m3));
+    require_identity(m3 * *alg::invert(m3));
+    require_identity(alg::translation(1.0, 2.0, 3.0) * alg::invert_rigid(alg::translation(1.0, 2.0, 3.0)));
+
+    REQUIRE_FALSE(alg::invert_affine(alg::scale(0.F, 1.F)).has_value());
+    REQUIRE_FALSE(alg::is_affine(alg::square_matrix_2d<float>{ 1, 0, 1, 0, 1, 0, 0, 0, 1 }));
+}
+
+TEST_CASE("matrix - lazy expressions", "[matrix]")
+{
+    const auto a = alg::square_matrix<float, 2>{ 1, 2, 3, 4 };
+    const auto b = alg::square_matrix<float, 2>{ 5, 6, 7, 8 };
+    const auto c = alg::square_matrix<float, 2>{ 1, 1, 1, 1 };
+
+    const alg::square_matrix<float, 2> fused = alg::lazy(a) + alg::lazy(b) * 2.F - c;
+    REQUIRE(fused == a + b * 2.F - c);
+
+    const alg::square_matrix<double, 2> converted = -(alg::lazy(a) - b) / 2.F;
+    REQUIRE(converted == alg::square_matrix<double, 2>{ 2, 2, 2, 2 });
+
+    auto accumulated = a;
+    accumulated += alg::lazy(b) * 0.5F;
+    accumulated -= 2.F * alg::lazy(c);
+    REQUIRE(accumulated == alg::square_matrix<float, 2>{ 1.5F, 3.F, 4.5F, 6.F });
+
+    REQUIRE((alg::lazy(a) + b).eval() == a + b);
+}
+
+namespace
+{
+constexpr auto tile_orientations = std::array<alg::square_matrix_2d<int>, 4>{
+    alg::rotation(alg::vec(1, 0)),
+    alg::rotation(alg::vec(0, 1)),
+    alg::rotation(alg::vec(-1, 0)),
+    alg::rotation(alg::vec(0, -1)),
+};
+
+constexpr auto camera = alg::translation(-10.F, -5.F) * alg::scale(2.F, 2.F) * alg::rotation(alg::vec(0.F, 1.F));
+}  // namespace
+
+TEST_CASE("matrix - constant expressions", "[matrix]")
+{
+    static_assert(alg::square_matrix_2d<int>{ alg::identity } == alg::scale(1, 1));
+    static_assert(alg::vec(1, 2) * tile_orientations[1] == alg::vec(-2, 1));
+    static_assert(alg::vec(1, 2) * tile_orientations[2] == alg::vec(-1, -2));
+    static_assert(alg::vec(1, 2) * alg::translation(3, 4) * alg::scale(2, 3) == alg::vec(8, 18));
+    static_assert(alg::vec(10.F, 5.F) * camera == alg::vec(0.F, 0.F));
+    static_assert(alg::transpose(alg::square_matrix<int, 2>{ 1, 2, 3, 4 }) == alg::square_matrix<int, 2>{ 1, 3, 2, 4 });
+    static_assert(alg::determinant(alg::square_matrix<int, 3>{ 2, 0, 0, 0, 3, 0, 0, 0, 4 }) == 24);
+    static_assert(alg::determinant(alg::square_matrix<double, 4>{ 2, 1, 1, 0, 4, 3, 3, 1, 8, 7, 9, 5, 6, 7, 9, 8 }) > 7.99);
+    static_assert(-alg::vec(1, 2) + alg::vec(3, 3) * 2 - alg::vec(1, 1) / 1 != alg::vec(0, 0));
+    static_assert(alg::invert_rigid(alg::translation(1.F, 2.F, 3.F)) == alg::translation(-1.F, -2.F, -3.F));
+    static_assert(alg::scale(2.F, 2.F, 2.F) * alg::scale(0.5F, 0.5F, 0.5F) == alg::scale(1.F, 1.F, 1.F));
+
+    REQUIRE(alg::rotation(0.5F) == alg::rotation(alg::vec(std::cos(0.5F), std::sin(0.5F))));
+}
+
+namespace
+{
+
+template <class T>
+auto make_dynamic(std::size_t rows, std::size_t cols, int seed) -> alg::dynamic_matrix<T>
+{
+    alg::dynamic_matrix<T> result{ rows, cols };
+    for (std::size_t i = 0; i < result.size(); ++i)
+    {
+        result[i] = static_cast<T>(static_cast<int>((i * 7 + seed * 13) % 19) - 9);
+    }
+    return result;
+}
+
+template <class T>
+auto multiply_reference(const alg::dynamic_matrix<T>& lhs, const alg::dynamic_matrix<T>& rhs) -> alg::dynamic_matrix<T>
+{
+    alg::dynamic_matrix<T> result{ lhs.row_count(), rhs.col_count() };
+    for (std::size_t r = 0; r < lhs.row_count(); ++r)
+    {
+        for (std::size_t c = 0; c < rhs.col_count(); ++c)
+        {
+            for (std::size_t i = 0; i < lhs.col_count(); ++i)
+            {
+                result(r, c) += lhs(r, i) * rhs(i, c);
+            }
+        }
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST_CASE("dynamic_matrix - views", "[matrix][dynamic_matrix]")
+{
+    auto m = alg::dynamic_matrix<int>{ 3, 4, { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 } };
+    REQUIRE(m.row_count() == 3);
+    REQUIRE(m.col_count() == 4);
+    REQUIRE(m(1, 2) == 7);
+
+    const auto block = m.block(1, 1, 2, 2);
+    REQUIRE(block.stride() == 4);
+    REQUIRE(block(0, 0) == 6);
+    REQUIRE(block(1, 1) == 11);
+    REQUIRE(block.block(1, 0, 1, 2)(0, 1) == 11);
+    REQUIRE(alg::dynamic_matrix<int>{ block } == alg::dynamic_matrix<int>{ 2, 2, { 6, 7, 10, 11 } });
+
+    block(0, 0) = -1;
+    REQUIRE(m(1, 1) == -1);
+    REQUIRE(m.row(2)[3] == 12);
+    REQUIRE_THROWS_AS(m.block(2, 2, 2, 2), std::runtime_error);
+}
+
+TEST_CASE("dynamic_matrix - interoperability with fixed-size matrices", "[matrix][dynamic_matrix]")
+{
+    const auto fixed = alg::square_matrix<double, 3>{ 2, 0, 1, 1, 3, 0, 0, 1, 4 };
+    const auto m = alg::dynamic_matrix<double>{ fixed };
+
+    REQUIRE(m.to_matrix<3, 3>() == fixed);
+    REQUIRE_THROWS_AS((m.to_matrix<2, 3>()), std::runtime_error);
+    REQUIRE(alg::transpose(m).to_matrix<3, 3>() == alg::transpose(fixed));
+    REQUIRE_THAT(alg::determinant(m), Catch::Matchers::WithinAbs(alg::determinant(fixed), 1e-12));
+
+    const auto inverse = alg::invert(m);
+    REQUIRE(inverse);
+    const auto expected = *alg::invert(fixed);
+    for (std::size_t i = 0; i < 9; ++i)
+    {
+        REQUIRE_THAT((*inverse)[i], Catch::Matchers::WithinAbs(expected[i], 1e-12));
+    }
+
+    REQUIRE_FALSE(alg::invert(alg::dynamic_matrix<double>{ 2, 2, { 1, 2, 2, 4 } }));
+    REQUIRE((m * m).to_matrix<3, 3>() == fixed * fixed);
+}
+
+TEST_CASE("dynamic_matrix - blocked product matches the naive product", "[matrix][dynamic_matrix]")
+{
+    const auto check = [](std::size_t m, std::size_t k, std::size_t n)
+    {
+        const auto lhs = make_dynamic<double>(m, k, 1);
+        const auto rhs = make_dynamic<double>(k, n, 2);
+        REQUIRE(lhs * rhs == multiply_reference(lhs, rhs));
+
+        const auto lhs_f = make_dynamic<float>(m, k, 3);
+        const auto rhs_f = make_dynamic<float>(k, n, 4);
+        REQUIRE(lhs_f * rhs_f == multiply_reference(lhs_f, rhs_f));
+
+        const auto lhs_i = make_dynamic<int>(m, k, 5);
+        const auto rhs_i = make_dynamic<int>(k, n, 6);
+        REQUIRE(lhs_i * rhs_i == multiply_reference(lhs_i, rhs_i));
+    };
+
+    check(1, 1, 1);
+    check(5, 7, 3);
+    check(37, 53, 71);
+    check(70, 300, 90);
+    check(130, 20, 1030);
+}
+
+TEST_CASE("dynamic_matrix - product of views", "[matrix][dynamic_matrix]")
+{
+    const auto a = make_dynamic<double>(40, 50, 1);
+    const auto b = make_dynamic<double>(60, 45, 2);
+    auto out = alg::dynamic_matrix<double>{ 50, 50, -1.0 };
+
+    alg::multiply(a.block(3, 5, 33, 40), b.block(10, 2, 40, 41), out.block(7, 9, 33, 41));
+
+    const auto expected = multiply_reference(
+        alg::dynamic_matrix<double>{ a.block(3, 5, 33, 40) }, alg::dynamic_matrix<double>{ b.block(10, 2, 40, 41) });
+    REQUIRE(alg::dynamic_matrix<double>{ out.block(7, 9, 33, 41) } == expected);
+    REQUIRE(out(6, 9) == -1.0);
+    REQUIRE(out(7, 8) == -1.0);
+    REQUIRE(out(7, 49) == expected(0, 40));
+    REQUIRE_THROWS_AS(alg::multiply(a.view(), a.view(), out.view()), std::runtime_error);
+}
+
+TEST_CASE("dynamic_matrix - inverse of a larger matrix", "[matrix][dynamic_matrix]")
+{
+    auto m = make_dynamic<double>(50, 50, 7);
+    for (std::size_t d = 0; d < 50; ++d)
+    {
+        m(d, d) += 100.0;
+    }
+
+    const auto inverse = alg::invert(m);
+    REQUIRE(inverse);
+
+    const auto product = m * *inverse;
+    for (std::size_t r = 0; r < 50; ++r)
+    {
+        for (std::size_t c = 0; c < 50; ++c)
+        {
+            REQUIRE_THAT(product(r, c), Catch::Matchers::WithinAbs(r == c ? 1.0 : 0.0, 1e-10));
+        }
+    }
+}
+
+TEST_CASE("affine_transform - conversion and composition", "[matrix][affine_transform]")
+{
+    const auto a = alg::scale(2.0, 3.0) * alg::rotation(0.25) * alg::translation(1.0, -2.0);
+    const auto b = alg::rotation(-1.0) * alg::translation(4.0, 0.5);
+
+    const auto ta = alg::affine_transform_2d<double>{ a };
+    const auto tb = alg::affine_transform_2d<double>{ b };
+    REQUIRE(ta.to_matrix() == a);
+    REQUIRE(alg::affine_transform_3d<float>{}.to_matrix() == alg::square_matrix_3d<float>{ alg::identity });
+
+    const auto p = alg::vec(1.5, -0.5);
+    REQUIRE(p * ta == p * a);
+
+    const auto composed = (ta * tb).to_matrix();
+    const auto expected = a * b;
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+        REQUIRE_THAT(composed[i], Catch::Matchers::WithinAbs(expected[i], 1e-12));
+    }
+
+    const auto inverse = alg::invert(ta);
+    REQUIRE(inverse);
+    const auto round_trip = (p * ta) * *inverse;
+    REQUIRE_THAT(round_trip.x(), Catch::Matchers::WithinAbs(p.x(), 1e-12));
+    REQUIRE_THAT(round_trip.y(), Catch::Matchers::WithinAbs(p.y(), 1e-12));
+
+    const double c = std::cos(0.5);
+    const double s = std::sin(0.5);
+    const auto rigid = alg::affine_transform_3d<double>{ { c, s, 0.0, -s, c, 0.0, 0.0, 0.0, 1.0 }, alg::vec(1.0, 2.0, 3.0) };
+    const auto rigid_inverse = alg::invert_rigid(rigid).to_matrix();
+    const auto rigid_expected = *alg::invert_affine(rigid.to_matrix());
+    for (std::size_t i = 0; i < rigid_expected.size(); ++i)
+    {
+        REQUIRE_THAT(rigid_inverse[i], Catch::Matchers::WithinAbs(rigid_expected[i], 1e-12));
+    }
+
+    REQUIRE_FALSE(alg::invert_affine(alg::affine_transform_2d<double>{ alg::scale(0.0, 1.0) }));
+}
+
+TEST_CASE("affine_transform - 3d composition matches the matrix product", "[matrix][affine_transform]")
+{
+    const auto check = [](auto value)
+    {
+        using T = decltype(value);
+        const auto a = alg::affine_transform_3d<T>{ { 1, 2, 3, 4, 5, 6, 7, 8, 10 }, alg::vec(T(1), T(-2), T(3)) };
+        const auto b = alg::affine_transform_3d<T>{ { 2, 0, 1, 1, 3, 0, 0, 1, 4 }, alg::vec(T(5), T(6), T(-7)) };
+        const auto p = alg::vec(T(0.5), T(-1.5), T(2));
+
+        REQUIRE((a * b).to_matrix() == a.to_matrix() * b.to_matrix());
+        REQUIRE(p * a == p * a.to_matrix());
+    };
+
+    check(1.F);
+    check(1.0);
+    check(1);
+}
+
+TEST_CASE("affine_transform - shapes", "[matrix][affine_transform]")
+{
+    const auto t = alg::affine_transform_2d<float>{ alg::scale(2.F, 2.F) * alg::translation(1.F, 1.F) };
+
+    const auto triangle = alg::triangle_2d<float>{ alg::vec(0.F, 0.F), alg::vec(1.F, 0.F), alg::vec(0.F, 1.F) };
+    REQUIRE(triangle * t == triangle * t.to_matrix());
+
+    const auto segment = alg::segment_2d<float>{ alg::vec(0.F, 0.F), alg::vec(1.F, 2.F) };
+    REQUIRE(segment * t == segment * t.to_matrix());
+
+    const auto circle = alg::circle<float>{ alg::vec(1.F, 0.F), 1.5F } * t;
+    REQUIRE(circle.center == alg::vec(3.F, 1.F));
+    REQUIRE(circle.radius == 3.F);
+}
+
+TEST_CASE("affine_transform - circle under a shear is bounded by the image ellipse", "[matrix][affine_transform]")
+{
+    // Rows (1, 0), (1, 1): the largest stretch is the golden ratio, not the largest row norm sqrt(2).
+    const auto shear = alg::affine_transform_2d<double>{ { 1.0, 0.0, 1.0, 1.0 }, alg::vec(2.0, -1.0) };
+    const auto circle = alg::circle<double>{ alg::vec(1.0, 1.0), 2.0 } * shear;
+    REQUIRE(circle.center == alg::vec(1.0, 1.0) * shear);
+    REQUIRE_THAT(circle.radius, Catch::Matchers::WithinAbs(2.0 * (1.0 + std::sqrt(5.0)) / 2.0, 1e-12));
+
+    double farthest = 0.0;
+    for (std::size_t i = 0; i < 3600; ++i)
+    {
+        const double a = 2.0 * 3.14159265358979323846 * static_cast<double>(i) / 3600.0;
+        const auto point = (alg::vec(1.0, 1.0) + 2.0 * alg::vec(std::cos(a), std::sin(a))) * shear;
+        farthest = std::max(farthest, std::hypot(point.x() - circle.center.x(), point.y() - circle.center.y()));
+    }
+    REQUIRE(farthest <= circle.radius + 1e-12);
+    REQUIRE(farthest >= circle.radius - 1e-5);
+
+    // In 3d the same shear in the xy plane with a scale of 0.5 along z.
+    const auto shear_3d = alg::affine_transform_3d<float>{ { 1, 0, 0, 1, 1, 0, 0, 0, 0.5F }, alg::vec(0.F, 0.F, 1.F) };
+    const auto sphere = alg::sphere<float>{ alg::vec(0.F, 0.F, 0.F), 1.F } * shear_3d;
+    REQUIRE_THAT(sphere.radius, Catch::Matchers::WithinAbs((1.0 + std::sqrt(5.0)) / 2.0, 1e-6));
+
+    // Rotations with a uniform scale stay exact up to rounding.
+    const double c = 3.0 * std::cos(0.3);
+    const double s = 3.0 * std::sin(0.3);
+    const auto similarity
+        = alg::affine_transform_3d<double>{ { c, s, 0.0, -s, c, 0.0, 0.0, 0.0, 3.0 }, alg::vec(1.0, 2.0, 3.0) };
+    const auto scaled = alg::sphere<double>{ alg::vec(0.0, 0.0, 0.0), 2.0 } * similarity;
+    REQUIRE_THAT(scaled.radius, Catch::Matchers::WithinAbs(6.0, 1e-12));
+}
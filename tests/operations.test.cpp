@@ -41,4 +41,213 @@ TEST_CASE("circle operations", "[operators]")
     const auto shape = alg::circle_2d<float>{ alg::vec(0.F, 5.F), 10.F };
     std::cout << (shape + alg::vec(10, 10)) << std::endl;
     std::cout << (shape - alg::vec(10, 10)) << std::endl;
-}
\ No newline at end of file
+}
+
+TEST_CASE("contains - batched triangle", "[operations]")
+{
+    const auto triangle = alg::triangle_2d<float>{ alg::vec(-3.F, -2.F), alg::vec(4.F, -1.F), alg::vec(0.F, 5.F) };
+
+    std::vector<alg::vector_2d<float>> points;
+    for (int y = -6; y <= 6; ++y)
+    {
+        for (int x = -6; x <= 6; ++x)
+        {
+            points.push_back(alg::vec(x * 0.75F, y * 1.F));
+        }
+    }
+    points.push_back(triangle[0]);
+    points.push_back((triangle[0] + triangle[1]) * 0.5F);
+
+    std::vector<std::uint64_t> mask(alg::bitmask_words(points.size()));
+    const auto count = alg::contains(triangle, points, mask);
+
+    std::vector<std::size_t> indices;
+    REQUIRE(alg::contained_indices(triangle, points, indices) == count);
+    REQUIRE(indices.size() == count);
+
+    std::size_t expected_count = 0;
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        const bool expected = alg::contains(triangle, points[i]);
+        expected_count += expected;
+        REQUIRE(((mask[i / 64] >> (i % 64)) & 1) == expected);
+        REQUIRE(std::binary_search(indices.begin(), indices.end(), i) == expected);
+    }
+    REQUIRE(count == expected_count);
+    REQUIRE(count > 0);
+    REQUIRE(alg::contains(triangle, alg::span{ points }.subspan(points.size() - 2, 2), mask) == 2);
+}
+
+TEST_CASE("contains - batched triangles against points", "[operations]")
+{
+    const std::vector<alg::triangle_2d<double>> triangles{
+        alg::triangle_2d<double>{ alg::vec(0.0, 0.0), alg::vec(10.0, 0.0), alg::vec(0.0, 10.0) },
+        alg::triangle_2d<double>{ alg::vec(5.0, 5.0), alg::vec(-5.0, 5.0), alg::vec(0.0, -5.0) },
+        alg::triangle_2d<double>{ alg::vec(1.0, 1.0), alg::vec(2.0, 2.0), alg::vec(3.0, 3.0) },
+    };
+
+    std::vector<alg::vector_2d<double>> points;
+    for (int i = 0; i < 1500; ++i)
+    {
+        points.push_back(alg::vec((i % 37) * 0.5 - 6.0, (i / 37) * 0.4 - 6.0));
+    }
+
+    const std::size_t words = alg::bitmask_words(points.size());
+    std::vector<std::uint64_t> mask(words * triangles.size());
+    const auto count = alg::contains(alg::span{ triangles }, points, mask);
+
+    std::size_t expected_count = 0;
+    for (std::size_t t = 0; t < triangles.size(); ++t)
+    {
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            const bool expected = alg::contains(triangles[t], points[i]);
+            expected_count += expected;
+            REQUIRE(((mask[t * words + i / 64] >> (i % 64)) & 1) == expected);
+        }
+    }
+    REQUIRE(count == expected_count);
+
+    std::vector<std::uint64_t> small(words);
+    REQUIRE_THROWS_AS(alg::contains(alg::span{ triangles }, points, small), std::runtime_error);
+}
+
+TEST_CASE("intersection - point lies on both shapes", "[operations]")
+{
+    const auto a = alg::segment_2d<double>{ alg::vec(0.0, 0.0), alg::vec(4.0, 0.0) };
+    const auto b = alg::segment_2d<double>{ alg::vec(1.0, -1.0), alg::vec(1.0, 3.0) };
+    REQUIRE(alg::intersection(a, b) == alg::vec(1.0, 0.0));
+    REQUIRE(alg::intersection(b, a) == alg::vec(1.0, 0.0));
+    REQUIRE(!alg::intersection(a, b + alg::vec(5.0, 0.0)));
+    REQUIRE(alg::intersection(alg::ray_2d<double>{ a[0], a[1] }, b + alg::vec(5.0, 0.0)) == alg::vec(6.0, 0.0));
+}
+
+template <class Tag, class T>
+void check_intersect_all(const alg::detail::linear_shape<Tag, T, 2>& query, const std::vector<alg::segment_2d<T>>& segments)
+{
+    const auto hits = alg::intersect_all(query, segments);
+    REQUIRE(hits.indices.size() == hits.points.size());
+
+    std::size_t expected_count = 0;
+    for (std::size_t i = 0; i < segments.size(); ++i)
+    {
+        const auto expected = alg::intersection(query, segments[i]);
+        const auto it = std::lower_bound(hits.indices.begin(), hits.indices.end(), i);
+        const bool found = it != hits.indices.end() && *it == i;
+        REQUIRE(found == expected.has_value());
+        if (expected)
+        {
+            ++expected_count;
+            REQUIRE(hits.points[static_cast<std::size_t>(it - hits.indices.begin())] == *expected);
+        }
+    }
+    REQUIRE(hits.indices.size() == expected_count);
+    REQUIRE(std::is_sorted(hits.indices.begin(), hits.indices.end()));
+}
+
+template <class T>
+void check_intersect_all()
+{
+    std::vector<alg::segment_2d<T>> segments;
+    for (int i = 0; i < 403; ++i)
+    {
+        const T x = T((i * 37) % 101) * T(0.2) - T(10);
+        const T y = T((i * 53) % 89) * T(0.25) - T(11);
+        const T dx = T((i * 17) % 23) * T(0.3) - T(3.3);
+        const T dy = T((i * 29) % 19) * T(0.35) - T(3.1);
+        segments.push_back(alg::segment_2d<T>{ alg::vec(x, y), alg::vec(x + dx, y + dy) });
+    }
+    segments.push_back(alg::segment_2d<T>{ alg::vec(T(0), T(0)), alg::vec(T(1), T(1)) });
+
+    const auto p0 = alg::vec(T(-4.1), T(-2.3));
+    const auto p1 = alg::vec(T(3.7), T(1.9));
+
+    check_intersect_all(alg::segment_2d<T>{ p0, p1 }, segments);
+    check_intersect_all(alg::segment_2d<T>{ p1, p0 }, segments);
+    check_intersect_all(alg::ray_2d<T>{ p0, p1 }, segments);
+    check_intersect_all(alg::ray_2d<T>{ p1, p0 }, segments);
+    check_intersect_all(alg::line_2d<T>{ p0, p1 }, segments);
+    check_intersect_all(alg::segment_2d<T>{ p0, alg::vec(p0[0], T(5)) }, segments);
+
+    alg::intersection_hits<T> hits;
+    const auto count = alg::intersect_all(alg::line_2d<T>{ p0, p1 }, segments, hits);
+    REQUIRE(count > 0);
+    REQUIRE(alg::intersect_all(alg::line_2d<T>{ p0, p1 }, segments, hits) == count);
+    REQUIRE(hits.indices.size() == 2 * count);
+}
+
+TEST_CASE("intersect_all - matches per-segment intersection", "[operations]")
+{
+    check_intersect_all<float>();
+    check_intersect_all<double>();
+}
+
+TEST_CASE("polygon - area, perimeter and bounds", "[operations][polygon]")
+{
+    auto square = alg::polygon<double>{ alg::vec(0.0, 0.0), alg::vec(4.0, 0.0), alg::vec(4.0, 3.0), alg::vec(0.0, 3.0) };
+    REQUIRE(alg::signed_area(square) == 12.0);
+    REQUIRE(alg::perimeter(square) == 14.0);
+    REQUIRE(alg::bounds(square) == alg::region_2d<double>{ alg::interval<double>{ 0, 4 }, alg::interval<double>{ 0, 3 } });
+
+    const auto reversed = alg::polygon<double>(square.rbegin(), square.rend());
+    REQUIRE(alg::signed_area(reversed) == -12.0);
+
+    const auto triangle = alg::triangle_2d<int>{ alg::vec(0, 0), alg::vec(3, 0), alg::vec(0, 3) };
+    REQUIRE(alg::signed_area(triangle) == 4.5);
+    REQUIRE(alg::bounds(triangle) == alg::region_2d<int>{ alg::interval<int>{ 0, 3 }, alg::interval<int>{ 0, 3 } });
+
+    square += alg::vec(1.0, 1.0);
+    REQUIRE(square[0] == alg::vec(1.0, 1.0));
+    REQUIRE(alg::signed_area(square * alg::scale(alg::vec(2.0, 2.0))) == 48.0);
+    REQUIRE((square - alg::vec(1.0, 1.0))[2] == alg::vec(4.0, 3.0));
+    REQUIRE(alg::polygon<double>{}.empty());
+    REQUIRE_THROWS_AS(alg::bounds(alg::polygon<double>{}), std::runtime_error);
+}
+
+TEST_CASE("polygon - winding number containment", "[operations][polygon]")
+{
+    const auto outer
+        = alg::polygon<float>{ alg::vec(0.F, 0.F), alg::vec(10.F, 0.F), alg::vec(10.F, 10.F), alg::vec(0.F, 10.F) };
+    REQUIRE(alg::contains(outer, alg::vec(5.F, 5.F)));
+    REQUIRE(!alg::contains(outer, alg::vec(15.F, 5.F)));
+    REQUIRE(alg::winding_number(outer, alg::vec(5.F, 5.F)) == 1);
+
+    // The same square traversed twice.
+    const auto twice = alg::polygon<float>{ alg::vec(0.F, 0.F), alg::vec(4.F, 0.F), alg::vec(4.F, 4.F), alg::vec(0.F, 4.F),
+                                            alg::vec(0.F, 0.F), alg::vec(4.F, 0.F), alg::vec(4.F, 4.F), alg::vec(0.F, 4.F) };
+    REQUIRE(alg::winding_number(twice, alg::vec(1.F, 1.F)) == 2);
+
+    // Star-shaped polygon with many vertices.
+    alg::polygon<float> star;
+    for (int i = 0; i < 200; ++i)
+    {
+        const float angle = static_cast<float>(i) * 0.0314159265F;
+        const float radius = (i % 2 == 0) ? 10.F : 4.F + static_cast<float>(i % 7);
+        star.push_back(alg::vec(radius * std::cos(angle), radius * std::sin(angle)));
+    }
+
+    const auto prepared = alg::prepared_polygon<float>{ star };
+    REQUIRE(prepared.size() == star.size());
+    REQUIRE(prepared.bounds() == alg::bounds(star));
+
+    std::size_t inside = 0;
+    for (int y = -60; y <= 60; ++y)
+    {
+        for (int x = -60; x <= 60; ++x)
+        {
+            const auto point = alg::vec(static_cast<float>(x) * 0.19F, static_cast<float>(y) * 0.21F);
+            const int expected = alg::winding_number(star, point);
+            REQUIRE(alg::winding_number(prepared, point) == expected);
+            REQUIRE(alg::contains(prepared, point) == (expected != 0));
+            inside += expected != 0;
+        }
+    }
+    REQUIRE(inside > 0);
+
+    for (const auto& vertex : star)
+    {
+        REQUIRE(alg::winding_number(prepared, vertex) == alg::winding_number(star, vertex));
+    }
+
+    REQUIRE(!alg::contains(alg::prepared_polygon<float>{ alg::polygon<float>{} }, alg::vec(0.F, 0.F)));
+}
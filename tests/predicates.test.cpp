@@ -0,0 +1,211 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+#include <ferrugo/alg/operations.hpp>
+#include <ferrugo/alg/predicates.hpp>
+#include <random>
+
+using namespace ferrugo;
+
+namespace
+{
+
+template <class T>
+auto sign(T value) -> int
+{
+    return (value > T(0)) - (value < T(0));
+}
+
+#if defined(__SIZEOF_INT128__)
+
+using wide = __int128;
+
+// The coordinates of the tests are multiples of 2^-shift, so scaled by 2^shift they are exact integers.
+template <class T>
+auto to_wide(T value, int shift) -> wide
+{
+    return static_cast<wide>(std::ldexp(value, shift));
+}
+
+template <class T>
+auto exact_orient2d(const alg::vector_2d<T>& a, const alg::vector_2d<T>& b, const alg::vector_2d<T>& c, int shift)
+    -> int
+{
+    const wide acx = to_wide(a[0], shift) - to_wide(c[0], shift);
+    const wide acy = to_wide(a[1], shift) - to_wide(c[1], shift);
+    const wide bcx = to_wide(b[0], shift) - to_wide(c[0], shift);
+    const wide bcy = to_wide(b[1], shift) - to_wide(c[1], shift);
+    return sign(acx * bcy - acy * bcx);
+}
+
+template <class T>
+void check_orient2d_grid(int shift)
+{
+    // Points near the line y = x, one unit in the last place apart, as in Shewchuk's paper.
+    const T unit = std::ldexp(T(1), -shift);
+    const auto b = alg::vec(T(12), T(12));
+    const auto c = alg::vec(T(24), T(24));
+
+    std::size_t naive_errors = 0;
+    for (int i = 0; i < 64; ++i)
+    {
+        for (int j = 0; j < 64; ++j)
+        {
+            const auto a = alg::vec(T(0.5) + T(i) * unit, T(0.5) + T(j) * unit);
+            const int expected = exact_orient2d(a, b, c, shift);
+
+            REQUIRE(sign(alg::predicates::orient2d(a, b, c)) == expected);
+            REQUIRE(sign(alg::predicates::orient2d(b, c, a)) == expected);
+            REQUIRE(sign(alg::predicates::orient2d(b, a, c)) == -expected);
+            REQUIRE(sign(alg::predicates::orient2d(alg::segment_2d<T>{ b, c }, a)) == expected);
+
+            naive_errors += sign(alg::cross(a - c, b - c)) != expected;
+        }
+    }
+
+    // The grid is hard enough for the plain cross product to get some signs wrong.
+    REQUIRE(naive_errors > 0);
+}
+
+#endif
+
+}  // namespace
+
+#if defined(__SIZEOF_INT128__)
+
+TEST_CASE("predicates - orient2d near collinear points", "[predicates]")
+{
+    check_orient2d_grid<double>(53);
+    check_orient2d_grid<float>(24);
+}
+
+TEST_CASE("predicates - orient3d near coplanar points", "[predicates]")
+{
+    std::mt19937_64 generator{ 17 };
+    std::uniform_int_distribution<std::int64_t> coordinate{ 0, (std::int64_t(1) << 38) - 1 };
+    std::uniform_int_distribution<std::int64_t> perturbation{ -1, 1 };
+
+    const int shift = 20;
+    const auto make = [&](std::int64_t x, std::int64_t y, std::int64_t z)
+    {
+        return alg::vector_3d<double>{
+            std::ldexp(double(x), -shift),
+            std::ldexp(double(y), -shift),
+            std::ldexp(double(z), -shift),
+        };
+    };
+
+    for (std::size_t n = 0; n < 2000; ++n)
+    {
+        std::int64_t p[3][3];
+        for (auto& point : p)
+        {
+            for (auto& value : point)
+            {
+                value = coordinate(generator);
+            }
+        }
+
+        // d = b + c - a lies in the plane of a, b, c, up to the perturbation.
+        std::int64_t q[3];
+        for (std::size_t k = 0; k < 3; ++k)
+        {
+            q[k] = p[1][k] + p[2][k] - p[0][k] + (k == 2 ? perturbation(generator) : 0);
+        }
+
+        const auto a = make(p[0][0], p[0][1], p[0][2]);
+        const auto b = make(p[1][0], p[1][1], p[1][2]);
+        const auto c = make(p[2][0], p[2][1], p[2][2]);
+        const auto d = make(q[0], q[1], q[2]);
+
+        wide m[3][3];
+        for (std::size_t r = 0; r < 3; ++r)
+        {
+            for (std::size_t k = 0; k < 3; ++k)
+            {
+                m[r][k] = wide(p[r][k]) - wide(q[k]);
+            }
+        }
+        const wide det = m[0][2] * (m[1][0] * m[2][1] - m[2][0] * m[1][1])
+                         + m[1][2] * (m[2][0] * m[0][1] - m[0][0] * m[2][1])
+                         + m[2][2] * (m[0][0] * m[1][1] - m[1][0] * m[0][1]);
+
+        REQUIRE(sign(alg::predicates::orient3d(a, b, c, d)) == sign(det));
+        REQUIRE(sign(alg::predicates::orient3d(b, c, a, d)) == sign(det));
+        REQUIRE(sign(alg::predicates::orient3d(b, a, c, d)) == -sign(det));
+    }
+}
+
+TEST_CASE("predicates - incircle near cocircular points", "[predicates]")
+{
+    std::mt19937_64 generator{ 19 };
+    std::uniform_int_distribution<std::int64_t> center{ -(std::int64_t(1) << 25), std::int64_t(1) << 25 };
+    std::uniform_int_distribution<std::int64_t> scale{ 1, std::int64_t(1) << 20 };
+    std::uniform_int_distribution<std::int64_t> perturbation{ -1, 1 };
+
+    const int shift = 30;
+    const auto make = [&](std::int64_t x, std::int64_t y)
+    { return alg::vec(std::ldexp(double(x), -shift), std::ldexp(double(y), -shift)); };
+
+    for (std::size_t n = 0; n < 2000; ++n)
+    {
+        // Points of the circle of radius 5k around (x, y), counterclockwise, and a fourth one close to it.
+        const std::int64_t x = center(generator);
+        const std::int64_t y = center(generator);
+        const std::int64_t k = scale(generator);
+
+        const std::int64_t p[4][2] = {
+            { x + 5 * k, y },
+            { x + 3 * k, y + 4 * k },
+            { x - 4 * k, y - 3 * k },
+            { x + perturbation(generator), y - 5 * k + perturbation(generator) },
+        };
+
+        wide m[3][3];
+        for (std::size_t r = 0; r < 3; ++r)
+        {
+            const wide dx = wide(p[r][0]) - wide(p[3][0]);
+            const wide dy = wide(p[r][1]) - wide(p[3][1]);
+            m[r][0] = dx;
+            m[r][1] = dy;
+            m[r][2] = dx * dx + dy * dy;
+        }
+        const wide det = m[0][2] * (m[1][0] * m[2][1] - m[2][0] * m[1][1])
+                         + m[1][2] * (m[2][0] * m[0][1] - m[0][0] * m[2][1])
+                         + m[2][2] * (m[0][0] * m[1][1] - m[1][0] * m[0][1]);
+
+        const auto a = make(p[0][0], p[0][1]);
+        const auto b = make(p[1][0], p[1][1]);
+        const auto c = make(p[2][0], p[2][1]);
+        const auto d = make(p[3][0], p[3][1]);
+
+        REQUIRE(sign(alg::predicates::incircle(a, b, c, d)) == sign(det));
+        REQUIRE(sign(alg::predicates::incircle(c, a, b, d)) == sign(det));
+        REQUIRE(sign(alg::predicates::incircle(b, a, c, d)) == -sign(det));
+        REQUIRE(sign(alg::predicates::incircle(alg::triangle_2d<double>{ a, b, c }, d)) == sign(det));
+    }
+}
+
+#endif
+
+TEST_CASE("predicates - easy cases", "[predicates]")
+{
+    const auto a = alg::vec(0.0, 0.0);
+    const auto b = alg::vec(4.0, 0.0);
+    const auto c = alg::vec(0.0, 4.0);
+
+    REQUIRE(alg::predicates::orient2d(a, b, c) == 16.0);
+    REQUIRE(alg::predicates::orient2d(a, c, b) == -16.0);
+    REQUIRE(alg::predicates::orient2d(a, b, alg::vec(8.0, 0.0)) == 0.0);
+    REQUIRE(sign(alg::predicates::orient2d(alg::vec(0.F, 0.F), alg::vec(1.F, 0.F), alg::vec(0.F, 1.F))) == 1);
+
+    REQUIRE(alg::predicates::incircle(a, b, c, alg::vec(1.0, 1.0)) > 0.0);
+    REQUIRE(alg::predicates::incircle(a, b, c, alg::vec(4.0, 4.0)) == 0.0);
+    REQUIRE(alg::predicates::incircle(a, b, c, alg::vec(5.0, 5.0)) < 0.0);
+
+    const auto x = alg::vector_3d<double>{ 1.0, 0.0, 0.0 };
+    const auto y = alg::vector_3d<double>{ 0.0, 1.0, 0.0 };
+    const auto o = alg::vector_3d<double>{ 0.0, 0.0, 0.0 };
+    REQUIRE(alg::predicates::orient3d(o, x, y, alg::vector_3d<double>{ 0.0, 0.0, -1.0 }) > 0.0);
+    REQUIRE(alg::predicates::orient3d(o, x, y, alg::vector_3d<double>{ 0.0, 0.0, 1.0 }) < 0.0);
+    REQUIRE(alg::predicates::orient3d(o, x, y, alg::vector_3d<double>{ 3.0, 5.0, 0.0 }) == 0.0);
+}
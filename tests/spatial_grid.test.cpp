@@ -0,0 +1,160 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+#include <ferrugo/alg/spatial_grid.hpp>
+#include <algorithm>
+#include <random>
+
+using namespace ferrugo;
+
+namespace
+{
+
+template <class T, std::size_t D>
+auto random_circles(std::size_t count, T extent, T max_radius, std::uint32_t seed) -> std::vector<alg::circular_shape<T, D>>
+{
+    std::mt19937 generator{ seed };
+    std::uniform_real_distribution<T> position{ T(0), extent };
+    std::uniform_real_distribution<T> radius{ T(0), max_radius };
+
+    std::vector<alg::circular_shape<T, D>> result(count);
+    for (auto& item : result)
+    {
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            item.center[d] = position(generator);
+        }
+        item.radius = radius(generator);
+    }
+    return result;
+}
+
+template <class T, std::size_t D>
+auto centers(const std::vector<alg::circular_shape<T, D>>& circles) -> std::vector<alg::vector<T, D>>
+{
+    std::vector<alg::vector<T, D>> result;
+    for (const auto& item : circles)
+    {
+        result.push_back(item.center);
+    }
+    return result;
+}
+
+// Compares the grid against a linear scan; radii are 0 when the grid was built from the centers only.
+template <class T, std::size_t D>
+void check_grid(
+    const alg::spatial_grid<T, D>& grid, const std::vector<alg::circular_shape<T, D>>& items, bool points, T distance)
+{
+    REQUIRE(grid.size() == items.size());
+
+    const auto radius = [&](std::size_t i) { return points ? T(0) : items[i].radius; };
+
+    std::vector<std::pair<std::size_t, std::size_t>> expected_pairs;
+    for (std::size_t a = 0; a < items.size(); ++a)
+    {
+        for (std::size_t b = a + 1; b < items.size(); ++b)
+        {
+            if (alg::norm(items[a].center - items[b].center) <= alg::sqr(radius(a) + radius(b) + distance))
+            {
+                expected_pairs.emplace_back(a, b);
+            }
+        }
+    }
+
+    auto pairs = grid.query_pairs(distance);
+    std::sort(pairs.begin(), pairs.end());
+    REQUIRE(pairs == expected_pairs);
+
+    for (std::size_t q = 0; q < items.size(); q += 7)
+    {
+        auto center = items[q].center;
+        center[0] += T(0.5);
+        std::vector<std::size_t> expected;
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            if (alg::norm(items[i].center - center) <= alg::sqr(radius(i) + distance))
+            {
+                expected.push_back(i);
+            }
+        }
+
+        auto actual = grid.query(center, distance);
+        std::sort(actual.begin(), actual.end());
+        REQUIRE(actual == expected);
+    }
+}
+
+template <class T, std::size_t D>
+void check_spatial_grid()
+{
+    alg::spatial_grid<T, D> grid{ T(2) };
+    REQUIRE(grid.empty());
+    REQUIRE(grid.query(alg::vector<T, D>{}, T(1)).empty());
+    REQUIRE(grid.query_pairs(T(1)).empty());
+
+    auto items = random_circles<T, D>(600, T(40), T(1), 7);
+
+    auto points = centers(items);
+    grid.build(points);
+    check_grid(grid, items, true, T(1.5));
+    check_grid(grid, items, true, T(5));
+
+    grid.build(items);
+    check_grid(grid, items, false, T(0));
+    check_grid(grid, items, false, T(3));
+
+    // Far outliers stretch the bounds, so the cell indices wrap around.
+    items[0].center[0] = T(-10000);
+    items[1].center[D - 1] = T(25000);
+    grid.build(items);
+    check_grid(grid, items, false, T(0.5));
+
+    // Queries larger than the grid visit every cell once.
+    points = centers(items);
+    grid.build(points);
+    check_grid(grid, items, true, T(30000));
+
+    items.resize(3);
+    grid.build(items);
+    check_grid(grid, items, false, T(1));
+}
+
+}  // namespace
+
+TEST_CASE("spatial_grid", "[spatial_grid]")
+{
+    check_spatial_grid<float, 2>();
+    check_spatial_grid<double, 2>();
+    check_spatial_grid<double, 3>();
+
+    REQUIRE_THROWS_AS(alg::spatial_grid_2d<float>{ 0.F }, std::runtime_error);
+}
+
+TEST_CASE("spatial_grid - many 3d points with far outliers", "[spatial_grid]")
+{
+    // Enough points that the cells covering the bounds along all three axes, each capped at the budget of cells, would
+    // overflow size_t when multiplied.
+    auto points = centers(random_circles<double, 3>(1500000, 115.0, 0.0, 11));
+    points[0] = alg::vec(-1e7, 0.0, 0.0);
+    points[1] = alg::vec(0.0, 1e7, 0.0);
+    points[2] = alg::vec(0.0, 0.0, -1e7);
+
+    alg::spatial_grid_3d<double> grid{ 1.0 };
+    grid.build(points);
+    REQUIRE(grid.size() == points.size());
+
+    for (std::size_t q = 0; q < points.size(); q += 100003)
+    {
+        std::vector<std::size_t> expected;
+        for (std::size_t i = 0; i < points.size(); ++i)
+        {
+            if (alg::norm(points[i] - points[q]) <= alg::sqr(1.5))
+            {
+                expected.push_back(i);
+            }
+        }
+
+        auto actual = grid.query(points[q], 1.5);
+        std::sort(actual.begin(), actual.end());
+        REQUIRE(actual == expected);
+    }
+}
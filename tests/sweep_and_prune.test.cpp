@@ -0,0 +1,103 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_all.hpp>
+#include <ferrugo/alg/sweep_and_prune.hpp>
+#include <random>
+
+using namespace ferrugo;
+
+namespace
+{
+
+template <class T, std::size_t D>
+auto brute_force_pairs(const std::vector<alg::region<T, D>>& items) -> std::vector<std::pair<std::size_t, std::size_t>>
+{
+    std::vector<std::pair<std::size_t, std::size_t>> result;
+    for (std::size_t a = 0; a < items.size(); ++a)
+    {
+        for (std::size_t b = a + 1; b < items.size(); ++b)
+        {
+            if (alg::intersects(items[a], items[b]))
+            {
+                result.emplace_back(a, b);
+            }
+        }
+    }
+    return result;
+}
+
+template <class T, std::size_t D>
+auto sorted_pairs(alg::sweep_and_prune<T, D>& engine, const std::vector<alg::region<T, D>>& items)
+    -> std::vector<std::pair<std::size_t, std::size_t>>
+{
+    auto result = engine.update(items);
+    REQUIRE(engine.stats().pairs == result.size());
+    REQUIRE(engine.stats().tests >= result.size());
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+// Boxes of size 1 to 3, spread over [0, extent) along every axis.
+template <class T, std::size_t D>
+void check_sweep_and_prune(const alg::vector<T, D>& extent, std::size_t expected_axis)
+{
+    std::mt19937 generator{ 11 };
+    std::uniform_real_distribution<double> unit{ 0.0, 1.0 };
+
+    std::vector<alg::region<T, D>> items(400);
+    for (auto& item : items)
+    {
+        for (std::size_t d = 0; d < D; ++d)
+        {
+            const auto lo = static_cast<T>(unit(generator) * double(extent[d]));
+            item[d] = alg::interval<T>{ lo, static_cast<T>(lo + 1 + unit(generator) * 2) };
+        }
+    }
+
+    alg::sweep_and_prune<T, D> engine{};
+    REQUIRE(sorted_pairs(engine, items) == brute_force_pairs(items));
+    REQUIRE(engine.stats().sorted);
+    REQUIRE(engine.stats().axis == expected_axis);
+
+    std::size_t swaps = 0;
+    for (std::size_t frame = 0; frame < 20; ++frame)
+    {
+        for (auto& item : items)
+        {
+            for (std::size_t d = 0; d < D; ++d)
+            {
+                const auto step = static_cast<T>(std::round(unit(generator) * 2 - 1));
+                item[d] = alg::interval<T>{ alg::lower(item[d]) + step, alg::upper(item[d]) + step };
+            }
+        }
+
+        REQUIRE(sorted_pairs(engine, items) == brute_force_pairs(items));
+        REQUIRE_FALSE(engine.stats().sorted);
+        REQUIRE(engine.stats().axis == expected_axis);
+        swaps += engine.stats().swaps;
+    }
+    REQUIRE(swaps > 0);
+
+    // A different number of items rebuilds the order.
+    items.resize(250);
+    REQUIRE(sorted_pairs(engine, items) == brute_force_pairs(items));
+    REQUIRE(engine.stats().sorted);
+
+    // So do large moves.
+    std::reverse(items.begin(), items.end());
+    REQUIRE(sorted_pairs(engine, items) == brute_force_pairs(items));
+    REQUIRE(engine.stats().sorted);
+}
+
+}  // namespace
+
+TEST_CASE("sweep_and_prune", "[sweep_and_prune]")
+{
+    check_sweep_and_prune<float, 2>(alg::vec(100.F, 20.F), 0);
+    check_sweep_and_prune<int, 2>(alg::vec(20, 100), 1);
+    check_sweep_and_prune<double, 3>(alg::vec(30.0, 30.0, 200.0), 2);
+
+    const std::vector<alg::region_2d<float>> empty{};
+    alg::sweep_and_prune_2d<float> engine{};
+    REQUIRE(engine.update(empty).empty());
+    REQUIRE(engine.stats().pairs == 0);
+}